@@ -108,7 +108,6 @@ SOURCES += main.cpp\
     data/StreamDetails.cpp \
     smallWidgets/MediaFlags.cpp \
     data/Database.cpp \
-    smallWidgets/LoadingStreamDetails.cpp \
     trailerProviders/MovieMaze.cpp \
     globals/TrailerDialog.cpp \
     smallWidgets/SlidingStackedWidget.cpp \
@@ -200,7 +199,21 @@ SOURCES += main.cpp\
     smallWidgets/TvShowTreeView.cpp \
     tvShows/TvShowMultiScrapeDialog.cpp \
     data/Subtitle.cpp \
-    image/ImageCapture.cpp
+    image/ImageCapture.cpp \
+    data/DirectoryWalker.cpp \
+    data/DatabaseRow.cpp \
+    data/StreamDetailsLoader.cpp \
+    data/DiscStructure.cpp \
+    globals/NetworkCache.cpp \
+    movies/MovieMultiScraper.cpp \
+    globals/RateLimiter.cpp \
+    globals/MultiScrapeRunner.cpp \
+    data/MovieFilterIndex.cpp \
+    globals/SortKeyCache.cpp \
+    globals/FacetCounts.cpp \
+    renamer/RenameJournal.cpp \
+    data/MountJobQueue.cpp \
+    renamer/RenamePlanner.cpp
 
 macx {
     OBJECTIVE_SOURCES += notifications/MacNotificationHandler.mm
@@ -279,7 +292,6 @@ HEADERS  += main/MainWindow.h \
     data/StreamDetails.h \
     smallWidgets/MediaFlags.h \
     data/Database.h \
-    smallWidgets/LoadingStreamDetails.h \
     trailerProviders/TrailerProvider.h \
     trailerProviders/MovieMaze.h \
     globals/TrailerDialog.h \
@@ -375,7 +387,21 @@ HEADERS  += main/MainWindow.h \
     smallWidgets/TvShowTreeView.h \
     tvShows/TvShowMultiScrapeDialog.h \
     data/Subtitle.h \
-    image/ImageCapture.h
+    image/ImageCapture.h \
+    data/DirectoryWalker.h \
+    data/DatabaseRow.h \
+    data/StreamDetailsLoader.h \
+    data/DiscStructure.h \
+    globals/NetworkCache.h \
+    movies/MovieMultiScraper.h \
+    globals/RateLimiter.h \
+    globals/MultiScrapeRunner.h \
+    data/MovieFilterIndex.h \
+    globals/SortKeyCache.h \
+    globals/FacetCounts.h \
+    renamer/RenameJournal.h \
+    data/MountJobQueue.h \
+    renamer/RenamePlanner.h
 
 FORMS    += main/MainWindow.ui \
     movies/MovieSearch.ui \
@@ -403,7 +429,6 @@ FORMS    += main/MainWindow.ui \
     support/SupportDialog.ui \
     main/FileScannerDialog.ui \
     smallWidgets/MediaFlags.ui \
-    smallWidgets/LoadingStreamDetails.ui \
     globals/TrailerDialog.ui \
     xbmc/XbmcSync.ui \
     movies/MovieMultiScrapeDialog.ui \
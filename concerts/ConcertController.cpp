@@ -90,8 +90,8 @@ bool ConcertController::loadData(MediaCenterInterface *mediaCenterInterface, boo
 
     m_infoLoaded = infoLoaded;
     m_infoFromNfoLoaded = infoLoaded && reloadFromNfo;
-    m_concert->setChanged(false);
     m_concert->blockSignals(false);
+    m_concert->setChanged(false);
     return infoLoaded;
 }
 
@@ -158,6 +158,7 @@ void ConcertController::onFanartLoadDone(Concert *concert, QMap<int, QList<Poste
         d.imageType = it.key();
         d.url = it.value().at(0).originalUrl;
         d.concert = m_concert;
+        d.priority = true;
         downloads.append(d);
         if (!imageTypes.contains(it.key()))
             imageTypes.append(it.key());
@@ -205,6 +206,7 @@ void ConcertController::loadImage(int type, QUrl url)
     d.concert = m_concert;
     d.imageType = type;
     d.url = url;
+    d.priority = true;
     emit sigLoadingImages(m_concert, QList<int>() << type);
     m_downloadManager->addDownload(d);
 }
@@ -6,10 +6,10 @@
 #include <QScrollBar>
 #include <QTableWidget>
 #include <QTimer>
+#include "data/ImageCache.h"
 #include "globals/Globals.h"
 #include "globals/LocaleStringCompare.h"
 #include "globals/Manager.h"
-#include "smallWidgets/LoadingStreamDetails.h"
 
 ConcertFilesWidget *ConcertFilesWidget::m_instance;
 
@@ -50,6 +50,7 @@ ConcertFilesWidget::ConcertFilesWidget(QWidget *parent) :
     QAction *actionMarkAsWatched = new QAction(tr("Mark as watched"), this);
     QAction *actionMarkAsUnwatched = new QAction(tr("Mark as unwatched"), this);
     QAction *actionLoadStreamDetails = new QAction(tr("Load Stream Details"), this);
+    m_actionStopStreamDetails = new QAction(tr("Stop Loading Stream Details"), this);
     QAction *actionMarkForSync = new QAction(tr("Add to Synchronization Queue"), this);
     QAction *actionUnmarkForSync = new QAction(tr("Remove from Synchronization Queue"), this);
     QAction *actionOpenFolder = new QAction(tr("Open Concert Folder"), this);
@@ -59,6 +60,7 @@ ConcertFilesWidget::ConcertFilesWidget(QWidget *parent) :
     m_contextMenu->addAction(actionMarkAsUnwatched);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionLoadStreamDetails);
+    m_contextMenu->addAction(m_actionStopStreamDetails);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionMarkForSync);
     m_contextMenu->addAction(actionUnmarkForSync);
@@ -68,6 +70,8 @@ ConcertFilesWidget::ConcertFilesWidget(QWidget *parent) :
     connect(actionMarkAsWatched, SIGNAL(triggered()), this, SLOT(markAsWatched()));
     connect(actionMarkAsUnwatched, SIGNAL(triggered()), this, SLOT(markAsUnwatched()));
     connect(actionLoadStreamDetails, SIGNAL(triggered()), this, SLOT(loadStreamDetails()));
+    connect(m_actionStopStreamDetails, SIGNAL(triggered()), Manager::instance()->streamDetailsLoader(), SLOT(abort()));
+    connect(Manager::instance()->streamDetailsLoader(), SIGNAL(sigLoaded(Concert*)), this, SLOT(onStreamDetailsLoaded(Concert*)));
     connect(actionMarkForSync, SIGNAL(triggered()), this, SLOT(markForSync()));
     connect(actionUnmarkForSync, SIGNAL(triggered()), this, SLOT(unmarkForSync()));
     connect(actionOpenFolder, SIGNAL(triggered()), this, SLOT(openFolder()));
@@ -104,6 +108,7 @@ ConcertFilesWidget *ConcertFilesWidget::instance()
 
 void ConcertFilesWidget::showContextMenu(QPoint point)
 {
+    m_actionStopStreamDetails->setEnabled(Manager::instance()->streamDetailsLoader()->isRunning());
     m_contextMenu->exec(ui->files->mapToGlobal(point));
 }
 
@@ -151,9 +156,7 @@ void ConcertFilesWidget::loadStreamDetails()
         concerts.at(0)->controller()->loadStreamDetailsFromFile();
         concerts.at(0)->setChanged(true);
     } else {
-        LoadingStreamDetails *loader = new LoadingStreamDetails(this);
-        loader->loadConcerts(concerts);
-        delete loader;
+        Manager::instance()->streamDetailsLoader()->load(concerts);
     }
     concertSelectedEmitter();
 }
@@ -224,6 +227,37 @@ void ConcertFilesWidget::itemActivated(QModelIndex index, QModelIndex previous)
     int row = index.model()->data(index, Qt::UserRole).toInt();
     m_lastConcert = Manager::instance()->concertModel()->concert(row);
     QTimer::singleShot(0, this, SLOT(concertSelectedEmitter()));
+    prefetchImages(index);
+}
+
+/**
+ * @brief Prefetches the poster and backdrop of the concerts next to the selected one
+ * @param index Index of the selected concert
+ */
+void ConcertFilesWidget::prefetchImages(const QModelIndex &index)
+{
+    QMap<int, QStringList> images;
+    for (int i=-2 ; i<=2 ; ++i) {
+        QModelIndex sibling = index.sibling(index.row()+i, 0);
+        if (i == 0 || !sibling.isValid())
+            continue;
+        Concert *concert = Manager::instance()->concertModel()->concert(sibling.model()->data(sibling, Qt::UserRole).toInt());
+        foreach (const int &imageType, QList<int>() << ImageType::ConcertPoster << ImageType::ConcertBackdrop) {
+            if (concert->hasImage(imageType))
+                images[imageType] << Manager::instance()->mediaCenterInterface()->imageFileName(concert, imageType);
+        }
+    }
+    ImageCache::instance()->prefetchImages(images);
+}
+
+/**
+ * @brief Updates the concert widget when the stream details of the current concert were loaded in the background
+ * @param concert Concert whose stream details were loaded
+ */
+void ConcertFilesWidget::onStreamDetailsLoaded(Concert *concert)
+{
+    if (concert == m_lastConcert)
+        concertSelectedEmitter();
 }
 
 /**
@@ -1,6 +1,7 @@
 #ifndef CONCERTFILESWIDGET_H
 #define CONCERTFILESWIDGET_H
 
+#include <QAction>
 #include <QLabel>
 #include <QMenu>
 #include <QWidget>
@@ -47,6 +48,7 @@ protected:
 
 private slots:
     void itemActivated(QModelIndex index, QModelIndex previous);
+    void onStreamDetailsLoaded(Concert *concert);
     void showContextMenu(QPoint point);
     void markAsWatched();
     void markAsUnwatched();
@@ -65,10 +67,12 @@ private:
     ConcertProxyModel *m_concertProxyModel;
     Concert *m_lastConcert;
     QModelIndex m_lastModelIndex;
+    QAction *m_actionStopStreamDetails;
     static ConcertFilesWidget *m_instance;
     QMenu *m_contextMenu;
     AlphabeticalList *m_alphaList;
     bool m_mouseIsIn;
+    void prefetchImages(const QModelIndex &index);
 };
 
 #endif // CONCERTFILESWIDGET_H
@@ -4,6 +4,7 @@
 #include <QDebug>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include "data/DirectoryWalker.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 
@@ -50,6 +51,7 @@ void ConcertFileSearcher::reload(bool force)
     QList<Concert*> concerts;
     QList<Concert*> dbConcerts;
     QList<QStringList> contents;
+    QList<SettingsDir> scanDirs;
     foreach (SettingsDir dir, m_directories) {
         if (m_aborted)
             return;
@@ -57,11 +59,12 @@ void ConcertFileSearcher::reload(bool force)
         QList<Concert*> concertsFromDb = Manager::instance()->database()->concerts(dir.path);
         if (dir.autoReload || force || concertsFromDb.count() == 0) {
             Manager::instance()->database()->clearConcerts(dir.path);
-            scanDir(dir.path, dir.path, contents, dir.separateFolders, true);
+            scanDirs << dir;
         } else {
             dbConcerts.append(concertsFromDb);
         }
     }
+    scanConcertDirs(scanDirs, contents);
     emit currentDir("");
 
     emit searchStarted(tr("Loading Concerts..."), m_progressMessageId);
@@ -71,8 +74,10 @@ void ConcertFileSearcher::reload(bool force)
     // Setup concerts
     Manager::instance()->database()->transaction();
     foreach (const QStringList &files, contents) {
-        if (m_aborted)
+        if (m_aborted) {
+            Manager::instance()->database()->commit();
             return;
+        }
 
         bool inSeparateFolder = false;
         QString path;
@@ -103,15 +108,20 @@ void ConcertFileSearcher::reload(bool force)
     Manager::instance()->database()->commit();
 
     // Setup concerts loaded from database
+    Manager::instance()->database()->transaction();
     foreach (Concert *concert, dbConcerts) {
-        if (m_aborted)
+        if (m_aborted) {
+            Manager::instance()->database()->commit();
             return;
+        }
 
         concert->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
+        Manager::instance()->database()->addMissingSearchEntry(concert);
         emit currentDir(concert->name());
         concerts.append(concert);
         emit progress(++concertCounter, concertSum, m_progressMessageId);
     }
+    Manager::instance()->database()->commit();
 
     foreach (Concert *concert, concerts)
         Manager::instance()->concertModel()->addConcert(concert);
@@ -122,48 +132,77 @@ void ConcertFileSearcher::reload(bool force)
 }
 
 /**
- * @brief Scans the given path for concert files.
+ * @brief Scans the given directories for concert files. All directories are walked in parallel.
  * Results are in a list which contains a QStringList for every concert.
- * @param startPath Scanning started at this path
- * @param path Path to scan
+ * When a directory has separate folders, only its direct subfolders are scanned.
+ * @param dirs Directories to scan
  * @param contents List of contents
- * @param separateFolders Are concerts in separate folders
- * @param firstScan When this is true, subfolders are scanned, regardless of separateFolders
  */
-void ConcertFileSearcher::scanDir(QString startPath, QString path, QList<QStringList> &contents, bool separateFolders, bool firstScan)
+void ConcertFileSearcher::scanConcertDirs(QList<SettingsDir> dirs, QList<QStringList> &contents)
 {
-    emit currentDir(path.mid(startPath.length()));
+    DirectoryWalker walker(Settings::instance()->advanced()->concertFilters());
+    walker.setDetectDiscs(true);
 
-    QDir dir(path);
-    foreach (const QString &cDir, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-        if (m_aborted)
+    QHash<QString, int> depths;
+    for (int i=0, n=dirs.count() ; i<n ; ++i) {
+        depths.insert(dirs.at(i).path, 0);
+        walker.enqueue(dirs.at(i).path, i);
+    }
+
+    DirectoryWalker::Listing listing;
+    while (walker.next(listing)) {
+        if (m_aborted) {
+            walker.abort();
             return;
+        }
 
-        // Skip "Extras" folder
-        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0 ||
-            QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0 ||
-            QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0)
-            continue;
+        int depth = depths.value(listing.path);
+        bool separateFolders = dirs.at(listing.root).separateFolders;
 
-        // Handle DVD
-        if (Helper::instance()->isDvd(path + QDir::separator() + cDir)) {
-            contents.append(QStringList() << QDir::toNativeSeparators(path + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO"));
+        // Handle DVD and BluRay structures
+        if (depth > 0 && listing.discType == DiscDvd) {
+            contents.append(QStringList() << QDir::toNativeSeparators(listing.path + "/VIDEO_TS/VIDEO_TS.IFO"));
+            continue;
+        }
+        if (depth > 0 && listing.discType == DiscBluRay) {
+            contents.append(QStringList() << QDir::toNativeSeparators(listing.path + "/BDMV/index.bdmv"));
             continue;
         }
 
-        // Handle BluRay
-        if (Helper::instance()->isBluRay(path + QDir::separator() + cDir)) {
-            contents.append(QStringList() << QDir::toNativeSeparators(path + "/" + cDir + "/BDMV/index.bdmv"));
+        // Subfolders of separate folders are only checked for disc structures
+        if (separateFolders && depth > 1)
             continue;
+
+        emit currentDir(listing.path.mid(dirs.at(listing.root).path.length()));
+
+        foreach (const QFileInfo &fi, listing.dirs) {
+            // Skip "Extras" folder
+            if (QString::compare(fi.fileName(), "Extras", Qt::CaseInsensitive) == 0 ||
+                QString::compare(fi.fileName(), ".actors", Qt::CaseInsensitive) == 0 ||
+                QString::compare(fi.fileName(), "extrafanarts", Qt::CaseInsensitive) == 0)
+                continue;
+            depths.insert(fi.filePath(), depth+1);
+            walker.enqueue(fi.filePath(), listing.root);
         }
 
-        // Don't scan subfolders when separate folders is checked
-        if (!separateFolders || firstScan)
-            scanDir(startPath, path + "/" + cDir, contents, separateFolders);
+        QStringList files;
+        foreach (const QFileInfo &fi, listing.files)
+            files << fi.fileName();
+        addConcertFiles(listing.path, files, separateFolders, contents);
     }
+}
 
-    QStringList files;
-    QStringList entries = getFiles(path);
+/**
+ * @brief Groups the files of a folder to concerts.
+ * @param path Folder of the files
+ * @param files File names
+ * @param separateFolders Are concerts in separate folders
+ * @param contents List of contents
+ */
+void ConcertFileSearcher::addConcertFiles(QString path, QStringList files, bool separateFolders, QList<QStringList> &contents)
+{
+    QStringList entries = files;
+    files.clear();
     foreach (const QString &file, entries) {
         if (m_aborted)
             return;
@@ -215,19 +254,6 @@ void ConcertFileSearcher::scanDir(QString startPath, QString path, QList<QString
     }
 }
 
-/**
- * @brief Get a list of files in a directory
- * @param path
- * @return
- */
-QStringList ConcertFileSearcher::getFiles(QString path)
-{
-    if (Settings::instance()->advanced()->concertFilters().isEmpty())
-        return QStringList();
-
-    return QDir(path).entryList(Settings::instance()->advanced()->concertFilters(), QDir::Files | QDir::System);
-}
-
 void ConcertFileSearcher::abort()
 {
     m_aborted = true;
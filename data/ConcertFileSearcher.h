@@ -30,8 +30,8 @@ signals:
 private:
     QList<SettingsDir> m_directories;
     int m_progressMessageId;
-    void scanDir(QString startPath, QString path, QList<QStringList> &contents, bool separateFolders = false, bool firstScan = false);
-    QStringList getFiles(QString path);
+    void scanConcertDirs(QList<SettingsDir> dirs, QList<QStringList> &contents);
+    void addConcertFiles(QString path, QStringList files, bool separateFolders, QList<QStringList> &contents);
     bool m_aborted;
 };
 
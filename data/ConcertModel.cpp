@@ -4,6 +4,7 @@
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
+#include "settings/Settings.h"
 
 /**
  * @brief ConcertModel::ConcertModel
@@ -21,7 +22,7 @@ ConcertModel::ConcertModel(QObject *parent) :
     m_syncIcon = font->icon("refresh_cloud", QColor(248, 148, 6), QColor(255, 255, 255), "", 0, 1.0);
     m_newIcon = font->icon("star", QColor(58, 135, 173), QColor(255, 255, 255), "", 0, 1.0);
 #endif
-
+    connect(Settings::instance(), SIGNAL(sigSettingsSaved()), this, SLOT(onSettingsSaved()));
 }
 
 /**
@@ -31,6 +32,8 @@ ConcertModel::ConcertModel(QObject *parent) :
 void ConcertModel::addConcert(Concert *concert)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
+    updateSortKeys(concert);
+    updateFacets(concert);
     m_concerts.append(concert);
     endInsertRows();
     connect(concert, SIGNAL(sigChanged(Concert*)), this, SLOT(onConcertChanged(Concert*)), Qt::UniqueConnection);
@@ -38,11 +41,13 @@ void ConcertModel::addConcert(Concert *concert)
 
 /**
  * @brief Called when a concerts data has changed
- * Emits dataChanged
+ * Updates the sort keys and the facet counts and emits dataChanged
  * @param concert Concert which has changed
  */
 void ConcertModel::onConcertChanged(Concert *concert)
 {
+    updateSortKeys(concert);
+    updateFacets(concert);
     QModelIndex index = createIndex(m_concerts.indexOf(concert), 0);
     emit dataChanged(index, index);
 }
@@ -173,9 +178,59 @@ void ConcertModel::clear()
     foreach (Concert *concert, m_concerts)
         delete concert;
     m_concerts.clear();
+    m_sortKeys.clear();
+    m_facets.clear();
     endRemoveRows();
 }
 
+/**
+ * @brief Returns the precomputed sort keys of all concerts, the flags hold ConcertModel::SortKeyInfoLoaded
+ * @return Sort keys
+ */
+const SortKeyCache *ConcertModel::sortKeys() const
+{
+    return &m_sortKeys;
+}
+
+/**
+ * @brief Computes the sort keys of a concert
+ * @param concert Concert
+ */
+void ConcertModel::updateSortKeys(Concert *concert)
+{
+    m_sortKeys.setKeys(concert, concert->name(), 0, concert->controller()->infoLoaded() ? SortKeyInfoLoaded : 0);
+}
+
+/**
+ * @brief Returns how many concerts have each genre and tag
+ * @return Facet counts, the facets are ConcertFilters::Genres and ConcertFilters::Tags
+ */
+const FacetCounts *ConcertModel::facets() const
+{
+    return &m_facets;
+}
+
+/**
+ * @brief Updates the facet values of a concert
+ * @param concert Concert
+ */
+void ConcertModel::updateFacets(Concert *concert)
+{
+    FacetCounts::Values values;
+    FacetCounts::addValues(values, ConcertFilters::Genres, concert->genres());
+    FacetCounts::addValues(values, ConcertFilters::Tags, concert->tags());
+    m_facets.setValues(concert, values);
+}
+
+/**
+ * @brief Computes the sort keys of all concerts again, the articles to ignore may have changed
+ */
+void ConcertModel::onSettingsSaved()
+{
+    foreach (Concert *concert, m_concerts)
+        updateSortKeys(concert);
+}
+
 /**
  * @brief Returns a list of all concerts
  * @return List of concerts
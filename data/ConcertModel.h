@@ -4,6 +4,8 @@
 #include <QAbstractItemModel>
 #include <QIcon>
 #include "data/Concert.h"
+#include "globals/FacetCounts.h"
+#include "globals/SortKeyCache.h"
 
 /**
  * @brief The ConcertModel class
@@ -16,6 +18,9 @@ public:
          NameRole = Qt::UserRole + 1,
          FileNameRole
     };
+    enum SortKeyFlags {
+        SortKeyInfoLoaded = 0x1
+    };
     explicit ConcertModel(QObject *parent = 0);
     void addConcert(Concert *concert);
     void clear();
@@ -28,14 +33,22 @@ public:
     QModelIndex parent(const QModelIndex &child) const;
     int hasNewConcerts();
     void update();
+    const SortKeyCache *sortKeys() const;
+    const FacetCounts *facets() const;
 
 private slots:
     void onConcertChanged(Concert *concert);
+    void onSettingsSaved();
 
 private:
     QList<Concert*> m_concerts;
+    SortKeyCache m_sortKeys;
+    FacetCounts m_facets;
     QIcon m_newIcon;
     QIcon m_syncIcon;
+
+    void updateSortKeys(Concert *concert);
+    void updateFacets(Concert *concert);
 };
 
 #endif // CONCERTMODEL_H
@@ -37,18 +37,24 @@ bool ConcertProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourc
 
 /**
  * @brief Sort function for the concert model. Sorts concerts by name and new files to top.
+ *        Uses the precomputed sort keys of the model.
  * @param left
  * @param right
  * @return
  */
 bool ConcertProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
-    if (sourceModel()->data(left, Qt::UserRole+1).toBool() && !sourceModel()->data(right, Qt::UserRole+1).toBool() )
-        return true;
-    if (!sourceModel()->data(left, Qt::UserRole+1).toBool() && sourceModel()->data(right, Qt::UserRole+1).toBool() )
-        return false;
-    int cmp = QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString());
-    return !(cmp < 0);
+    ConcertModel *model = Manager::instance()->concertModel();
+    const SortKeyCache::SortKey *leftKey = model->sortKeys()->key(model->concert(left.row()));
+    const SortKeyCache::SortKey *rightKey = model->sortKeys()->key(model->concert(right.row()));
+    if (!leftKey || !rightKey)
+        return !(QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString()) < 0);
+
+    bool leftLoaded = leftKey->flags & ConcertModel::SortKeyInfoLoaded;
+    bool rightLoaded = rightKey->flags & ConcertModel::SortKeyInfoLoaded;
+    if (leftLoaded != rightLoaded)
+        return leftLoaded;
+    return !(leftKey->compareTitle(*rightKey) < 0);
 }
 
 /**
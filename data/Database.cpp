@@ -3,9 +3,12 @@
 #include <QDesktopServices>
 #include <QDebug>
 #include <QDir>
+#include <QRegExp>
+#include <QSet>
 #include <QSqlError>
 #include <QSqlQuery>
-#include <QSqlRecord>
+#include <QThread>
+#include "data/DatabaseRow.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "mediaCenterPlugins/XbmcXml.h"
@@ -16,7 +19,12 @@
  * @param parent
  */
 Database::Database(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_transactionDepth(0),
+    m_queryCount(0),
+    m_hasSearchIndex(false),
+    m_searchIndexChanged(false),
+    m_searchRevision(0)
 {
     QString dataLocation = Settings::instance()->databaseDir();
     QDir dir(dataLocation);
@@ -213,6 +221,148 @@ Database::Database(QObject *parent) :
             updateDbVersion(16);
         }
 
+        if (myDbVersion < 17) {
+            query.prepare("DROP TABLE IF EXISTS movieFolders;");
+            query.exec();
+
+            query.prepare("CREATE TABLE IF NOT EXISTS movieFolders( "
+                          "\"idFolder\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
+                          "\"dir\" text NOT NULL, "
+                          "\"lastModified\" integer NOT NULL, "
+                          "\"path\" text NOT NULL "
+                          ");");
+            query.exec();
+            query.prepare("CREATE INDEX id_movie_folders_path_idx ON movieFolders(path);");
+            query.exec();
+
+            myDbVersion = 17;
+            updateDbVersion(17);
+        }
+
+        if (myDbVersion < 18) {
+            // Columns used by the movie list, filters and sorting, rows with cached=0 are filled from their nfo content
+            QStringList columns;
+            columns << "\"cached\" integer NOT NULL DEFAULT 0"
+                    << "\"infoLoaded\" integer NOT NULL DEFAULT 0"
+                    << "\"title\" text NOT NULL DEFAULT ''"
+                    << "\"sortTitle\" text NOT NULL DEFAULT ''"
+                    << "\"originalTitle\" text NOT NULL DEFAULT ''"
+                    << "\"released\" text NOT NULL DEFAULT ''"
+                    << "\"rating\" real NOT NULL DEFAULT 0"
+                    << "\"votes\" integer NOT NULL DEFAULT 0"
+                    << "\"top250\" integer NOT NULL DEFAULT 0"
+                    << "\"runtime\" integer NOT NULL DEFAULT 0"
+                    << "\"certification\" text NOT NULL DEFAULT ''"
+                    << "\"director\" text NOT NULL DEFAULT ''"
+                    << "\"movieSet\" text NOT NULL DEFAULT ''"
+                    << "\"imdbId\" text NOT NULL DEFAULT ''"
+                    << "\"tmdbId\" text NOT NULL DEFAULT ''"
+                    << "\"trailer\" text NOT NULL DEFAULT ''"
+                    << "\"watched\" integer NOT NULL DEFAULT 0"
+                    << "\"playcount\" integer NOT NULL DEFAULT 0"
+                    << "\"lastPlayed\" integer"
+                    << "\"dateAdded\" integer"
+                    << "\"hasActors\" integer NOT NULL DEFAULT 0"
+                    << "\"streamDetailsLoaded\" integer NOT NULL DEFAULT 0";
+            foreach (const QString &column, columns) {
+                query.prepare("ALTER TABLE movies ADD COLUMN " + column + ";");
+                query.exec();
+            }
+
+            query.prepare("DROP TABLE IF EXISTS movieValues;");
+            query.exec();
+            query.prepare("CREATE TABLE IF NOT EXISTS movieValues( "
+                          "\"idValue\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
+                          "\"idMovie\" integer NOT NULL, "
+                          "\"type\" text NOT NULL, "
+                          "\"value\" text NOT NULL "
+                          ");");
+            query.exec();
+            query.prepare("CREATE INDEX id_movie_values_idx ON movieValues(idMovie);");
+            query.exec();
+
+            query.prepare("DROP TABLE IF EXISTS movieStreamDetails;");
+            query.exec();
+            query.prepare("CREATE TABLE IF NOT EXISTS movieStreamDetails( "
+                          "\"idDetail\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
+                          "\"idMovie\" integer NOT NULL, "
+                          "\"type\" text NOT NULL, "
+                          "\"streamNumber\" integer NOT NULL, "
+                          "\"key\" text NOT NULL, "
+                          "\"value\" text NOT NULL "
+                          ");");
+            query.exec();
+            query.prepare("CREATE INDEX id_movie_stream_details_idx ON movieStreamDetails(idMovie);");
+            query.exec();
+
+            myDbVersion = 18;
+            updateDbVersion(18);
+        }
+
+        if (myDbVersion < 19) {
+            // Stream details read by MediaInfo, valid as long as size and modification time of the file don't change
+            query.prepare("CREATE TABLE IF NOT EXISTS streamDetailsFiles( "
+                          "\"idFile\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
+                          "\"file\" text NOT NULL, "
+                          "\"size\" integer NOT NULL, "
+                          "\"lastModified\" integer NOT NULL "
+                          ");");
+            query.exec();
+            query.prepare("CREATE UNIQUE INDEX id_stream_details_files_file_idx ON streamDetailsFiles(file);");
+            query.exec();
+            query.prepare("CREATE TABLE IF NOT EXISTS streamDetailsCache( "
+                          "\"idDetail\" integer NOT NULL PRIMARY KEY AUTOINCREMENT, "
+                          "\"idFile\" integer NOT NULL, "
+                          "\"type\" text NOT NULL, "
+                          "\"streamNumber\" integer NOT NULL, "
+                          "\"key\" text NOT NULL, "
+                          "\"value\" text NOT NULL "
+                          ");");
+            query.exec();
+            query.prepare("CREATE INDEX id_stream_details_cache_idx ON streamDetailsCache(idFile);");
+            query.exec();
+
+            myDbVersion = 19;
+            updateDbVersion(19);
+        }
+
+        if (myDbVersion < 20) {
+            // Full text search, needs an SQLite with FTS5 or FTS4
+            query.prepare("DROP TABLE IF EXISTS movieSearch;");
+            query.exec();
+            query.prepare("DROP TABLE IF EXISTS concertSearch;");
+            query.exec();
+            if (createSearchTable("movieSearch") && createSearchTable("concertSearch")) {
+                // Entries of cached movies are filled from their cached columns, plot and actors are added
+                // when the movie is written again. Concerts get their entries when they are loaded.
+                query.prepare("INSERT INTO movieSearch(rowid, title, plot, people, tags, path) "
+                              "SELECT M.idMovie, "
+                              "IFNULL(CAST(M.title AS TEXT), '') || ' ' || IFNULL(CAST(M.originalTitle AS TEXT), '') || ' ' || "
+                              "IFNULL(CAST(M.sortTitle AS TEXT), ''), "
+                              "'', "
+                              "IFNULL(CAST(M.director AS TEXT), ''), "
+                              "IFNULL(CAST(M.movieSet AS TEXT), '') || ' ' || "
+                              "IFNULL((SELECT group_concat(CAST(V.value AS TEXT), ' ') FROM movieValues V WHERE V.idMovie=M.idMovie), ''), "
+                              "IFNULL((SELECT group_concat(CAST(F.file AS TEXT), ' ') FROM movieFiles F WHERE F.idMovie=M.idMovie), '') "
+                              "FROM movies M WHERE M.cached=1;");
+                query.exec();
+            } else {
+                query.prepare("DROP TABLE IF EXISTS movieSearch;");
+                query.exec();
+                qWarning() << "SQLite has no full text search, the full text filter is not available";
+            }
+
+            myDbVersion = 20;
+            updateDbVersion(20);
+        }
+
+        query.prepare("SELECT name FROM sqlite_master WHERE name IN ('movieSearch', 'concertSearch')");
+        query.exec();
+        int searchTables = 0;
+        while (query.next())
+            searchTables++;
+        m_hasSearchIndex = (searchTables == 2);
+
         query.prepare("PRAGMA synchronous=0;");
         query.exec();
 
@@ -226,6 +376,8 @@ Database::Database(QObject *parent) :
  */
 Database::~Database()
 {
+    qDeleteAll(m_preparedQueries);
+    m_preparedQueries.clear();
     if (m_db && m_db->isOpen()) {
         m_db->close();
         delete m_db;
@@ -268,19 +420,158 @@ QSqlDatabase Database::db()
     return *m_db;
 }
 
+/**
+ * @brief Starts a transaction. Calls can be nested, only the outermost call opens a transaction on the database,
+ *        so a scan can wrap all its writes into a single transaction.
+ * @see Database::commit
+ */
 void Database::transaction()
 {
-    db().transaction();
+    if (m_transactionDepth++ == 0)
+        db().transaction();
 }
 
+/**
+ * @brief Commits the transaction when the outermost Database::transaction call is finished
+ */
 void Database::commit()
 {
-    db().commit();
+    if (m_transactionDepth == 0)
+        return;
+    if (--m_transactionDepth == 0) {
+        db().commit();
+        if (m_searchIndexChanged) {
+            m_searchIndexChanged = false;
+            m_searchRevision++;
+        }
+    }
+}
+
+/**
+ * @brief Executes a query and counts it for Database::queryCount
+ * @param query Prepared query
+ * @return True if the query was executed successfully
+ */
+bool Database::exec(QSqlQuery &query)
+{
+    m_queryCount++;
+    if (!query.exec()) {
+        qWarning() << "Query failed" << query.lastQuery() << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Number of queries executed by the bulk loaders since the last reset
+ * @return Number of queries
+ * @see Database::resetQueryCount
+ */
+int Database::queryCount() const
+{
+    return m_queryCount;
+}
+
+/**
+ * @brief Resets the query counter
+ * @see Database::queryCount
+ */
+void Database::resetQueryCount()
+{
+    m_queryCount = 0;
+}
+
+/**
+ * @brief Returns a query for a write statement which is prepared only once per connection and reused afterwards.
+ *        The query is shared by all callers of the same statement, so this is not reentrant:
+ *        it may only be used from the thread of the database and the returned query has to be
+ *        executed before the same statement is requested again.
+ * @param statement SQL statement
+ * @return Prepared query, bound values have to be set before each execution
+ */
+QSqlQuery &Database::preparedQuery(const QString &statement)
+{
+    Q_ASSERT(QThread::currentThread() == thread());
+    QSqlQuery *query = m_preparedQueries.value(statement, 0);
+    if (!query) {
+        query = new QSqlQuery(db());
+        if (!query->prepare(statement))
+            qWarning() << "Could not prepare statement" << statement << query->lastError().text();
+        m_preparedQueries.insert(statement, query);
+    }
+    return *query;
+}
+
+/**
+ * @brief Inserts all files of an item with a single batch execution
+ * @param table Files table (movieFiles, concertFiles, episodeFiles)
+ * @param idColumn Column holding the id of the item
+ * @param id Database id of the item
+ * @param files Files to insert
+ */
+void Database::addFiles(const QString &table, const QString &idColumn, int id, const QStringList &files)
+{
+    if (files.isEmpty())
+        return;
+
+    QVariantList ids;
+    QVariantList fileValues;
+    foreach (const QString &file, files) {
+        ids << id;
+        fileValues << file.toUtf8();
+    }
+
+    QSqlQuery &query = preparedQuery(QString("INSERT INTO %1(%2, file) VALUES(:id, :file)").arg(table).arg(idColumn));
+    query.bindValue(":id", ids);
+    query.bindValue(":file", fileValues);
+    query.execBatch();
+}
+
+/**
+ * @brief Replaces the subtitles of a movie using a single batch execution
+ * @param movie Movie with a valid database id
+ */
+void Database::setMovieSubtitles(Movie *movie)
+{
+    QSqlQuery &deleteQuery = preparedQuery("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
+    deleteQuery.bindValue(":idMovie", movie->databaseId());
+    deleteQuery.exec();
+
+    if (movie->subtitles().isEmpty())
+        return;
+
+    QVariantList ids;
+    QVariantList files;
+    QVariantList languages;
+    QVariantList forced;
+    foreach (Subtitle *subtitle, movie->subtitles()) {
+        ids << movie->databaseId();
+        files << subtitle->files().join("%§%");
+        languages << (subtitle->language().isEmpty() ? "" : subtitle->language());
+        forced << (subtitle->forced() ? 1 : 0);
+    }
+
+    QSqlQuery &query = preparedQuery("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, :language, :forced)");
+    query.bindValue(":idMovie", ids);
+    query.bindValue(":files", files);
+    query.bindValue(":language", languages);
+    query.bindValue(":forced", forced);
+    query.execBatch();
 }
 
 void Database::clearMovies(QString path)
 {
     QSqlQuery query(db());
+    if (m_hasSearchIndex) {
+        if (!path.isEmpty()) {
+            query.prepare("DELETE FROM movieSearch WHERE rowid IN (SELECT idMovie FROM movies WHERE path=:path)");
+            query.bindValue(":path", path.toUtf8());
+        } else {
+            query.prepare("DELETE FROM movieSearch");
+        }
+        query.exec();
+        setSearchIndexChanged();
+    }
     if (!path.isEmpty()) {
         query.prepare("DELETE FROM movieFiles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
         query.bindValue(":path", path.toUtf8());
@@ -288,6 +579,12 @@ void Database::clearMovies(QString path)
         query.prepare("DELETE FROM movieSubtitles WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
         query.bindValue(":path", path.toUtf8());
         query.exec();
+        query.prepare("DELETE FROM movieValues WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
+        query.bindValue(":path", path.toUtf8());
+        query.exec();
+        query.prepare("DELETE FROM movieStreamDetails WHERE idMovie IN (SELECT idMovie FROM movies WHERE path=:path)");
+        query.bindValue(":path", path.toUtf8());
+        query.exec();
         query.prepare("DELETE FROM movies WHERE path=:path");
         query.bindValue(":path", path.toUtf8());
         query.exec();
@@ -304,13 +601,100 @@ void Database::clearMovies(QString path)
         query.exec();
         query.prepare("DELETE FROM sqlite_sequence WHERE name='movieSubtitles'");
         query.exec();
+        query.prepare("DELETE FROM movieValues");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='movieValues'");
+        query.exec();
+        query.prepare("DELETE FROM movieStreamDetails");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='movieStreamDetails'");
+        query.exec();
     }
+    clearMovieFolders(path);
 }
 
-void Database::add(Movie *movie, QString path)
+/**
+ * @brief Removes a single movie and its files and subtitles from the cache
+ * @param movie Movie to remove
+ */
+void Database::remove(Movie *movie)
+{
+    removeSearchEntry("movieSearch", movie->databaseId());
+    QSqlQuery query(db());
+    query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", movie->databaseId());
+    query.exec();
+    query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", movie->databaseId());
+    query.exec();
+    query.prepare("DELETE FROM movieValues WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", movie->databaseId());
+    query.exec();
+    query.prepare("DELETE FROM movieStreamDetails WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", movie->databaseId());
+    query.exec();
+    query.prepare("DELETE FROM movies WHERE idMovie=:idMovie");
+    query.bindValue(":idMovie", movie->databaseId());
+    query.exec();
+}
+
+void Database::clearMovieFolders(QString path)
+{
+    QSqlQuery query(db());
+    if (!path.isEmpty()) {
+        query.prepare("DELETE FROM movieFolders WHERE path=:path");
+        query.bindValue(":path", path.toUtf8());
+        query.exec();
+    } else {
+        query.prepare("DELETE FROM movieFolders");
+        query.exec();
+        query.prepare("DELETE FROM sqlite_sequence WHERE name='movieFolders'");
+        query.exec();
+    }
+}
+
+/**
+ * @brief Stores the modification times of all folders below a movie directory
+ * @param path Movie directory
+ * @param folders Folder paths and their modification times (msecs since epoch)
+ */
+void Database::setMovieFolders(QString path, QHash<QString, qint64> folders)
 {
+    clearMovieFolders(path);
+
     QSqlQuery query(db());
-    query.prepare("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
+    query.prepare("INSERT INTO movieFolders(dir, lastModified, path) VALUES(:dir, :lastModified, :path)");
+    QHashIterator<QString, qint64> it(folders);
+    while (it.hasNext()) {
+        it.next();
+        query.bindValue(":dir", it.key().toUtf8());
+        query.bindValue(":lastModified", it.value());
+        query.bindValue(":path", path.toUtf8());
+        query.exec();
+    }
+}
+
+/**
+ * @brief Returns the folder modification times stored during the last scan of a movie directory
+ * @param path Movie directory
+ * @return Folder paths and their modification times (msecs since epoch)
+ */
+QHash<QString, qint64> Database::movieFolders(QString path)
+{
+    QHash<QString, qint64> folders;
+    QSqlQuery query(db());
+    query.prepare("SELECT dir, lastModified FROM movieFolders WHERE path=:path");
+    query.bindValue(":path", path.toUtf8());
+    query.exec();
+    while (query.next())
+        folders.insert(QString::fromUtf8(query.value(0).toByteArray()), query.value(1).toLongLong());
+    return folders;
+}
+
+void Database::add(Movie *movie, QString path)
+{
+    transaction();
+    QSqlQuery &query = preparedQuery("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
                   "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, :hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path)");
     query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent().toUtf8());
     query.bindValue(":lastModified", movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
@@ -327,56 +711,157 @@ void Database::add(Movie *movie, QString path)
     query.bindValue(":path", path.toUtf8());
     query.exec();
     int insertId = query.lastInsertId().toInt();
+    movie->setDatabaseId(insertId);
 
-    foreach (const QString &file, movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":file", file.toUtf8());
-        query.exec();
-    }
-
-    foreach (Subtitle *subtitle, movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, :language, :forced)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
-        query.exec();
-    }
-
+    addFiles("movieFiles", "idMovie", insertId, movie->files());
+    setMovieSubtitles(movie);
     setLabel(movie->files(), movie->label());
-
-    movie->setDatabaseId(insertId);
+    setMovieDetails(movie);
+    setMovieSearchEntry(movie);
+    commit();
 }
 
 void Database::update(Movie *movie)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent());
+    transaction();
+    // Movies filled from the cache have no nfo content until they are opened, keep the stored one
+    if (!movie->nfoContent().isEmpty()) {
+        QSqlQuery &query = preparedQuery("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
+        query.bindValue(":content", movie->nfoContent());
+        query.bindValue(":idMovie", movie->databaseId());
+        query.exec();
+    }
+
+    QSqlQuery &query = preparedQuery("DELETE FROM movieFiles WHERE idMovie=:idMovie");
     query.bindValue(":idMovie", movie->databaseId());
     query.exec();
+    addFiles("movieFiles", "idMovie", movie->databaseId(), movie->files());
+    setMovieSubtitles(movie);
+    setMovieDetails(movie);
+    setMovieSearchEntry(movie);
+    commit();
+}
 
-    query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
+/**
+ * @brief Stores the infos needed by the movie list, filters and sorting in their own columns and tables,
+ *        so the movie can be restored without parsing its nfo
+ * @param movie Movie with a valid database id
+ */
+void Database::setMovieDetails(Movie *movie)
+{
+    QSqlQuery &query = preparedQuery("UPDATE movies SET cached=1, infoLoaded=:infoLoaded, title=:title, sortTitle=:sortTitle, originalTitle=:originalTitle, "
+                  "released=:released, rating=:rating, votes=:votes, top250=:top250, runtime=:runtime, certification=:certification, "
+                  "director=:director, movieSet=:movieSet, imdbId=:imdbId, tmdbId=:tmdbId, trailer=:trailer, watched=:watched, "
+                  "playcount=:playcount, lastPlayed=:lastPlayed, dateAdded=:dateAdded, hasActors=:hasActors, "
+                  "streamDetailsLoaded=:streamDetailsLoaded "
+                  "WHERE idMovie=:idMovie");
+    query.bindValue(":infoLoaded", movie->controller()->infoLoaded() ? 1 : 0);
+    query.bindValue(":title", movie->name().toUtf8());
+    query.bindValue(":sortTitle", movie->sortTitle().toUtf8());
+    query.bindValue(":originalTitle", movie->originalName().toUtf8());
+    query.bindValue(":released", movie->released().isValid() ? movie->released().toString(Qt::ISODate) : "");
+    query.bindValue(":rating", movie->rating());
+    query.bindValue(":votes", movie->votes());
+    query.bindValue(":top250", movie->top250());
+    query.bindValue(":runtime", movie->runtime());
+    query.bindValue(":certification", movie->certification().toUtf8());
+    query.bindValue(":director", movie->director().toUtf8());
+    query.bindValue(":movieSet", movie->set().toUtf8());
+    query.bindValue(":imdbId", movie->id().toUtf8());
+    query.bindValue(":tmdbId", movie->tmdbId().toUtf8());
+    query.bindValue(":trailer", movie->trailer().toString().toUtf8());
+    query.bindValue(":watched", movie->watched() ? 1 : 0);
+    query.bindValue(":playcount", movie->playcount());
+    query.bindValue(":lastPlayed", movie->lastPlayed());
+    query.bindValue(":dateAdded", movie->dateAdded());
+    query.bindValue(":hasActors", movie->hasActors() ? 1 : 0);
+    query.bindValue(":streamDetailsLoaded", movie->streamDetailsLoaded() ? 1 : 0);
     query.bindValue(":idMovie", movie->databaseId());
     query.exec();
-    foreach (const QString &file, movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", movie->databaseId());
-        query.bindValue(":file", file.toUtf8());
-        query.exec();
+
+    QSqlQuery &deleteValuesQuery = preparedQuery("DELETE FROM movieValues WHERE idMovie=:idMovie");
+    deleteValuesQuery.bindValue(":idMovie", movie->databaseId());
+    deleteValuesQuery.exec();
+
+    QVariantList ids;
+    QVariantList types;
+    QVariantList values;
+    QList<QPair<QString, QStringList> > lists;
+    lists << qMakePair(QString("genre"), movie->genres())
+          << qMakePair(QString("studio"), movie->studios())
+          << qMakePair(QString("country"), movie->countries())
+          << qMakePair(QString("tag"), movie->tags());
+    for (int i=0, n=lists.count() ; i<n ; ++i) {
+        foreach (const QString &value, lists.at(i).second) {
+            ids << movie->databaseId();
+            types << lists.at(i).first;
+            values << value.toUtf8();
+        }
     }
 
-    query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
-    query.bindValue(":idMovie", movie->databaseId());
-    query.exec();
-    foreach (Subtitle *subtitle, movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, :language, :forced)");
-        query.bindValue(":idMovie", movie->databaseId());
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
-        query.exec();
+    if (!ids.isEmpty()) {
+        QSqlQuery &valuesQuery = preparedQuery("INSERT INTO movieValues(idMovie, type, value) VALUES(:idMovie, :type, :value)");
+        valuesQuery.bindValue(":idMovie", ids);
+        valuesQuery.bindValue(":type", types);
+        valuesQuery.bindValue(":value", values);
+        valuesQuery.execBatch();
+    }
+
+    QSqlQuery &deleteDetailsQuery = preparedQuery("DELETE FROM movieStreamDetails WHERE idMovie=:idMovie");
+    deleteDetailsQuery.bindValue(":idMovie", movie->databaseId());
+    deleteDetailsQuery.exec();
+
+    addStreamDetails("movieStreamDetails", "idMovie", movie->databaseId(), movie->streamDetails());
+}
+
+/**
+ * @brief Inserts all stream details using a single batch execution
+ * @param table Stream details table (movieStreamDetails or streamDetailsCache)
+ * @param idColumn Name of the id column in the table
+ * @param id Id of the owner of the stream details
+ * @param streamDetails Stream details to insert
+ */
+void Database::addStreamDetails(const QString &table, const QString &idColumn, int id, StreamDetails *streamDetails)
+{
+    QList<QMap<QString, QString> > audioDetails = streamDetails->audioDetails();
+    QList<QMap<QString, QString> > subtitleDetails = streamDetails->subtitleDetails();
+    QList<QPair<QString, QMap<QString, QString> > > streams;
+    streams << qMakePair(QString("video"), streamDetails->videoDetails());
+    for (int i=0, n=audioDetails.count() ; i<n ; ++i)
+        streams << qMakePair(QString("audio"), audioDetails.at(i));
+    for (int i=0, n=subtitleDetails.count() ; i<n ; ++i)
+        streams << qMakePair(QString("subtitle"), subtitleDetails.at(i));
+
+    QVariantList detailIds;
+    QVariantList detailTypes;
+    QVariantList streamNumbers;
+    QVariantList keys;
+    QVariantList detailValues;
+    int streamNumber = 0;
+    QString lastType;
+    for (int i=0, n=streams.count() ; i<n ; ++i) {
+        streamNumber = (streams.at(i).first == lastType) ? streamNumber+1 : 0;
+        lastType = streams.at(i).first;
+        QMapIterator<QString, QString> it(streams.at(i).second);
+        while (it.hasNext()) {
+            it.next();
+            detailIds << id;
+            detailTypes << lastType;
+            streamNumbers << streamNumber;
+            keys << it.key();
+            detailValues << it.value().toUtf8();
+        }
+    }
+
+    if (!detailIds.isEmpty()) {
+        QSqlQuery &detailsQuery = preparedQuery(QString("INSERT INTO %1(%2, type, streamNumber, key, value) "
+                                                        "VALUES(:id, :type, :streamNumber, :key, :value)").arg(table).arg(idColumn));
+        detailsQuery.bindValue(":id", detailIds);
+        detailsQuery.bindValue(":type", detailTypes);
+        detailsQuery.bindValue(":streamNumber", streamNumbers);
+        detailsQuery.bindValue(":key", keys);
+        detailsQuery.bindValue(":value", detailValues);
+        detailsQuery.execBatch();
     }
 }
 
@@ -384,58 +869,92 @@ QList<Movie*> Database::movies(QString path)
 {
     transaction();
     QSqlQuery query(db());
-    query.prepare("SELECT M.idMovie, M.content, M.lastModified, M.inSeparateFolder, M.hasPoster, M.hasBackdrop, M.hasLogo, M.hasClearArt, "
-                  "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, MF.file, L.color "
+    query.prepare("SELECT M.idMovie, CASE WHEN M.cached=1 THEN '' ELSE M.content END AS content, M.lastModified, M.inSeparateFolder, "
+                  "M.hasPoster, M.hasBackdrop, M.hasLogo, M.hasClearArt, M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, "
+                  "M.cached, M.infoLoaded, M.title, M.sortTitle, M.originalTitle, M.released, M.rating, M.votes, M.top250, M.runtime, "
+                  "M.certification, M.director, M.movieSet, M.imdbId, M.tmdbId, M.trailer, M.watched, M.playcount, M.lastPlayed, "
+                  "M.dateAdded, M.hasActors, M.streamDetailsLoaded, MF.file, L.color "
                   "FROM movies M "
                   "LEFT JOIN movieFiles MF ON MF.idMovie=M.idMovie "
                   "LEFT JOIN labels L ON MF.file=L.fileName "
                   "WHERE path=:path "
                   "ORDER BY M.idMovie, MF.file");
     query.bindValue(":path", path.toUtf8());
-    query.exec();
+    exec(query);
 
     QMap<int, Movie*> movies;
-    while (query.next()) {
-        if (!movies.contains(query.value(query.record().indexOf("idMovie")).toInt())) {
-            int label = query.value(query.record().indexOf("color")).toInt();
-            Movie *movie = new Movie(QStringList(), Manager::instance()->movieFileSearcher());
-            movie->setDatabaseId(query.value(query.record().indexOf("idMovie")).toInt());
-            movie->setFileLastModified(query.value(query.record().indexOf("lastModified")).toDateTime());
-            movie->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-            movie->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-            movie->setHasImage(ImageType::MoviePoster, query.value(query.record().indexOf("hasPoster")).toInt() == 1);
-            movie->setHasImage(ImageType::MovieBackdrop, query.value(query.record().indexOf("hasBackdrop")).toInt() == 1);
-            movie->setHasImage(ImageType::MovieLogo, query.value(query.record().indexOf("hasLogo")).toInt() == 1);
-            movie->setHasImage(ImageType::MovieClearArt, query.value(query.record().indexOf("hasClearArt")).toInt() == 1);
-            movie->setHasImage(ImageType::MovieCdArt, query.value(query.record().indexOf("hasCdArt")).toInt() == 1);
-            movie->setHasImage(ImageType::MovieBanner, query.value(query.record().indexOf("hasBanner")).toInt() == 1);
-            movie->setHasImage(ImageType::MovieThumb, query.value(query.record().indexOf("hasThumb")).toInt() == 1);
-            movie->setHasExtraFanarts(query.value(query.record().indexOf("hasExtraFanarts")).toInt() == 1);
-            movie->setDiscType(static_cast<DiscType>(query.value(query.record().indexOf("discType")).toInt()));
-            movie->setLabel(label);
-            movies.insert(query.value(query.record().indexOf("idMovie")).toInt(), movie);
+    DatabaseRow row(query);
+    bool hasRow = row.next();
+    while (hasRow) {
+        Movie *movie = new Movie(QStringList(), Manager::instance()->movieFileSearcher());
+        row.readMovie(movie);
+        QStringList files;
+        while (hasRow && row.toInt(DatabaseRow::ColumnIdMovie) == movie->databaseId()) {
+            if (!row.isNull(DatabaseRow::ColumnFile))
+                files << row.toString(DatabaseRow::ColumnFile);
+            hasRow = row.next();
         }
-
-        QStringList files = movies.value(query.value(query.record().indexOf("idMovie")).toInt())->files();
-        files << query.value(query.record().indexOf("file")).toByteArray();
-        movies.value(query.value(query.record().indexOf("idMovie")).toInt())->setFiles(files);
+        movie->setFiles(files);
+        movies.insert(movie->databaseId(), movie);
     }
 
-    query.prepare("SELECT idMovie, files, language, forced FROM movieSubtitles");
-    query.exec();
-    while (query.next()) {
-        int movieId = query.value(query.record().indexOf("idMovie")).toInt();
-        Movie *movie = movies.value(movieId, 0);
+    query.prepare("SELECT S.idMovie, S.files, S.language, S.forced FROM movieSubtitles S "
+                  "JOIN movies M ON M.idMovie=S.idMovie "
+                  "WHERE M.path=:path");
+    query.bindValue(":path", path.toUtf8());
+    exec(query);
+    DatabaseRow subtitleRow(query);
+    while (subtitleRow.next()) {
+        Movie *movie = movies.value(subtitleRow.toInt(DatabaseRow::ColumnIdMovie), 0);
         if (!movie)
             continue;
         Subtitle *subtitle = new Subtitle(movie);
-        subtitle->setForced(query.value(query.record().indexOf("forced")).toInt() == 1);
-        subtitle->setLanguage(query.value(query.record().indexOf("language")).toString());
-        subtitle->setFiles(query.value(query.record().indexOf("files")).toString().split("%§%"));
+        subtitle->setForced(subtitleRow.toBool(DatabaseRow::ColumnForced));
+        subtitle->setLanguage(subtitleRow.value(DatabaseRow::ColumnLanguage).toString());
+        subtitle->setFiles(subtitleRow.value(DatabaseRow::ColumnFiles).toString().split("%§%"));
         subtitle->setChanged(false);
         movie->addSubtitle(subtitle, true);
     }
 
+    query.prepare("SELECT V.idMovie, V.type, V.value FROM movieValues V "
+                  "JOIN movies M ON M.idMovie=V.idMovie "
+                  "WHERE M.path=:path AND M.cached=1 "
+                  "ORDER BY V.idValue");
+    query.bindValue(":path", path.toUtf8());
+    exec(query);
+    DatabaseRow valueRow(query);
+    while (valueRow.next()) {
+        Movie *movie = movies.value(valueRow.toInt(DatabaseRow::ColumnIdMovie), 0);
+        if (!movie)
+            continue;
+        QString type = valueRow.value(DatabaseRow::ColumnType).toString();
+        QString value = valueRow.toString(DatabaseRow::ColumnValue);
+        movie->blockSignals(true);
+        if (type == "genre")
+            movie->addGenre(value);
+        else if (type == "studio")
+            movie->addStudio(value);
+        else if (type == "country")
+            movie->addCountry(value);
+        else if (type == "tag")
+            movie->addTag(value);
+        movie->setChanged(false);
+        movie->blockSignals(false);
+    }
+
+    query.prepare("SELECT D.idMovie, D.type, D.streamNumber, D.key, D.value FROM movieStreamDetails D "
+                  "JOIN movies M ON M.idMovie=D.idMovie "
+                  "WHERE M.path=:path AND M.cached=1 "
+                  "ORDER BY D.idDetail");
+    query.bindValue(":path", path.toUtf8());
+    exec(query);
+    DatabaseRow detailRow(query);
+    while (detailRow.next()) {
+        Movie *movie = movies.value(detailRow.toInt(DatabaseRow::ColumnIdMovie), 0);
+        if (movie)
+            detailRow.readStreamDetail(movie->streamDetails());
+    }
+
     commit();
 
     return movies.values();
@@ -444,6 +963,16 @@ QList<Movie*> Database::movies(QString path)
 void Database::clearConcerts(QString path)
 {
     QSqlQuery query(db());
+    if (m_hasSearchIndex) {
+        if (!path.isEmpty()) {
+            query.prepare("DELETE FROM concertSearch WHERE rowid IN (SELECT idConcert FROM concerts WHERE path=:path)");
+            query.bindValue(":path", path.toUtf8());
+        } else {
+            query.prepare("DELETE FROM concertSearch");
+        }
+        query.exec();
+        setSearchIndexChanged();
+    }
     if (!path.isEmpty()) {
         query.prepare("DELETE FROM concertFiles WHERE idConcert IN (SELECT idConcert FROM concerts WHERE path=:path)");
         query.bindValue(":path", path.toUtf8());
@@ -465,68 +994,86 @@ void Database::clearConcerts(QString path)
 
 void Database::add(Concert *concert, QString path)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO concerts(content, inSeparateFolder, path) "
-                  "VALUES(:content, :inSeparateFolder, :path)");
+    transaction();
+    QSqlQuery &query = preparedQuery("INSERT INTO concerts(content, inSeparateFolder, path) "
+                                     "VALUES(:content, :inSeparateFolder, :path)");
     query.bindValue(":content", concert->nfoContent().isEmpty() ? "" : concert->nfoContent().toUtf8());
     query.bindValue(":inSeparateFolder", (concert->inSeparateFolder() ? 1 : 0));
     query.bindValue(":path", path.toUtf8());
     query.exec();
     int insertId = query.lastInsertId().toInt();
 
-    foreach (const QString &file, concert->files()) {
-        query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
-        query.bindValue(":idConcert", insertId);
-        query.bindValue(":file", file.toUtf8());
-        query.exec();
-    }
+    addFiles("concertFiles", "idConcert", insertId, concert->files());
     concert->setDatabaseId(insertId);
+    setConcertSearchEntry(concert);
+    commit();
 }
 
 void Database::update(Concert *concert)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE concerts SET content=:content WHERE idConcert=:id");
+    transaction();
+    QSqlQuery &query = preparedQuery("UPDATE concerts SET content=:content WHERE idConcert=:id");
     query.bindValue(":content", concert->nfoContent().isEmpty() ? "" : concert->nfoContent());
     query.bindValue(":id", concert->databaseId());
     query.exec();
 
-    query.prepare("DELETE FROM concertFiles WHERE idConcert=:idConcert");
-    query.bindValue(":idConcert", concert->databaseId());
-    query.exec();
-    foreach (const QString &file, concert->files()) {
-        query.prepare("INSERT INTO concertFiles(idConcert, file) VALUES(:idConcert, :file)");
-        query.bindValue(":idConcert", concert->databaseId());
-        query.bindValue(":file", file.toUtf8());
-        query.exec();
-    }
+    QSqlQuery &deleteQuery = preparedQuery("DELETE FROM concertFiles WHERE idConcert=:idConcert");
+    deleteQuery.bindValue(":idConcert", concert->databaseId());
+    deleteQuery.exec();
+    addFiles("concertFiles", "idConcert", concert->databaseId(), concert->files());
+    setConcertSearchEntry(concert);
+    commit();
 }
 
 QList<Concert*> Database::concerts(QString path)
 {
-    QList<Concert*> concerts;
     QSqlQuery query(db());
-    QSqlQuery queryFiles(db());
-    query.prepare("SELECT idConcert, content, inSeparateFolder FROM concerts WHERE path=:path");
+    query.prepare("SELECT C.idConcert, C.content, C.inSeparateFolder, CF.file "
+                  "FROM concerts C "
+                  "LEFT JOIN concertFiles CF ON CF.idConcert=C.idConcert "
+                  "WHERE C.path=:path "
+                  "ORDER BY C.idConcert, CF.idFile");
     query.bindValue(":path", path.toUtf8());
-    query.exec();
-    while (query.next()) {
+    exec(query);
+
+    QList<Concert*> concerts;
+    DatabaseRow row(query);
+    bool hasRow = row.next();
+    while (hasRow) {
+        Concert *concert = new Concert(QStringList(), Manager::instance()->concertFileSearcher());
+        row.readConcert(concert);
         QStringList files;
-        queryFiles.prepare("SELECT file FROM concertFiles WHERE idConcert=:idConcert");
-        queryFiles.bindValue(":idConcert", query.value(query.record().indexOf("idConcert")).toInt());
-        queryFiles.exec();
-        while (queryFiles.next())
-            files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
-
-        Concert *concert = new Concert(files, Manager::instance()->concertFileSearcher());
-        concert->setDatabaseId(query.value(query.record().indexOf("idConcert")).toInt());
-        concert->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-        concert->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        while (hasRow && row.toInt(DatabaseRow::ColumnIdConcert) == concert->databaseId()) {
+            if (!row.isNull(DatabaseRow::ColumnFile))
+                files << row.toString(DatabaseRow::ColumnFile);
+            hasRow = row.next();
+        }
+        concert->setFiles(files);
         concerts.append(concert);
     }
+
+    if (m_hasSearchIndex) {
+        query.prepare("SELECT idConcert FROM concerts "
+                      "WHERE path=:path AND idConcert NOT IN (SELECT rowid FROM concertSearch)");
+        query.bindValue(":path", path.toUtf8());
+        exec(query);
+        while (query.next())
+            m_concertsWithoutSearchEntry.insert(query.value(0).toInt());
+    }
     return concerts;
 }
 
+/**
+ * @brief Writes the full text search entry of a concert loaded from the database if it has none yet,
+ *        e.g. because it was cached before the search tables existed
+ * @param concert Concert with its infos loaded
+ */
+void Database::addMissingSearchEntry(Concert *concert)
+{
+    if (m_concertsWithoutSearchEntry.remove(concert->databaseId()))
+        setConcertSearchEntry(concert);
+}
+
 void Database::add(TvShow *show, QString path)
 {
     QSqlQuery query(db());
@@ -541,9 +1088,10 @@ void Database::add(TvShow *show, QString path)
     query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
     query.bindValue(":dir", show->dir().toUtf8());
     query.exec();
-    if (query.next()) {
-        show->setShowMissingEpisodes(query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1);
-        show->setHideSpecialsInMissingEpisodes(query.value(query.record().indexOf("hideSpecialsInMissingEpisodes")).toInt() == 1);
+    DatabaseRow row(query);
+    if (row.next()) {
+        show->setShowMissingEpisodes(row.toBool(DatabaseRow::ColumnShowMissingEpisodes));
+        show->setHideSpecialsInMissingEpisodes(row.toBool(DatabaseRow::ColumnHideSpecialsInMissingEpisodes));
     } else {
         query.prepare("INSERT INTO showsSettings(showMissingEpisodes, hideSpecialsInMissingEpisodes, dir, tvdbid, url) VALUES(0, 0, :dir, :tvdbid, :url)");
         query.bindValue(":dir", show->dir().toUtf8());
@@ -605,9 +1153,9 @@ void Database::setHideSpecialsInMissingEpisodes(TvShow *show, bool hideSpecials)
 
 void Database::add(TvShowEpisode *episode, QString path, int idShow)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
-                  "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)");
+    transaction();
+    QSqlQuery &query = preparedQuery("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
+                                     "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)");
     query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent().toUtf8());
     query.bindValue(":idShow", idShow);
     query.bindValue(":path", path.toUtf8());
@@ -615,13 +1163,23 @@ void Database::add(TvShowEpisode *episode, QString path, int idShow)
     query.bindValue(":episodeNumber", episode->episode());
     query.exec();
     int insertId = query.lastInsertId().toInt();
-    foreach (const QString &file, episode->files()) {
-        query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
-        query.bindValue(":idEpisode", insertId);
-        query.bindValue(":file", file.toUtf8());
-        query.exec();
-    }
+    addFiles("episodeFiles", "idEpisode", insertId, episode->files());
     episode->setDatabaseId(insertId);
+    commit();
+}
+
+/**
+ * @brief Adds several episodes of a show within one transaction
+ * @param episodes Episodes to add
+ * @param path Tv show directory the show belongs to
+ * @param idShow Database id of the show
+ */
+void Database::add(QList<TvShowEpisode*> episodes, QString path, int idShow)
+{
+    transaction();
+    foreach (TvShowEpisode *episode, episodes)
+        add(episode, path, idShow);
+    commit();
 }
 
 void Database::update(TvShow *show)
@@ -645,73 +1203,107 @@ void Database::update(TvShow *show)
 
 void Database::update(TvShowEpisode *episode)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE episodes SET content=:content WHERE idEpisode=:id");
+    transaction();
+    QSqlQuery &query = preparedQuery("UPDATE episodes SET content=:content WHERE idEpisode=:id");
     query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent());
     query.bindValue(":id", episode->databaseId());
     query.exec();
 
-    query.prepare("DELETE FROM episodeFiles WHERE idEpisode=:idEpisode");
-    query.bindValue(":idEpisode", episode->databaseId());
-    query.exec();
-
-    foreach (const QString &file, episode->files()) {
-        query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
-        query.bindValue(":idEpisode", episode->databaseId());
-        query.bindValue(":file", file.toUtf8());
-        query.exec();
-    }
+    QSqlQuery &deleteQuery = preparedQuery("DELETE FROM episodeFiles WHERE idEpisode=:idEpisode");
+    deleteQuery.bindValue(":idEpisode", episode->databaseId());
+    deleteQuery.exec();
+    addFiles("episodeFiles", "idEpisode", episode->databaseId(), episode->files());
+    commit();
 }
 
+/**
+ * @brief Loads all shows of a directory together with their settings with a single query
+ * @param path Tv show directory
+ * @return List of shows
+ */
 QList<TvShow*> Database::shows(QString path)
 {
     QList<TvShow*> shows;
     QSqlQuery query(db());
-    query.prepare("SELECT idShow, dir, content, path FROM shows WHERE path=:path");
+    query.prepare("SELECT S.idShow, S.dir, S.content, SS.showMissingEpisodes, SS.hideSpecialsInMissingEpisodes "
+                  "FROM shows S "
+                  "LEFT JOIN showsSettings SS ON SS.dir=S.dir "
+                  "WHERE S.path=:path");
     query.bindValue(":path", path.toUtf8());
-    query.exec();
-    while (query.next()) {
-        TvShow *show = new TvShow(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()), Manager::instance()->tvShowFileSearcher());
-        show->setDatabaseId(query.value(query.record().indexOf("idShow")).toInt());
-        show->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+    exec(query);
+    QSet<int> showIds;
+    DatabaseRow row(query);
+    while (row.next()) {
+        // showsSettings.dir is not unique, only the first settings row of a show is used
+        if (showIds.contains(row.toInt(DatabaseRow::ColumnIdShow)))
+            continue;
+        showIds.insert(row.toInt(DatabaseRow::ColumnIdShow));
+        TvShow *show = new TvShow(row.toString(DatabaseRow::ColumnDir), Manager::instance()->tvShowFileSearcher());
+        row.readTvShow(show);
         shows.append(show);
     }
 
-    foreach (TvShow *show, shows) {
-        query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
-        query.bindValue(":dir", show->dir().toUtf8());
-        query.exec();
-        if (query.next()) {
-            show->setShowMissingEpisodes(query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1, false);
-            show->setHideSpecialsInMissingEpisodes(query.value(query.record().indexOf("hideSpecialsInMissingEpisodes")).toInt() == 1, false);
-        }
-    }
-
     return shows;
 }
 
+/**
+ * @brief Loads the episodes of a show including their files with a single query
+ * @param idShow Database id of the show
+ * @return List of episodes
+ */
 QList<TvShowEpisode*> Database::episodes(int idShow)
 {
-    QList<TvShowEpisode*> episodes;
     QSqlQuery query(db());
-    QSqlQuery queryFiles(db());
-    query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM episodes WHERE idShow=:idShow");
+    query.prepare("SELECT E.idEpisode, E.idShow, E.content, E.seasonNumber, E.episodeNumber, EF.file "
+                  "FROM episodes E "
+                  "LEFT JOIN episodeFiles EF ON EF.idEpisode=E.idEpisode "
+                  "WHERE E.idShow=:idShow "
+                  "ORDER BY E.idEpisode, EF.idFile");
     query.bindValue(":idShow", idShow);
-    query.exec();
-    while (query.next()) {
+    exec(query);
+    return episodesFromQuery(query).value(idShow);
+}
+
+/**
+ * @brief Loads the episodes of all shows of a directory including their files with a single query
+ * @param path Tv show directory
+ * @return Episodes by database id of their show
+ */
+QMap<int, QList<TvShowEpisode*> > Database::episodesOfShows(QString path)
+{
+    QSqlQuery query(db());
+    query.prepare("SELECT E.idEpisode, E.idShow, E.content, E.seasonNumber, E.episodeNumber, EF.file "
+                  "FROM episodes E "
+                  "LEFT JOIN episodeFiles EF ON EF.idEpisode=E.idEpisode "
+                  "WHERE E.path=:path "
+                  "ORDER BY E.idEpisode, EF.idFile");
+    query.bindValue(":path", path.toUtf8());
+    exec(query);
+    return episodesFromQuery(query);
+}
+
+/**
+ * @brief Assembles episodes from the rows of an episode query joined with its files
+ * @param query Executed query, rows of one episode have to be consecutive
+ * @return Episodes by database id of their show
+ */
+QMap<int, QList<TvShowEpisode*> > Database::episodesFromQuery(QSqlQuery &query)
+{
+    QMap<int, QList<TvShowEpisode*> > episodes;
+    DatabaseRow row(query);
+    bool hasRow = row.next();
+    while (hasRow) {
+        TvShowEpisode *episode = new TvShowEpisode();
+        row.readEpisode(episode);
+        int idShow = row.toInt(DatabaseRow::ColumnIdShow);
         QStringList files;
-        queryFiles.prepare("SELECT file FROM episodeFiles WHERE idEpisode=:idEpisode");
-        queryFiles.bindValue(":idEpisode", query.value(query.record().indexOf("idEpisode")).toInt());
-        queryFiles.exec();
-        while (queryFiles.next())
-            files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
-
-        TvShowEpisode *episode = new TvShowEpisode(files);
-        episode->setSeason(query.value(query.record().indexOf("seasonNumber")).toInt());
-        episode->setEpisode(query.value(query.record().indexOf("episodeNumber")).toInt());
-        episode->setDatabaseId(query.value(query.record().indexOf("idEpisode")).toInt());
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-        episodes.append(episode);
+        while (hasRow && row.toInt(DatabaseRow::ColumnIdEpisode) == episode->databaseId()) {
+            if (!row.isNull(DatabaseRow::ColumnFile))
+                files << row.toString(DatabaseRow::ColumnFile);
+            hasRow = row.next();
+        }
+        episode->setFiles(files);
+        episodes[idShow].append(episode);
     }
     return episodes;
 }
@@ -848,19 +1440,91 @@ QList<TvShowEpisode*> Database::showsEpisodes(TvShow *show)
     int id = showsSettingsId(show);
     QList<TvShowEpisode*> episodes;
     QSqlQuery query(db());
-    query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM showsEpisodes WHERE idShow=:idShow");
+    // idEpisode of showsEpisodes is not the database id of an episode, so it's not selected
+    query.prepare("SELECT content, seasonNumber, episodeNumber FROM showsEpisodes WHERE idShow=:idShow");
     query.bindValue(":idShow", id);
-    query.exec();
-    while (query.next()) {
+    exec(query);
+    DatabaseRow row(query);
+    while (row.next()) {
         TvShowEpisode *episode = new TvShowEpisode(QStringList(), show);
-        episode->setSeason(query.value(query.record().indexOf("seasonNumber")).toInt());
-        episode->setEpisode(query.value(query.record().indexOf("episodeNumber")).toInt());
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        row.readEpisode(episode);
         episodes.append(episode);
     }
     return episodes;
 }
 
+/**
+ * @brief Fills stream details from the cache if the file has not changed since they were stored
+ * @param streamDetails Stream details to fill
+ * @param file File the stream details were read from
+ * @param size Current size of the file
+ * @param lastModified Current modification time of the file
+ * @return True if valid stream details were found
+ */
+bool Database::streamDetails(StreamDetails *streamDetails, QString file, qint64 size, QDateTime lastModified)
+{
+    QSqlQuery &query = preparedQuery("SELECT F.idFile, F.size, F.lastModified, C.type, C.streamNumber, C.key, C.value "
+                                     "FROM streamDetailsFiles F "
+                                     "JOIN streamDetailsCache C ON C.idFile=F.idFile "
+                                     "WHERE F.file=:file "
+                                     "ORDER BY C.idDetail");
+    query.bindValue(":file", file.toUtf8());
+    exec(query);
+
+    DatabaseRow row(query);
+    bool found = false;
+    while (row.next()) {
+        if (!found && (row.value(DatabaseRow::ColumnSize).toLongLong() != size || row.value(DatabaseRow::ColumnLastModified).toLongLong() != lastModified.toMSecsSinceEpoch()))
+            break;
+        found = true;
+        row.readStreamDetail(streamDetails);
+    }
+    query.finish();
+    return found;
+}
+
+/**
+ * @brief Size and modification time (msecs since epoch) of all files with cached stream details
+ * @return Size and modification time by file
+ */
+QHash<QString, QPair<qint64, qint64> > Database::streamDetailsFiles()
+{
+    QHash<QString, QPair<qint64, qint64> > files;
+    QSqlQuery query(db());
+    query.prepare("SELECT file, size, lastModified FROM streamDetailsFiles");
+    exec(query);
+    DatabaseRow row(query);
+    while (row.next())
+        files.insert(row.toString(DatabaseRow::ColumnFile), qMakePair(row.value(DatabaseRow::ColumnSize).toLongLong(), row.value(DatabaseRow::ColumnLastModified).toLongLong()));
+    return files;
+}
+
+/**
+ * @brief Stores stream details read from a file, replaces the ones stored before
+ * @param streamDetails Stream details to store
+ * @param file File the stream details were read from
+ * @param size Size of the file
+ * @param lastModified Modification time of the file
+ */
+void Database::setStreamDetails(StreamDetails *streamDetails, QString file, qint64 size, QDateTime lastModified)
+{
+    transaction();
+    QSqlQuery &deleteDetailsQuery = preparedQuery("DELETE FROM streamDetailsCache WHERE idFile IN (SELECT idFile FROM streamDetailsFiles WHERE file=:file)");
+    deleteDetailsQuery.bindValue(":file", file.toUtf8());
+    exec(deleteDetailsQuery);
+    QSqlQuery &deleteFileQuery = preparedQuery("DELETE FROM streamDetailsFiles WHERE file=:file");
+    deleteFileQuery.bindValue(":file", file.toUtf8());
+    exec(deleteFileQuery);
+
+    QSqlQuery &query = preparedQuery("INSERT INTO streamDetailsFiles(file, size, lastModified) VALUES(:file, :size, :lastModified)");
+    query.bindValue(":file", file.toUtf8());
+    query.bindValue(":size", size);
+    query.bindValue(":lastModified", lastModified.toMSecsSinceEpoch());
+    if (exec(query))
+        addStreamDetails("streamDetailsCache", "idFile", query.lastInsertId().toInt(), streamDetails);
+    commit();
+}
+
 void Database::addImport(QString fileName, QString type, QString path)
 {
     int id = 1;
@@ -884,13 +1548,14 @@ bool Database::guessImport(QString fileName, QString &type, QString &path)
 
     QSqlQuery query(db());
     query.prepare("SELECT filename, type, path FROM importCache");
-    query.exec();
-    while (query.next()) {
-        qreal p = Helper::instance()->similarity(fileName, query.value(query.record().indexOf("filename")).toString());
+    exec(query);
+    DatabaseRow row(query);
+    while (row.next()) {
+        qreal p = Helper::instance()->similarity(fileName, row.value(DatabaseRow::ColumnFilename).toString());
         if (p > 0.7 && p > bestMatch) {
             bestMatch = p;
-            type = query.value(query.record().indexOf("type")).toString();
-            path = query.value(query.record().indexOf("path")).toString();
+            type = row.value(DatabaseRow::ColumnType).toString();
+            path = row.value(DatabaseRow::ColumnPath).toString();
         }
     }
 
@@ -911,17 +1576,17 @@ void Database::setLabel(QStringList fileNames, int color)
         query.bindValue(":fileName", fileName.toUtf8());
         query.exec();
         if (query.next()) {
-            int idLabel = query.value(query.record().indexOf("idLabel")).toInt();
-            query.prepare("UPDATE labels SET color=:color WHERE idLabel=:idLabel");
-            query.bindValue(":idLabel", idLabel);
-            query.bindValue(":color", color);
-            query.exec();
+            int idLabel = query.value(0).toInt();
+            QSqlQuery &updateQuery = preparedQuery("UPDATE labels SET color=:color WHERE idLabel=:idLabel");
+            updateQuery.bindValue(":idLabel", idLabel);
+            updateQuery.bindValue(":color", color);
+            updateQuery.exec();
         } else {
-            query.prepare("INSERT INTO labels(idLabel, color, fileName) VALUES(:idLabel, :color, :fileName)");
-            query.bindValue(":idLabel", id);
-            query.bindValue(":color", color);
-            query.bindValue(":fileName", fileName.toUtf8());
-            query.exec();
+            QSqlQuery &insertQuery = preparedQuery("INSERT INTO labels(idLabel, color, fileName) VALUES(:idLabel, :color, :fileName)");
+            insertQuery.bindValue(":idLabel", id);
+            insertQuery.bindValue(":color", color);
+            insertQuery.bindValue(":fileName", fileName.toUtf8());
+            insertQuery.exec();
         }
     }
 }
@@ -936,7 +1601,7 @@ int Database::getLabel(QStringList fileNames)
     query.bindValue(":fileName", fileNames.first().toUtf8());
     query.exec();
     if (query.next())
-        return query.value(query.record().indexOf("color")).toInt();
+        return query.value(0).toInt();
 
     return Labels::NO_LABEL;
 }
@@ -959,9 +1624,8 @@ void Database::clearArtists(QString path)
 
 void Database::add(Artist *artist, QString path)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO artists(content, dir, path) "
-                  "VALUES(:content, :dir, :path)");
+    QSqlQuery &query = preparedQuery("INSERT INTO artists(content, dir, path) "
+                                     "VALUES(:content, :dir, :path)");
     query.bindValue(":content", artist->nfoContent().isEmpty() ? "" : artist->nfoContent().toUtf8());
     query.bindValue(":dir", artist->path().toUtf8());
     query.bindValue(":path", path.toUtf8());
@@ -971,8 +1635,7 @@ void Database::add(Artist *artist, QString path)
 
 void Database::update(Artist *artist)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE artists SET content=:content WHERE idArtist=:id");
+    QSqlQuery &query = preparedQuery("UPDATE artists SET content=:content WHERE idArtist=:id");
     query.bindValue(":content", artist->nfoContent().isEmpty() ? "" : artist->nfoContent());
     query.bindValue(":id", artist->databaseId());
     query.exec();
@@ -984,11 +1647,11 @@ QList<Artist*> Database::artists(QString path)
     QSqlQuery query(db());
     query.prepare("SELECT idArtist, content, dir FROM artists WHERE path=:path");
     query.bindValue(":path", path.toUtf8());
-    query.exec();
-    while (query.next()) {
-        Artist *artist = new Artist(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()), Manager::instance()->musicFileSearcher());
-        artist->setDatabaseId(query.value(query.record().indexOf("idArtist")).toInt());
-        artist->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+    exec(query);
+    DatabaseRow row(query);
+    while (row.next()) {
+        Artist *artist = new Artist(row.toString(DatabaseRow::ColumnDir), Manager::instance()->musicFileSearcher());
+        row.readArtist(artist);
         artists.append(artist);
     }
     return artists;
@@ -1011,9 +1674,8 @@ void Database::clearAlbums(QString path)
 
 void Database::add(Album *album, QString path)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO albums(idArtist, content, dir, path) "
-                  "VALUES(:idArtist, :content, :dir, :path)");
+    QSqlQuery &query = preparedQuery("INSERT INTO albums(idArtist, content, dir, path) "
+                                     "VALUES(:idArtist, :content, :dir, :path)");
     query.bindValue(":idArtist", album->artistObj()->databaseId());
     query.bindValue(":content", album->nfoContent().isEmpty() ? "" : album->nfoContent().toUtf8());
     query.bindValue(":dir", album->path().toUtf8());
@@ -1024,8 +1686,7 @@ void Database::add(Album *album, QString path)
 
 void Database::update(Album *album)
 {
-    QSqlQuery query(db());
-    query.prepare("UPDATE albums SET content=:content WHERE idAlbum=:id");
+    QSqlQuery &query = preparedQuery("UPDATE albums SET content=:content WHERE idAlbum=:id");
     query.bindValue(":content", album->nfoContent().isEmpty() ? "" : album->nfoContent());
     query.bindValue(":id", album->databaseId());
     query.exec();
@@ -1037,14 +1698,195 @@ QList<Album*> Database::albums(Artist *artist)
     QSqlQuery query(db());
     query.prepare("SELECT idAlbum, content, dir FROM albums WHERE idArtist=:idArtist");
     query.bindValue(":idArtist", artist->databaseId());
-    query.exec();
-    while (query.next()) {
-        Album *album = new Album(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()), Manager::instance()->musicFileSearcher());
-        album->setDatabaseId(query.value(query.record().indexOf("idAlbum")).toInt());
-        album->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+    exec(query);
+    DatabaseRow row(query);
+    while (row.next()) {
+        Album *album = new Album(row.toString(DatabaseRow::ColumnDir), Manager::instance()->musicFileSearcher());
+        row.readAlbum(album);
         album->setArtistObj(artist);
         artist->addAlbum(album);
         albums.append(album);
     }
     return albums;
 }
+
+/**
+ * @brief Creates a full text search table, FTS5 is preferred over FTS4
+ *        Both tokenize with diacritics removed and keep prefix indexes for search as you type.
+ * @param table Name of the table
+ * @return True if the table was created
+ */
+bool Database::createSearchTable(const QString &table)
+{
+    QStringList statements;
+    statements << "CREATE VIRTUAL TABLE %1 USING fts5(title, plot, people, tags, path, "
+                  "tokenize='unicode61 remove_diacritics 2', prefix='2 3');"
+               << "CREATE VIRTUAL TABLE %1 USING fts5(title, plot, people, tags, path, "
+                  "tokenize='unicode61 remove_diacritics 1', prefix='2 3');"
+               << "CREATE VIRTUAL TABLE %1 USING fts4(title, plot, people, tags, path, "
+                  "tokenize=unicode61 \"remove_diacritics=1\", prefix=\"2,3\");";
+
+    QSqlQuery query(*m_db);
+    foreach (const QString &statement, statements) {
+        if (query.exec(statement.arg(table)))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Writes the full text search entry of an item
+ * @param table Full text search table (movieSearch, concertSearch)
+ * @param id Database id of the item
+ * @param columns Title, plot, people, tags and path
+ */
+void Database::setSearchEntry(const QString &table, int id, const QStringList &columns)
+{
+    if (!m_hasSearchIndex || id <= 0)
+        return;
+
+    removeSearchEntry(table, id);
+    QSqlQuery &query = preparedQuery(QString("INSERT INTO %1(rowid, title, plot, people, tags, path) "
+                                             "VALUES(:id, :title, :plot, :people, :tags, :path)").arg(table));
+    query.bindValue(":id", id);
+    query.bindValue(":title", columns.value(0));
+    query.bindValue(":plot", columns.value(1));
+    query.bindValue(":people", columns.value(2));
+    query.bindValue(":tags", columns.value(3));
+    query.bindValue(":path", columns.value(4));
+    query.exec();
+}
+
+/**
+ * @brief Removes the full text search entry of an item
+ * @param table Full text search table (movieSearch, concertSearch)
+ * @param id Database id of the item
+ */
+void Database::removeSearchEntry(const QString &table, int id)
+{
+    if (!m_hasSearchIndex || id <= 0)
+        return;
+
+    QSqlQuery &query = preparedQuery(QString("DELETE FROM %1 WHERE rowid=:id").arg(table));
+    query.bindValue(":id", id);
+    query.exec();
+    setSearchIndexChanged();
+}
+
+/**
+ * @brief Increases the search revision, within a transaction this is done on commit
+ * @see Database::searchRevision
+ */
+void Database::setSearchIndexChanged()
+{
+    if (m_transactionDepth > 0)
+        m_searchIndexChanged = true;
+    else
+        m_searchRevision++;
+}
+
+/**
+ * @brief Writes the full text search entry of a movie
+ *        Movies restored from the cache don't hold their plot and actors, their entry is kept.
+ * @param movie Movie with a valid database id
+ */
+void Database::setMovieSearchEntry(Movie *movie)
+{
+    if (movie->controller()->infoFromCache())
+        return;
+
+    QStringList people;
+    foreach (const Actor &actor, movie->actors())
+        people << actor.name << actor.role;
+    people << movie->director() << movie->writer();
+
+    QStringList tags;
+    tags << movie->genres() << movie->tags() << movie->studios() << movie->countries() << movie->set();
+
+    QStringList columns;
+    columns << QStringList(QStringList() << movie->name() << movie->originalName() << movie->sortTitle()).join(" ")
+            << QStringList(QStringList() << movie->tagline() << movie->overview() << movie->outline()).join(" ")
+            << people.join(" ")
+            << tags.join(" ")
+            << movie->files().join(" ");
+    setSearchEntry("movieSearch", movie->databaseId(), columns);
+}
+
+/**
+ * @brief Writes the full text search entry of a concert
+ * @param concert Concert with a valid database id
+ */
+void Database::setConcertSearchEntry(Concert *concert)
+{
+    QStringList tags;
+    tags << concert->genres() << concert->tags();
+
+    QStringList columns;
+    columns << QStringList(QStringList() << concert->name() << concert->artist() << concert->album()).join(" ")
+            << concert->overview()
+            << concert->artist()
+            << tags.join(" ")
+            << concert->files().join(" ");
+    setSearchEntry("concertSearch", concert->databaseId(), columns);
+}
+
+/**
+ * @brief Checks if the full text search tables are available
+ * @return True if searchMovies and searchConcerts can be used
+ */
+bool Database::hasSearchIndex() const
+{
+    return m_hasSearchIndex;
+}
+
+/**
+ * @brief The search revision is increased each time full text search entries were written or removed
+ * @return Search revision
+ */
+int Database::searchRevision() const
+{
+    return m_searchRevision;
+}
+
+/**
+ * @brief Searches movies by title, plot, actors, director, genres, tags and file names
+ * @param text Text to search, each word matches as a prefix
+ * @return Database ids of the matching movies
+ */
+QSet<int> Database::searchMovies(const QString &text)
+{
+    return search("movieSearch", text);
+}
+
+/**
+ * @brief Searches concerts by title, artist, album, plot, genres, tags and file names
+ * @param text Text to search, each word matches as a prefix
+ * @return Database ids of the matching concerts
+ */
+QSet<int> Database::searchConcerts(const QString &text)
+{
+    return search("concertSearch", text);
+}
+
+QSet<int> Database::search(const QString &table, const QString &text)
+{
+    QSet<int> ids;
+    if (!m_hasSearchIndex)
+        return ids;
+
+    // Each word becomes a prefix term, the terms are combined with AND.
+    // Words are lowered so they can't be taken for the operators AND, OR and NOT.
+    QStringList terms;
+    foreach (const QString &word, text.split(QRegExp("[\\W_]+"), QString::SkipEmptyParts))
+        terms << word.toLower() + "*";
+    if (terms.isEmpty())
+        return ids;
+
+    QSqlQuery &query = preparedQuery(QString("SELECT rowid FROM %1 WHERE %1 MATCH :query").arg(table));
+    query.bindValue(":query", terms.join(" "));
+    if (!exec(query))
+        return ids;
+    while (query.next())
+        ids.insert(query.value(0).toInt());
+    return ids;
+}
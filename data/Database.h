@@ -2,8 +2,11 @@
 #define DATABASE_H
 
 #include <QDateTime>
+#include <QHash>
+#include <QSet>
 #include <QObject>
 #include <QSqlDatabase>
+#include <QSqlQuery>
 #include "data/Concert.h"
 #include "movies/Movie.h"
 #include "data/TvShow.h"
@@ -19,10 +22,16 @@ public:
     QSqlDatabase db();
     void transaction();
     void commit();
+    int queryCount() const;
+    void resetQueryCount();
     void clearMovies(QString path = "");
     void add(Movie *movie, QString path);
     void update(Movie *movie);
+    void remove(Movie *movie);
     QList<Movie*> movies(QString path);
+    void clearMovieFolders(QString path = "");
+    void setMovieFolders(QString path, QHash<QString, qint64> folders);
+    QHash<QString, qint64> movieFolders(QString path);
 
     void clearConcerts(QString path = "");
     void add(Concert *concert, QString path);
@@ -31,12 +40,14 @@ public:
 
     void add(TvShow *show, QString path);
     void add(TvShowEpisode *episode, QString path, int idShow);
+    void add(QList<TvShowEpisode*> episodes, QString path, int idShow);
     void update(TvShow *show);
     void update(TvShowEpisode *episode);
     void clearTvShows(QString path = "");
     void clearTvShow(QString showDir);
     QList<TvShow*> shows(QString path);
     QList<TvShowEpisode*> episodes(int idShow);
+    QMap<int, QList<TvShowEpisode*> > episodesOfShows(QString path);
     int episodeCount();
 
     void setShowMissingEpisodes(TvShow *show, bool showMissing);
@@ -57,15 +68,46 @@ public:
     void update(Album *album);
     QList<Album*> albums(Artist *artist);
 
+    bool streamDetails(StreamDetails *streamDetails, QString file, qint64 size, QDateTime lastModified);
+    void setStreamDetails(StreamDetails *streamDetails, QString file, qint64 size, QDateTime lastModified);
+    QHash<QString, QPair<qint64, qint64> > streamDetailsFiles();
+
     void addImport(QString fileName, QString type, QString path);
     bool guessImport(QString fileName, QString &type, QString &path);
 
     void setLabel(QStringList fileNames, int color);
     int getLabel(QStringList fileNames);
 
+    bool hasSearchIndex() const;
+    void addMissingSearchEntry(Concert *concert);
+    int searchRevision() const;
+    QSet<int> searchMovies(const QString &text);
+    QSet<int> searchConcerts(const QString &text);
+
 private:
     QSqlDatabase *m_db;
+    QHash<QString, QSqlQuery*> m_preparedQueries;
+    int m_transactionDepth;
+    int m_queryCount;
+    bool m_hasSearchIndex;
+    bool m_searchIndexChanged;
+    int m_searchRevision;
+    QSet<int> m_concertsWithoutSearchEntry;
     void updateDbVersion(int version);
+    bool exec(QSqlQuery &query);
+    QSqlQuery &preparedQuery(const QString &statement);
+    void addFiles(const QString &table, const QString &idColumn, int id, const QStringList &files);
+    void setMovieSubtitles(Movie *movie);
+    void setMovieDetails(Movie *movie);
+    void addStreamDetails(const QString &table, const QString &idColumn, int id, StreamDetails *streamDetails);
+    QMap<int, QList<TvShowEpisode*> > episodesFromQuery(QSqlQuery &query);
+    bool createSearchTable(const QString &table);
+    void setSearchEntry(const QString &table, int id, const QStringList &columns);
+    void removeSearchEntry(const QString &table, int id);
+    void setSearchIndexChanged();
+    void setMovieSearchEntry(Movie *movie);
+    void setConcertSearchEntry(Concert *concert);
+    QSet<int> search(const QString &table, const QString &text);
 };
 
 #endif // DATABASE_H
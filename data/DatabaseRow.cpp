@@ -0,0 +1,296 @@
+#include "DatabaseRow.h"
+
+#include <QSqlRecord>
+#include <QUrl>
+#include "data/Concert.h"
+#include "data/StreamDetails.h"
+#include "data/TvShow.h"
+#include "data/TvShowEpisode.h"
+#include "movies/Movie.h"
+#include "music/Album.h"
+#include "music/Artist.h"
+
+/**
+ * @brief DatabaseRow::DatabaseRow
+ * @param query Executed query
+ */
+DatabaseRow::DatabaseRow(QSqlQuery &query) :
+    m_query(query)
+{
+}
+
+/**
+ * @brief Moves to the next row of the query, the column indices are resolved on the first row
+ * @return False if there are no more rows
+ */
+bool DatabaseRow::next()
+{
+    if (!m_query.next())
+        return false;
+    if (m_columns.isEmpty())
+        resolveColumns();
+    return true;
+}
+
+/**
+ * @brief Looks up the index of every known column in the record of the query
+ * Columns which are not part of the query get the index -1.
+ */
+void DatabaseRow::resolveColumns()
+{
+    static const char *columnNames[ColumnCount] = {
+        "cached",
+        "certification",
+        "color",
+        "content",
+        "dateAdded",
+        "dir",
+        "director",
+        "discType",
+        "episodeNumber",
+        "file",
+        "filename",
+        "files",
+        "forced",
+        "hasActors",
+        "hasBackdrop",
+        "hasBanner",
+        "hasCdArt",
+        "hasClearArt",
+        "hasExtraFanarts",
+        "hasLogo",
+        "hasPoster",
+        "hasThumb",
+        "hideSpecialsInMissingEpisodes",
+        "idAlbum",
+        "idArtist",
+        "idConcert",
+        "idEpisode",
+        "idMovie",
+        "idShow",
+        "imdbId",
+        "inSeparateFolder",
+        "infoLoaded",
+        "key",
+        "language",
+        "lastModified",
+        "lastPlayed",
+        "movieSet",
+        "originalTitle",
+        "path",
+        "playcount",
+        "rating",
+        "released",
+        "runtime",
+        "seasonNumber",
+        "showMissingEpisodes",
+        "size",
+        "sortTitle",
+        "streamDetailsLoaded",
+        "streamNumber",
+        "title",
+        "tmdbId",
+        "top250",
+        "trailer",
+        "type",
+        "value",
+        "votes",
+        "watched"
+    };
+
+    QSqlRecord record = m_query.record();
+    m_columns.resize(ColumnCount);
+    for (int i=0 ; i<ColumnCount ; ++i)
+        m_columns[i] = record.indexOf(QLatin1String(columnNames[i]));
+}
+
+bool DatabaseRow::hasColumn(Column column) const
+{
+    return m_columns.value(column, -1) != -1;
+}
+
+QVariant DatabaseRow::value(Column column) const
+{
+    int index = m_columns.value(column, -1);
+    if (index == -1)
+        return QVariant();
+    return m_query.value(index);
+}
+
+bool DatabaseRow::isNull(Column column) const
+{
+    return value(column).isNull();
+}
+
+int DatabaseRow::toInt(Column column) const
+{
+    return value(column).toInt();
+}
+
+/**
+ * @brief Reads an integer column holding a flag (0 or 1)
+ * @param column Column name
+ * @return True if the column is 1
+ */
+bool DatabaseRow::toBool(Column column) const
+{
+    return value(column).toInt() == 1;
+}
+
+qreal DatabaseRow::toReal(Column column) const
+{
+    return value(column).toReal();
+}
+
+/**
+ * @brief Reads a text column, strings are stored utf8 encoded
+ * @param column Column name
+ * @return Decoded string
+ */
+QString DatabaseRow::toString(Column column) const
+{
+    return QString::fromUtf8(value(column).toByteArray());
+}
+
+QDateTime DatabaseRow::toDateTime(Column column) const
+{
+    return value(column).toDateTime();
+}
+
+/**
+ * @brief Fills a movie from the columns of the movies table
+ * The cached columns are only applied if the row was marked as cached.
+ * @param movie Movie to fill
+ */
+void DatabaseRow::readMovie(Movie *movie) const
+{
+    movie->blockSignals(true);
+    movie->setDatabaseId(toInt(ColumnIdMovie));
+    if (hasColumn(ColumnLastModified))
+        movie->setFileLastModified(toDateTime(ColumnLastModified));
+    if (hasColumn(ColumnInSeparateFolder))
+        movie->setInSeparateFolder(toBool(ColumnInSeparateFolder));
+    if (hasColumn(ColumnContent))
+        movie->setNfoContent(toString(ColumnContent));
+    if (hasColumn(ColumnHasPoster)) {
+        movie->setHasImage(ImageType::MoviePoster, toBool(ColumnHasPoster));
+        movie->setHasImage(ImageType::MovieBackdrop, toBool(ColumnHasBackdrop));
+        movie->setHasImage(ImageType::MovieLogo, toBool(ColumnHasLogo));
+        movie->setHasImage(ImageType::MovieClearArt, toBool(ColumnHasClearArt));
+        movie->setHasImage(ImageType::MovieCdArt, toBool(ColumnHasCdArt));
+        movie->setHasImage(ImageType::MovieBanner, toBool(ColumnHasBanner));
+        movie->setHasImage(ImageType::MovieThumb, toBool(ColumnHasThumb));
+        movie->setHasExtraFanarts(toBool(ColumnHasExtraFanarts));
+    }
+    if (hasColumn(ColumnDiscType))
+        movie->setDiscType(static_cast<DiscType>(toInt(ColumnDiscType)));
+    if (hasColumn(ColumnColor))
+        movie->setLabel(toInt(ColumnColor));
+
+    if (toBool(ColumnCached)) {
+        movie->setName(toString(ColumnTitle));
+        movie->setSortTitle(toString(ColumnSortTitle));
+        movie->setOriginalName(toString(ColumnOriginalTitle));
+        movie->setReleased(QDate::fromString(value(ColumnReleased).toString(), Qt::ISODate));
+        movie->setRating(toReal(ColumnRating));
+        movie->setVotes(toInt(ColumnVotes));
+        movie->setTop250(toInt(ColumnTop250));
+        movie->setRuntime(toInt(ColumnRuntime));
+        movie->setCertification(toString(ColumnCertification));
+        movie->setDirector(toString(ColumnDirector));
+        movie->setSet(toString(ColumnMovieSet));
+        movie->setId(toString(ColumnImdbId));
+        movie->setTmdbId(toString(ColumnTmdbId));
+        movie->setTrailer(QUrl(toString(ColumnTrailer)));
+        movie->setPlayCount(toInt(ColumnPlaycount));
+        movie->setWatched(toBool(ColumnWatched));
+        movie->setLastPlayed(toDateTime(ColumnLastPlayed));
+        movie->setDateAdded(toDateTime(ColumnDateAdded));
+        movie->setHasActors(toBool(ColumnHasActors));
+        movie->setStreamDetailsLoaded(toBool(ColumnStreamDetailsLoaded));
+        movie->controller()->setInfoFromCache(toBool(ColumnInfoLoaded));
+    }
+    movie->setChanged(false);
+    movie->blockSignals(false);
+}
+
+/**
+ * @brief Fills a concert from the columns of the concerts table
+ * @param concert Concert to fill
+ */
+void DatabaseRow::readConcert(Concert *concert) const
+{
+    concert->setDatabaseId(toInt(ColumnIdConcert));
+    if (hasColumn(ColumnInSeparateFolder))
+        concert->setInSeparateFolder(toBool(ColumnInSeparateFolder));
+    if (hasColumn(ColumnContent))
+        concert->setNfoContent(toString(ColumnContent));
+}
+
+/**
+ * @brief Fills a tv show from the columns of the shows table and the joined show settings
+ * @param show Tv show to fill
+ */
+void DatabaseRow::readTvShow(TvShow *show) const
+{
+    show->setDatabaseId(toInt(ColumnIdShow));
+    if (hasColumn(ColumnContent))
+        show->setNfoContent(toString(ColumnContent));
+    if (hasColumn(ColumnShowMissingEpisodes) && !isNull(ColumnShowMissingEpisodes)) {
+        show->setShowMissingEpisodes(toBool(ColumnShowMissingEpisodes), false);
+        show->setHideSpecialsInMissingEpisodes(toBool(ColumnHideSpecialsInMissingEpisodes), false);
+    }
+}
+
+/**
+ * @brief Fills an episode from the columns of the episodes or showsEpisodes table
+ * @param episode Episode to fill
+ */
+void DatabaseRow::readEpisode(TvShowEpisode *episode) const
+{
+    if (hasColumn(ColumnIdEpisode))
+        episode->setDatabaseId(toInt(ColumnIdEpisode));
+    episode->setSeason(toInt(ColumnSeasonNumber));
+    episode->setEpisode(toInt(ColumnEpisodeNumber));
+    if (hasColumn(ColumnContent))
+        episode->setNfoContent(toString(ColumnContent));
+}
+
+/**
+ * @brief Fills an artist from the columns of the artists table
+ * @param artist Artist to fill
+ */
+void DatabaseRow::readArtist(Artist *artist) const
+{
+    artist->setDatabaseId(toInt(ColumnIdArtist));
+    if (hasColumn(ColumnContent))
+        artist->setNfoContent(toString(ColumnContent));
+}
+
+/**
+ * @brief Fills an album from the columns of the albums table
+ * @param album Album to fill
+ */
+void DatabaseRow::readAlbum(Album *album) const
+{
+    album->setDatabaseId(toInt(ColumnIdAlbum));
+    if (hasColumn(ColumnContent))
+        album->setNfoContent(toString(ColumnContent));
+}
+
+/**
+ * @brief Adds one detail (type, streamNumber, key and value columns) to stream details
+ * @param streamDetails Stream details to fill
+ */
+void DatabaseRow::readStreamDetail(StreamDetails *streamDetails) const
+{
+    QString type = value(ColumnType).toString();
+    int streamNumber = toInt(ColumnStreamNumber);
+    QString key = value(ColumnKey).toString();
+    if (type == "video")
+        streamDetails->setVideoDetail(key, toString(ColumnValue));
+    else if (type == "audio")
+        streamDetails->setAudioDetail(streamNumber, key, toString(ColumnValue));
+    else if (type == "subtitle")
+        streamDetails->setSubtitleDetail(streamNumber, key, toString(ColumnValue));
+}
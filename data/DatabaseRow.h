@@ -0,0 +1,115 @@
+#ifndef DATABASEROW_H
+#define DATABASEROW_H
+
+#include <QDateTime>
+#include <QSqlQuery>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+class Album;
+class Artist;
+class Concert;
+class Movie;
+class StreamDetails;
+class TvShow;
+class TvShowEpisode;
+
+/**
+ * @brief The DatabaseRow class
+ * Typed access to the current row of an executed query. The indices of all known columns
+ * are resolved once when the first row is read, values are then read by index without
+ * building a QSqlRecord or looking up a column name for every value.
+ * Columns which are not part of the query are skipped by the read* functions.
+ */
+class DatabaseRow
+{
+public:
+    // Keep in the same order as the column names in DatabaseRow::resolveColumns
+    enum Column {
+        ColumnCached = 0,
+        ColumnCertification,
+        ColumnColor,
+        ColumnContent,
+        ColumnDateAdded,
+        ColumnDir,
+        ColumnDirector,
+        ColumnDiscType,
+        ColumnEpisodeNumber,
+        ColumnFile,
+        ColumnFilename,
+        ColumnFiles,
+        ColumnForced,
+        ColumnHasActors,
+        ColumnHasBackdrop,
+        ColumnHasBanner,
+        ColumnHasCdArt,
+        ColumnHasClearArt,
+        ColumnHasExtraFanarts,
+        ColumnHasLogo,
+        ColumnHasPoster,
+        ColumnHasThumb,
+        ColumnHideSpecialsInMissingEpisodes,
+        ColumnIdAlbum,
+        ColumnIdArtist,
+        ColumnIdConcert,
+        ColumnIdEpisode,
+        ColumnIdMovie,
+        ColumnIdShow,
+        ColumnImdbId,
+        ColumnInSeparateFolder,
+        ColumnInfoLoaded,
+        ColumnKey,
+        ColumnLanguage,
+        ColumnLastModified,
+        ColumnLastPlayed,
+        ColumnMovieSet,
+        ColumnOriginalTitle,
+        ColumnPath,
+        ColumnPlaycount,
+        ColumnRating,
+        ColumnReleased,
+        ColumnRuntime,
+        ColumnSeasonNumber,
+        ColumnShowMissingEpisodes,
+        ColumnSize,
+        ColumnSortTitle,
+        ColumnStreamDetailsLoaded,
+        ColumnStreamNumber,
+        ColumnTitle,
+        ColumnTmdbId,
+        ColumnTop250,
+        ColumnTrailer,
+        ColumnType,
+        ColumnValue,
+        ColumnVotes,
+        ColumnWatched,
+        ColumnCount
+    };
+    explicit DatabaseRow(QSqlQuery &query);
+    bool next();
+    bool hasColumn(Column column) const;
+    QVariant value(Column column) const;
+    bool isNull(Column column) const;
+    int toInt(Column column) const;
+    bool toBool(Column column) const;
+    qreal toReal(Column column) const;
+    QString toString(Column column) const;
+    QDateTime toDateTime(Column column) const;
+
+    void readMovie(Movie *movie) const;
+    void readConcert(Concert *concert) const;
+    void readTvShow(TvShow *show) const;
+    void readEpisode(TvShowEpisode *episode) const;
+    void readArtist(Artist *artist) const;
+    void readAlbum(Album *album) const;
+    void readStreamDetail(StreamDetails *streamDetails) const;
+
+private:
+    QSqlQuery &m_query;
+    QVector<int> m_columns;
+
+    void resolveColumns();
+};
+
+#endif // DATABASEROW_H
@@ -0,0 +1,204 @@
+#include "DirectoryWalker.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QMutexLocker>
+#include <QRunnable>
+#include "globals/Helper.h"
+#include "settings/Settings.h"
+
+/**
+ * @brief The DirectoryWalkerJob class
+ * Lists a single folder in the thread pool of a DirectoryWalker
+ */
+class DirectoryWalkerJob : public QRunnable
+{
+public:
+    DirectoryWalkerJob(DirectoryWalker *walker, DirectoryWalker::Job job) :
+        m_walker(walker),
+        m_job(job)
+    {
+    }
+    void run()
+    {
+        m_walker->run(m_job);
+    }
+
+private:
+    DirectoryWalker *m_walker;
+    DirectoryWalker::Job m_job;
+};
+
+/**
+ * @brief DirectoryWalker::DirectoryWalker
+ * @param nameFilters Filters for the files to list, subfolders are always listed
+ * @param parent
+ */
+DirectoryWalker::DirectoryWalker(QStringList nameFilters, QObject *parent) :
+    QObject(parent),
+    m_nameFilters(nameFilters),
+    m_detectDiscs(false),
+    m_jobs(Settings::instance()->advanced()->scanThreadsPerMount()),
+    m_outstanding(0),
+    m_aborted(false)
+{
+}
+
+/**
+ * @brief DirectoryWalker::~DirectoryWalker
+ */
+DirectoryWalker::~DirectoryWalker()
+{
+    abort();
+    m_jobs.waitForDone();
+}
+
+/**
+ * @brief When set, listings of folders containing a DVD or BluRay structure get the corresponding disc type
+ * @param detect Detect disc structures
+ */
+void DirectoryWalker::setDetectDiscs(bool detect)
+{
+    m_detectDiscs = detect;
+}
+
+/**
+ * @brief Adds a folder to the list of folders to walk
+ * @param path Folder to list
+ * @param root Identifies the directory the folder belongs to, folders of the same root share their mount
+ * @param lastModified When this equals the current modification time, the folder is not listed again
+ */
+void DirectoryWalker::enqueue(QString path, int root, qint64 lastModified)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_aborted)
+        return;
+
+    if (!m_rootMounts.contains(root))
+        m_rootMounts.insert(root, Helper::instance()->mountOf(path));
+
+    Job job;
+    job.path = path;
+    job.mount = m_rootMounts.value(root);
+    job.root = root;
+    job.lastModified = lastModified;
+    m_jobs.enqueue(job.mount, new DirectoryWalkerJob(this, job));
+    m_outstanding++;
+}
+
+/**
+ * @brief Waits for the next listed folder
+ * Events are processed while waiting.
+ * @param listing Listing of the next folder
+ * @return False when all folders have been walked or the walker was aborted
+ */
+bool DirectoryWalker::next(Listing &listing)
+{
+    m_mutex.lock();
+    while (!m_aborted && m_listings.isEmpty() && m_outstanding > 0) {
+        m_listingAvailable.wait(&m_mutex, 100);
+        if (m_listings.isEmpty()) {
+            m_mutex.unlock();
+            QCoreApplication::processEvents();
+            m_mutex.lock();
+        }
+    }
+
+    if (m_aborted || m_listings.isEmpty()) {
+        m_mutex.unlock();
+        return false;
+    }
+
+    listing = m_listings.dequeue();
+    m_outstanding--;
+    m_mutex.unlock();
+    return true;
+}
+
+/**
+ * @brief Stops walking, running listings are finished but not reported
+ */
+void DirectoryWalker::abort()
+{
+    QMutexLocker locker(&m_mutex);
+    m_aborted = true;
+    m_jobs.clear();
+    m_listings.clear();
+    m_outstanding = 0;
+    m_listingAvailable.wakeAll();
+}
+
+/**
+ * @brief Lists a folder and hands the result to the consumer. Runs in the thread pool.
+ * @param job Folder to list
+ */
+void DirectoryWalker::run(Job job)
+{
+    Listing listing;
+    bool valid = list(job, listing);
+
+    QMutexLocker locker(&m_mutex);
+    m_jobs.finish(job.mount);
+    if (m_aborted)
+        return;
+    if (valid)
+        m_listings.enqueue(listing);
+    else
+        m_outstanding--;
+    m_listingAvailable.wakeAll();
+}
+
+/**
+ * @brief Lists subfolders and matching files of a folder
+ * Symlinks pointing to an already visited target are skipped to avoid loops.
+ * @param job Folder to list
+ * @param listing Result
+ * @return False if the folder doesn't exist or was already visited
+ */
+bool DirectoryWalker::list(const Job &job, Listing &listing)
+{
+    QFileInfo fi(job.path);
+    if (!fi.isDir())
+        return false;
+
+    if (fi.isSymLink()) {
+        QString target = fi.canonicalFilePath();
+        QMutexLocker locker(&m_mutex);
+        if (m_visitedLinks.contains(target))
+            return false;
+        m_visitedLinks.insert(target);
+    }
+
+    listing.path = job.path;
+    listing.root = job.root;
+    listing.lastModified = fi.lastModified().toMSecsSinceEpoch();
+    listing.listed = (job.lastModified == -1 || job.lastModified != listing.lastModified);
+    listing.discType = DiscSingle;
+    if (!listing.listed)
+        return true;
+
+    QDir dir(job.path);
+    listing.dirs = dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    if (!m_nameFilters.isEmpty())
+        listing.files = dir.entryInfoList(m_nameFilters, QDir::Files | QDir::System);
+
+    // Fetch the modification times here, so the consumer doesn't have to wait for the file system
+    foreach (const QFileInfo &file, listing.files)
+        file.lastModified();
+
+    if (m_detectDiscs) {
+        foreach (const QFileInfo &subDir, listing.dirs) {
+            if (QString::compare(subDir.fileName(), "VIDEO_TS", Qt::CaseInsensitive) == 0 ||
+                QString::compare(subDir.fileName(), "VIDEO TS", Qt::CaseInsensitive) == 0) {
+                if (Helper::instance()->isDvd(job.path))
+                    listing.discType = DiscDvd;
+            } else if (QString::compare(subDir.fileName(), "BDMV", Qt::CaseInsensitive) == 0) {
+                if (Helper::instance()->isBluRay(job.path))
+                    listing.discType = DiscBluRay;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,68 @@
+#ifndef DIRECTORYWALKER_H
+#define DIRECTORYWALKER_H
+
+#include <QFileInfoList>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QStringList>
+#include <QWaitCondition>
+
+#include "data/MountJobQueue.h"
+#include "globals/Globals.h"
+
+/**
+ * @brief The DirectoryWalker class
+ * Lists folders of several directories in parallel. Folders are listed by a thread pool,
+ * at most a configurable number of folders per mount at a time, so that roots on
+ * different mounts don't wait for each other. The listings are streamed back to the caller
+ * which decides which subfolders are walked next.
+ */
+class DirectoryWalker : public QObject
+{
+    Q_OBJECT
+public:
+    struct Listing {
+        QString path;
+        int root;
+        qint64 lastModified;
+        bool listed;
+        DiscType discType;
+        QFileInfoList dirs;
+        QFileInfoList files;
+    };
+
+    explicit DirectoryWalker(QStringList nameFilters, QObject *parent = 0);
+    ~DirectoryWalker();
+    void setDetectDiscs(bool detect);
+    void enqueue(QString path, int root, qint64 lastModified = -1);
+    bool next(Listing &listing);
+    void abort();
+
+private:
+    struct Job {
+        QString path;
+        QString mount;
+        int root;
+        qint64 lastModified;
+    };
+    friend class DirectoryWalkerJob;
+
+    QStringList m_nameFilters;
+    bool m_detectDiscs;
+    MountJobQueue m_jobs;
+    QMutex m_mutex;
+    QWaitCondition m_listingAvailable;
+    QHash<int, QString> m_rootMounts;
+    QQueue<Listing> m_listings;
+    QSet<QString> m_visitedLinks;
+    int m_outstanding;
+    bool m_aborted;
+
+    void run(Job job);
+    bool list(const Job &job, Listing &listing);
+};
+
+#endif // DIRECTORYWALKER_H
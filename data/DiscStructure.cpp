@@ -0,0 +1,205 @@
+#include "DiscStructure.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+QMutex DiscStructure::m_mutex;
+QHash<QString, DiscStructure::CachedTitle> DiscStructure::m_cache;
+
+/**
+ * @brief Holds if the file is the entry point of a DVD or BluRay structure
+ * @param file File of an item
+ * @return True if it's a VIDEO_TS.IFO or index.bdmv
+ */
+bool DiscStructure::isDisc(const QString &file)
+{
+    return file.endsWith("VIDEO_TS.IFO", Qt::CaseInsensitive) || file.endsWith("index.bdmv", Qt::CaseInsensitive);
+}
+
+/**
+ * @brief Returns the file of the main title which should be read by MediaInfo
+ * @param file VIDEO_TS.IFO or index.bdmv
+ * @return Main title, the file is the given one and the duration 0 if it could not be found
+ */
+DiscStructure::Title DiscStructure::mainTitle(const QString &file)
+{
+    Title title;
+    title.file = file;
+    title.durationInSeconds = 0;
+    if (!isDisc(file))
+        return title;
+
+    // Title sets and playlists are only added or removed when the folder is modified
+    QFileInfo fi(file);
+    QString dir = fi.absolutePath();
+    bool bluRay = file.endsWith("index.bdmv", Qt::CaseInsensitive);
+    QDateTime lastModified = QFileInfo(bluRay ? dir + "/PLAYLIST" : dir).lastModified();
+
+    QMutexLocker locker(&m_mutex);
+    if (m_cache.contains(dir) && m_cache[dir].lastModified == lastModified)
+        return m_cache[dir].title;
+    locker.unlock();
+
+    Title found = bluRay ? bluRayMainTitle(dir) : dvdMainTitle(dir);
+    if (!found.file.isEmpty())
+        title = found;
+
+    locker.relock();
+    CachedTitle cached;
+    cached.lastModified = lastModified;
+    cached.title = title;
+    m_cache.insert(dir, cached);
+    return title;
+}
+
+/**
+ * @brief Finds the title set with the longest program chain
+ * @param dir VIDEO_TS folder
+ * @return IFO of the title set
+ */
+DiscStructure::Title DiscStructure::dvdMainTitle(const QString &dir)
+{
+    Title title;
+    title.durationInSeconds = 0;
+    QDir videoTs(dir);
+    foreach (const QFileInfo &fi, videoTs.entryInfoList(QStringList() << "VTS_*_0.IFO" << "vts_*_0.ifo", QDir::Files, QDir::Name)) {
+        int duration = ifoDuration(fi.absoluteFilePath());
+        if (duration > title.durationInSeconds) {
+            title.durationInSeconds = duration;
+            title.file = fi.absoluteFilePath();
+        }
+    }
+    return title;
+}
+
+/**
+ * @brief Finds the longest playlist and its longest clip
+ * @param dir BDMV folder
+ * @return m2ts file of the longest clip and the duration of the whole playlist
+ */
+DiscStructure::Title DiscStructure::bluRayMainTitle(const QString &dir)
+{
+    Title title;
+    title.durationInSeconds = 0;
+    qint64 longest = 0;
+    QString longestClip;
+    QDir playlists(dir + "/PLAYLIST");
+    foreach (const QFileInfo &fi, playlists.entryInfoList(QStringList() << "*.mpls" << "*.MPLS", QDir::Files, QDir::Name)) {
+        QString clip;
+        qint64 duration = mplsDuration(fi.absoluteFilePath(), clip);
+        if (duration > longest && !clip.isEmpty()) {
+            longest = duration;
+            longestClip = clip;
+        }
+    }
+    if (longestClip.isEmpty())
+        return title;
+
+    QFileInfo fiClip(dir + "/STREAM/" + longestClip + ".m2ts");
+    if (!fiClip.exists())
+        fiClip = QFileInfo(dir + "/STREAM/" + longestClip + ".M2TS");
+    if (!fiClip.exists())
+        return title;
+
+    title.file = fiClip.absoluteFilePath();
+    title.durationInSeconds = longest/45000;
+    return title;
+}
+
+/**
+ * @brief Reads the longest program chain of a title set
+ * @param fileName VTS_XX_0.IFO
+ * @return Playback time in seconds, 0 if the IFO could not be read
+ */
+int DiscStructure::ifoDuration(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+    if (file.read(12) != "DVDVIDEO-VTS")
+        return 0;
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    quint32 pgciSector;
+    file.seek(0xCC);
+    stream >> pgciSector;
+    qint64 pgciStart = qint64(pgciSector)*2048;
+    if (!file.seek(pgciStart))
+        return 0;
+
+    quint16 pgcCount;
+    stream >> pgcCount;
+    int longest = 0;
+    for (int i=0 ; i<pgcCount && stream.status() == QDataStream::Ok ; ++i) {
+        quint32 category;
+        quint32 pgcOffset;
+        file.seek(pgciStart + 8 + i*8);
+        stream >> category >> pgcOffset;
+        if (!file.seek(pgciStart + pgcOffset + 4))
+            break;
+        quint8 hours, minutes, seconds, frames;
+        stream >> hours >> minutes >> seconds >> frames;
+        int duration = bcdToInt(hours)*3600 + bcdToInt(minutes)*60 + bcdToInt(seconds);
+        longest = qMax(longest, duration);
+    }
+    return longest;
+}
+
+/**
+ * @brief Sums up the play items of a playlist
+ * @param fileName MPLS playlist
+ * @param mainClip Name of the clip of the longest play item
+ * @return Duration in 45 kHz ticks, 0 if the playlist could not be read
+ */
+qint64 DiscStructure::mplsDuration(const QString &fileName, QString &mainClip)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+    if (file.read(4) != "MPLS")
+        return 0;
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    quint32 playListStart;
+    file.seek(8);
+    stream >> playListStart;
+    if (!file.seek(playListStart + 6))
+        return 0;
+
+    quint16 playItemCount;
+    stream >> playItemCount;
+    qint64 pos = playListStart + 10;
+    qint64 duration = 0;
+    qint64 longestItem = 0;
+    for (int i=0 ; i<playItemCount && stream.status() == QDataStream::Ok ; ++i) {
+        quint16 length;
+        file.seek(pos);
+        stream >> length;
+        QString clip = QString::fromLatin1(file.read(5));
+        quint32 inTime, outTime;
+        file.seek(pos + 2 + 12);
+        stream >> inTime >> outTime;
+        if (outTime > inTime) {
+            duration += outTime - inTime;
+            if (outTime - inTime > longestItem) {
+                longestItem = outTime - inTime;
+                mainClip = clip;
+            }
+        }
+        pos += 2 + length;
+    }
+    return duration;
+}
+
+int DiscStructure::bcdToInt(quint8 value)
+{
+    return (value >> 4)*10 + (value & 0x0f);
+}
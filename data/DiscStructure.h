@@ -0,0 +1,42 @@
+#ifndef DISCSTRUCTURE_H
+#define DISCSTRUCTURE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+/**
+ * @brief The DiscStructure class
+ * Finds the main title of a DVD (VIDEO_TS.IFO) or BluRay (index.bdmv) folder by reading
+ * the program chains of the title set IFOs or the MPLS playlists instead of looking at the
+ * sizes or names of the stream files. Results are cached per disc folder until it changes.
+ */
+class DiscStructure
+{
+public:
+    struct Title {
+        QString file;
+        int durationInSeconds;
+    };
+
+    static bool isDisc(const QString &file);
+    static Title mainTitle(const QString &file);
+
+private:
+    struct CachedTitle {
+        QDateTime lastModified;
+        Title title;
+    };
+
+    static Title dvdMainTitle(const QString &dir);
+    static Title bluRayMainTitle(const QString &dir);
+    static int ifoDuration(const QString &fileName);
+    static qint64 mplsDuration(const QString &fileName, QString &mainClip);
+    static int bcdToInt(quint8 value);
+
+    static QMutex m_mutex;
+    static QHash<QString, CachedTitle> m_cache;
+};
+
+#endif // DISCSTRUCTURE_H
@@ -1,16 +1,59 @@
 #include "ImageCache.h"
 
+#include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QMap>
+#include <QMutexLocker>
+#include <QRunnable>
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "settings/Settings.h"
 
+static const quint32 IndexMagic = 0x4d45494d;
+static const qint32 IndexVersion = 1;
+
+/**
+ * @brief The ImageCacheJob class
+ * Loads or prefetches a single image in the thread pool of the ImageCache
+ */
+class ImageCacheJob : public QRunnable
+{
+public:
+    ImageCacheJob(ImageCache *cache, QString path, int width, int height, bool prefetch) :
+        m_cache(cache),
+        m_path(path),
+        m_width(width),
+        m_height(height),
+        m_prefetch(prefetch)
+    {
+    }
+    void run()
+    {
+        QSize origSize;
+        QImage img = m_cache->loadImage(m_path, m_width, m_height, origSize, !m_prefetch);
+        QMetaObject::invokeMethod(m_cache, "onImageLoaded", Qt::QueuedConnection, Q_ARG(QString, m_path), Q_ARG(int, m_width),
+                                  Q_ARG(int, m_height), Q_ARG(QImage, img), Q_ARG(QSize, origSize), Q_ARG(bool, m_prefetch));
+    }
+
+private:
+    ImageCache *m_cache;
+    QString m_path;
+    int m_width;
+    int m_height;
+    bool m_prefetch;
+};
+
 ImageCache::ImageCache(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_cacheSize(0),
+    m_useCounter(0),
+    m_indexDirty(false)
 {
     QString location = Settings::instance()->imageCacheDir();
     QDir dir(location);
@@ -26,6 +69,23 @@ ImageCache::ImageCache(QObject *parent) :
     qDebug() << "Cache dir" << m_cacheDir;
 
     m_forceCache = Settings::instance()->advanced()->forceCache();
+    m_maxCacheSize = qint64(Settings::instance()->advanced()->imageCacheSize())*1024*1024;
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(10000);
+    connect(&m_saveTimer, SIGNAL(timeout()), this, SLOT(saveIndex()));
+    connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), this, SLOT(saveIndex()));
+
+    if (!m_cacheDir.isEmpty())
+        loadIndex();
+}
+
+ImageCache::~ImageCache()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+    if (m_indexDirty)
+        saveIndex();
 }
 
 ImageCache *ImageCache::instance(QObject *parent)
@@ -36,50 +96,135 @@ ImageCache *ImageCache::instance(QObject *parent)
     return m_instance;
 }
 
-QImage ImageCache::image(QString path, int width, int height, int &origWidth, int &origHeight)
+/**
+ * @brief Loads an image in the thread pool, sigImageLoaded is emitted when it's ready.
+ *        Pending prefetches of the same image don't hold back the request.
+ * @param path Path of the original image
+ * @param width Width to scale to, 0 to keep the aspect ratio
+ * @param height Height to scale to, 0 to keep the aspect ratio
+ * @param imageType Type of the image, the width is remembered to prefetch other images of this type
+ */
+void ImageCache::requestImage(QString path, int width, int height, int imageType)
 {
-    if (m_cacheDir.isEmpty())
-        return scaledImage(Helper::instance()->getImage(path), width, height);
-
-    QString md5 = QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_%2_%3_").arg(md5).arg(width).arg(height);
-
-    bool update = true;
-    QDir dir(m_cacheDir);
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (!files.isEmpty()) {
-        QString fileName = files.first();
-        QStringList parts = fileName.split("_");
-        if (parts.count() > 6) {
-            origWidth = parts.at(3).toInt();
-            origHeight = parts.at(4).toInt();
-            if (m_forceCache || parts.at(5).toInt() == getLastModified(path))
-                update = false;
-        }
+    if (imageType != -1)
+        m_requestedWidths.insert(imageType, width);
+    QString key = requestKey(path, width, height);
+    if (m_requests.contains(key))
+        return;
+    m_requests.insert(key);
+    m_pool.start(new ImageCacheJob(this, path, width, height, false), 1);
+}
+
+/**
+ * @brief Scales images in the background at the width they were last requested for their image type,
+ *        so they are ready when an item next to the current one is selected.
+ *        Types which haven't been requested yet are skipped.
+ * @param images Paths of the images by image type
+ */
+void ImageCache::prefetchImages(const QMap<int, QStringList> &images)
+{
+    QMapIterator<int, QStringList> it(images);
+    while (it.hasNext()) {
+        it.next();
+        if (!m_requestedWidths.contains(it.key()))
+            continue;
+        foreach (const QString &path, it.value())
+            prefetch(path, m_requestedWidths.value(it.key()), 0);
     }
+}
+
+/**
+ * @brief Creates the cached image in the thread pool if it doesn't exist, so a following request is cheap.
+ * Prefetches run after all requested images.
+ * @param path Path of the original image
+ * @param width Width to scale to, 0 to keep the aspect ratio
+ * @param height Height to scale to, 0 to keep the aspect ratio
+ */
+void ImageCache::prefetch(const QString &path, int width, int height)
+{
+    if (m_cacheDir.isEmpty() || path.isEmpty())
+        return;
+    QString key = requestKey(path, width, height);
+    if (m_requests.contains(key) || m_prefetches.contains(key))
+        return;
+    m_prefetches.insert(key);
+    m_pool.start(new ImageCacheJob(this, path, width, height, true), 0);
+}
 
-    if (update) {
-        QImage origImg = Helper::instance()->getImage(path);
-        origWidth = origImg.width();
-        origHeight = origImg.height();
-        QImage img = scaledImage(origImg, width, height);
-        img.save(m_cacheDir + "/" + QString("%1_%2_%3_%4_%5_%6_.png").arg(md5).arg(width).arg(height).arg(origWidth).arg(origHeight).arg(getLastModified(path)), "png", -1);
-        return img;
+/**
+ * @brief Called when a job has finished. Prefetches report nothing, requests always emit sigImageLoaded,
+ *        with a null image if the image couldn't be loaded.
+ */
+void ImageCache::onImageLoaded(QString path, int width, int height, QImage image, QSize origSize, bool prefetch)
+{
+    if (prefetch) {
+        m_prefetches.remove(requestKey(path, width, height));
+        return;
     }
+    m_requests.remove(requestKey(path, width, height));
+    emit sigImageLoaded(path, width, height, image, origSize);
+}
 
-    return Helper::instance()->getImage(m_cacheDir + "/" + files.first());
+QString ImageCache::requestKey(const QString &path, int width, int height) const
+{
+    return QString("%1_%2_%3").arg(path).arg(width).arg(height);
 }
 
-QImage ImageCache::scaledImage(QImage img, int width, int height)
+/**
+ * @brief Returns the cached or newly scaled image, may be called from the thread pool.
+ * Decoding, scaling and writing the image is done without holding the lock.
+ * @param path Path of the original image
+ * @param width Width to scale to
+ * @param height Height to scale to
+ * @param origSize Size of the original image
+ * @param decodeCached If false, nothing is decoded for images which are already cached and a null image is returned
+ * @return Scaled image
+ */
+QImage ImageCache::loadImage(const QString &path, int width, int height, QSize &origSize, bool decodeCached)
 {
-    if (width != 0 && height != 0)
-        return img.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    else if (width != 0)
-        return img.scaledToWidth(width, Qt::SmoothTransformation);
-    else if (height != 0)
-        return img.scaledToHeight(height, Qt::SmoothTransformation);
-    else
-        return img;
+    if (m_cacheDir.isEmpty())
+        return Helper::instance()->getImage(path, width, height, &origSize);
+
+    QString md5 = pathHash(path);
+    QString key = QString("%1_%2_%3").arg(md5).arg(width).arg(height);
+    int lastModified = getLastModified(path);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_entries.contains(key)) {
+        Entry entry = m_entries.value(key);
+        if (m_forceCache || entry.lastModified == lastModified) {
+            origSize = QSize(entry.origWidth, entry.origHeight);
+            touch(key);
+            if (!decodeCached)
+                return QImage();
+            locker.unlock();
+            QImage img = Helper::instance()->getImage(m_cacheDir + "/" + entry.fileName);
+            if (!img.isNull())
+                return img;
+            locker.relock();
+        }
+        removeEntry(key);
+    }
+    locker.unlock();
+
+    QImage img = Helper::instance()->getImage(path, width, height, &origSize);
+
+    Entry entry;
+    entry.origWidth = origSize.width();
+    entry.origHeight = origSize.height();
+    entry.lastModified = lastModified;
+    entry.fileName = QString("%1_%2_%3_%4_%5_%6_.png").arg(md5).arg(width).arg(height).arg(entry.origWidth).arg(entry.origHeight).arg(entry.lastModified);
+    if (!img.isNull() && img.save(m_cacheDir + "/" + entry.fileName, "png", -1)) {
+        entry.size = QFileInfo(m_cacheDir + "/" + entry.fileName).size();
+        locker.relock();
+        // The same image may have been cached by another job in the meantime
+        if (!m_entries.contains(key)) {
+            entry.lastUsed = ++m_useCounter;
+            addEntry(key, entry);
+            evict();
+        }
+    }
+    return img;
 }
 
 void ImageCache::invalidateImages(QString path)
@@ -87,47 +232,235 @@ void ImageCache::invalidateImages(QString path)
     if (m_cacheDir.isEmpty())
         return;
 
-    QString md5 = QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Md5).toHex();
-    QDir dir(m_cacheDir);
-    foreach (const QString &file, dir.entryList(QStringList() << md5 + "*")) {
-        QFile f(dir.absolutePath() + "/" + file);
-        f.remove();
-    }
+    QMutexLocker locker(&m_mutex);
+    foreach (const QString &key, m_keysOfPath.value(pathHash(path)))
+        removeEntry(key);
 }
 
-QSize ImageCache::imageSize(QString path)
+/**
+ * @brief Returns the size of the original image if it's known from the index, nothing is decoded
+ * @param path Path of the original image
+ * @return Size of the image, an invalid size if it's not cached
+ */
+QSize ImageCache::cachedImageSize(QString path)
 {
     if (m_cacheDir.isEmpty())
-        return Helper::instance()->getImage(path).size();
+        return QSize();
+
+    int lastModified = m_forceCache ? 0 : getLastModified(path);
 
-    QString md5 = QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_").arg(md5);
-    QDir dir(m_cacheDir);
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (files.isEmpty() || files.first().split("_").count() < 7)
-        return Helper::instance()->getImage(path).size();
+    QMutexLocker locker(&m_mutex);
+    QStringList keys = m_keysOfPath.value(pathHash(path));
+    if (keys.isEmpty())
+        return QSize();
 
-    QStringList parts = files.first().split("_");
-    if (!m_forceCache && getLastModified(path) != parts.at(5).toInt())
-        return Helper::instance()->getImage(path).size();
+    const Entry &entry = m_entries[keys.first()];
+    if (!m_forceCache && lastModified != entry.lastModified)
+        return QSize();
 
-    return QSize(parts.at(3).toInt(), parts.at(4).toInt());
+    return QSize(entry.origWidth, entry.origHeight);
 }
 
+/**
+ * @brief Returns the modification time of a file, remembered for 10 seconds.
+ * Must be called without holding the lock, the file is stat'ed while it's released.
+ * @param fileName Path of the file
+ * @return Modification time
+ */
 int ImageCache::getLastModified(const QString &fileName)
 {
     int now = QDateTime::currentDateTime().toTime_t();
-    if (!m_lastModifiedTimes.contains(fileName) || m_lastModifiedTimes.value(fileName).first() < now-10) {
-        int lastMod = QFileInfo(fileName).lastModified().toTime_t();
-        m_lastModifiedTimes.insert(fileName, QList<int>() << now << lastMod);
-    }
-    return m_lastModifiedTimes.value(fileName).last();
+    QMutexLocker locker(&m_mutex);
+    QList<int> times = m_lastModifiedTimes.value(fileName);
+    if (!times.isEmpty() && times.first() >= now-10)
+        return times.last();
+    locker.unlock();
+
+    int lastMod = QFileInfo(fileName).lastModified().toTime_t();
+
+    locker.relock();
+    m_lastModifiedTimes.insert(fileName, QList<int>() << now << lastMod);
+    return lastMod;
 }
 
 void ImageCache::clearCache()
 {
     if (m_cacheDir.isEmpty() || !Settings::instance()->advanced()->forceCache())
         return;
-    foreach (const QFileInfo &file, QDir(m_cacheDir).entryInfoList(QDir::Files | QDir::NoDotAndDotDot))
+    m_pool.clear();
+    m_pool.waitForDone();
+    m_requests.clear();
+    m_prefetches.clear();
+    m_mutex.lock();
+    foreach (const QFileInfo &file, QDir(m_cacheDir).entryInfoList(QStringList() << "*.png", QDir::Files | QDir::NoDotAndDotDot))
         QFile(file.absoluteFilePath()).remove();
+    m_entries.clear();
+    m_keysOfPath.clear();
+    m_cacheSize = 0;
+    m_mutex.unlock();
+    saveIndex();
+}
+
+QString ImageCache::pathHash(const QString &path) const
+{
+    return QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+/**
+ * @brief Reads the index of cached images. If there is no index yet, it's built once from the cache dir.
+ */
+void ImageCache::loadIndex()
+{
+    QFile file(m_cacheDir + "/imageCache.index");
+    if (!file.open(QIODevice::ReadOnly)) {
+        rebuildIndex();
+        return;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic;
+    qint32 version;
+    qint32 count;
+    stream >> magic >> version;
+    if (magic != IndexMagic || version != IndexVersion) {
+        file.close();
+        rebuildIndex();
+        return;
+    }
+    stream >> m_useCounter >> count;
+    for (int i=0 ; i<count && stream.status() == QDataStream::Ok ; ++i) {
+        QString key;
+        Entry entry;
+        stream >> key >> entry.fileName >> entry.origWidth >> entry.origHeight >> entry.lastModified >> entry.size >> entry.lastUsed;
+        if (stream.status() == QDataStream::Ok)
+            addEntry(key, entry);
+    }
+    qDebug() << "Image cache contains" << m_entries.count() << "images," << m_cacheSize/1024/1024 << "MB";
+}
+
+/**
+ * @brief Builds the index from the names of the files in the cache dir
+ * Older files are treated as less recently used.
+ */
+void ImageCache::rebuildIndex()
+{
+    m_entries.clear();
+    m_keysOfPath.clear();
+    m_cacheSize = 0;
+    m_useCounter = 0;
+    foreach (const QFileInfo &fi, QDir(m_cacheDir).entryInfoList(QStringList() << "*.png", QDir::Files, QDir::Time | QDir::Reversed)) {
+        QStringList parts = fi.fileName().split("_");
+        if (parts.count() < 7)
+            continue;
+        Entry entry;
+        entry.fileName = fi.fileName();
+        entry.origWidth = parts.at(3).toInt();
+        entry.origHeight = parts.at(4).toInt();
+        entry.lastModified = parts.at(5).toInt();
+        entry.size = fi.size();
+        entry.lastUsed = ++m_useCounter;
+        QString key = QString("%1_%2_%3").arg(parts.at(0)).arg(parts.at(1)).arg(parts.at(2));
+        if (m_entries.contains(key))
+            removeEntry(key);
+        addEntry(key, entry);
+    }
+    evict();
+    saveIndex();
+}
+
+/**
+ * @brief Writes the index of cached images
+ */
+void ImageCache::saveIndex()
+{
+    m_saveTimer.stop();
+    if (m_cacheDir.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    m_indexDirty = false;
+
+    QFile file(m_cacheDir + "/imageCache.index");
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not write image cache index" << file.fileName();
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << IndexMagic << IndexVersion << m_useCounter << qint32(m_entries.count());
+    QHashIterator<QString, Entry> it(m_entries);
+    while (it.hasNext()) {
+        it.next();
+        const Entry &entry = it.value();
+        stream << it.key() << entry.fileName << entry.origWidth << entry.origHeight << entry.lastModified << entry.size << entry.lastUsed;
+    }
+}
+
+void ImageCache::addEntry(const QString &key, const Entry &entry)
+{
+    m_entries.insert(key, entry);
+    m_keysOfPath[key.left(key.indexOf("_"))].append(key);
+    m_cacheSize += entry.size;
+    indexChanged();
+}
+
+/**
+ * @brief Removes an image from the index and deletes the cached file
+ * @param key Key of the image
+ */
+void ImageCache::removeEntry(const QString &key)
+{
+    if (!m_entries.contains(key))
+        return;
+    Entry entry = m_entries.take(key);
+    QFile::remove(m_cacheDir + "/" + entry.fileName);
+    m_cacheSize -= entry.size;
+
+    QString md5 = key.left(key.indexOf("_"));
+    m_keysOfPath[md5].removeOne(key);
+    if (m_keysOfPath[md5].isEmpty())
+        m_keysOfPath.remove(md5);
+    indexChanged();
+}
+
+void ImageCache::touch(const QString &key)
+{
+    m_entries[key].lastUsed = ++m_useCounter;
+    indexChanged();
+}
+
+/**
+ * @brief Removes the least recently used images when the size budget is exceeded.
+ * Images are removed until the cache is at 90% of the budget, so this doesn't run for every new image.
+ */
+void ImageCache::evict()
+{
+    if (m_maxCacheSize <= 0 || m_cacheSize <= m_maxCacheSize)
+        return;
+
+    QMap<qint64, QString> keysByUsage;
+    QHashIterator<QString, Entry> it(m_entries);
+    while (it.hasNext()) {
+        it.next();
+        keysByUsage.insert(it.value().lastUsed, it.key());
+    }
+
+    qint64 target = m_maxCacheSize/10*9;
+    QMapIterator<qint64, QString> usageIt(keysByUsage);
+    while (usageIt.hasNext() && m_cacheSize > target) {
+        usageIt.next();
+        removeEntry(usageIt.value());
+    }
+}
+
+/**
+ * @brief Schedules saving the index, it's written at most every few seconds.
+ * Must be called with the mutex locked, the timer is started in the main thread.
+ */
+void ImageCache::indexChanged()
+{
+    if (m_indexDirty)
+        return;
+    m_indexDirty = true;
+    QMetaObject::invokeMethod(&m_saveTimer, "start", Qt::QueuedConnection);
 }
@@ -3,25 +3,81 @@
 
 #include <QHash>
 #include <QImage>
+#include <QMap>
+#include <QMutex>
 #include <QObject>
+#include <QSet>
+#include <QSize>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
 
+/**
+ * @brief The ImageCache class
+ * Caches scaled images in the cache dir. The cached files are kept in an index which is
+ * persisted to a single file, so lookups don't need to list the cache dir. When the cache
+ * exceeds its size budget the least recently used images are removed.
+ * Images can be requested asynchronously, they are then decoded and scaled in a thread pool.
+ */
 class ImageCache : public QObject
 {
     Q_OBJECT
 public:
     explicit ImageCache(QObject *parent = 0);
+    ~ImageCache();
     static ImageCache *instance(QObject *parent = 0);
-    QImage image(QString path, int width, int height, int &origWidth, int &origHeight);
-    QSize imageSize(QString path);
+    QSize cachedImageSize(QString path);
+    void requestImage(QString path, int width, int height, int imageType = -1);
+    void prefetchImages(const QMap<int, QStringList> &images);
     void invalidateImages(QString path);
     void clearCache();
 
+signals:
+    void sigImageLoaded(QString path, int width, int height, QImage image, QSize origSize);
+
+private slots:
+    void saveIndex();
+    void onImageLoaded(QString path, int width, int height, QImage image, QSize origSize, bool prefetch);
+
 private:
+    struct Entry {
+        QString fileName;
+        int origWidth;
+        int origHeight;
+        int lastModified;
+        qint64 size;
+        qint64 lastUsed;
+    };
+    friend class ImageCacheJob;
+
     QString m_cacheDir;
     QHash<QString, QList<int> > m_lastModifiedTimes;
-    QImage scaledImage(QImage img, int width, int height);
-    int getLastModified(const QString &fileName);
+    QHash<QString, Entry> m_entries;
+    QHash<QString, QStringList> m_keysOfPath;
+    qint64 m_cacheSize;
+    qint64 m_maxCacheSize;
+    qint64 m_useCounter;
+    QTimer m_saveTimer;
+    bool m_indexDirty;
     bool m_forceCache;
+    QMutex m_mutex;
+    QThreadPool m_pool;
+    QSet<QString> m_requests;
+    QSet<QString> m_prefetches;
+    QHash<int, int> m_requestedWidths;
+
+    void prefetch(const QString &path, int width, int height);
+    QImage loadImage(const QString &path, int width, int height, QSize &origSize, bool decodeCached);
+    QString requestKey(const QString &path, int width, int height) const;
+    int getLastModified(const QString &fileName);
+    QString pathHash(const QString &path) const;
+    void loadIndex();
+    void rebuildIndex();
+    void addEntry(const QString &key, const Entry &entry);
+    void removeEntry(const QString &key);
+    void touch(const QString &key);
+    void evict();
+    void indexChanged();
 };
 
 #endif // IMAGECACHE_H
@@ -0,0 +1,91 @@
+#include "MountJobQueue.h"
+
+#include <QThread>
+
+/**
+ * @brief MountJobQueue::MountJobQueue
+ * The pool grows with the number of mounts, but never beyond the ideal thread count
+ * (or threadsPerMount if that's higher).
+ * @param threadsPerMount Maximum number of jobs running at the same time per mount
+ */
+MountJobQueue::MountJobQueue(int threadsPerMount) :
+    m_threadsPerMount(qMax(1, threadsPerMount)),
+    m_maxThreads(qMax(m_threadsPerMount, QThread::idealThreadCount()))
+{
+    m_pool.setMaxThreadCount(m_threadsPerMount);
+}
+
+/**
+ * @brief Drops pending jobs and waits for the running ones
+ */
+MountJobQueue::~MountJobQueue()
+{
+    clear();
+    m_pool.waitForDone();
+}
+
+/**
+ * @brief Adds a job to the queue of a mount and starts it if the mount has a free slot.
+ *        The queue takes ownership of the job.
+ * @param mount Mount the job works on, jobs with an unknown (empty) mount share one queue
+ * @param job Job to run
+ */
+void MountJobQueue::enqueue(const QString &mount, QRunnable *job)
+{
+    if (!m_runningJobs.contains(mount)) {
+        m_runningJobs.insert(mount, 0);
+        m_pool.setMaxThreadCount(qMin(m_maxThreads, m_threadsPerMount * m_runningJobs.count()));
+    }
+    job->setAutoDelete(true);
+    m_pendingJobs[mount].enqueue(job);
+    startJobs();
+}
+
+/**
+ * @brief Frees the slot of a finished job and starts the next pending jobs
+ * @param mount Mount of the finished job
+ */
+void MountJobQueue::finish(const QString &mount)
+{
+    m_runningJobs[mount]--;
+    startJobs();
+}
+
+/**
+ * @brief Drops all jobs which were not started yet, running jobs are not interrupted
+ * @return Number of dropped jobs
+ */
+int MountJobQueue::clear()
+{
+    int count = 0;
+    foreach (const QQueue<QRunnable*> &jobs, m_pendingJobs) {
+        count += jobs.count();
+        qDeleteAll(jobs);
+    }
+    m_pendingJobs.clear();
+    return count;
+}
+
+/**
+ * @brief Waits until all running jobs are finished
+ *        Must not be called with the mutex of the owner locked, jobs need it to finish.
+ */
+void MountJobQueue::waitForDone()
+{
+    m_pool.waitForDone();
+}
+
+/**
+ * @brief Starts pending jobs of all mounts which have free slots
+ */
+void MountJobQueue::startJobs()
+{
+    QMutableHashIterator<QString, QQueue<QRunnable*> > it(m_pendingJobs);
+    while (it.hasNext()) {
+        it.next();
+        while (!it.value().isEmpty() && m_runningJobs.value(it.key()) < m_threadsPerMount) {
+            m_runningJobs[it.key()]++;
+            m_pool.start(it.value().dequeue());
+        }
+    }
+}
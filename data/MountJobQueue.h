@@ -0,0 +1,38 @@
+#ifndef MOUNTJOBQUEUE_H
+#define MOUNTJOBQUEUE_H
+
+#include <QHash>
+#include <QQueue>
+#include <QRunnable>
+#include <QString>
+#include <QThreadPool>
+
+/**
+ * @brief The MountJobQueue class
+ * Runs jobs in a thread pool with at most a fixed number of jobs per mount at a time,
+ * so slow mounts don't block jobs on other mounts and a single disk isn't flooded.
+ * The total number of threads is capped, no matter how many mounts there are.
+ * The queue is not thread safe, owners guard all calls with their own mutex.
+ * Jobs have to call MountJobQueue::finish when they are done.
+ */
+class MountJobQueue
+{
+public:
+    explicit MountJobQueue(int threadsPerMount);
+    ~MountJobQueue();
+    void enqueue(const QString &mount, QRunnable *job);
+    void finish(const QString &mount);
+    int clear();
+    void waitForDone();
+
+private:
+    int m_threadsPerMount;
+    int m_maxThreads;
+    QThreadPool m_pool;
+    QHash<QString, QQueue<QRunnable*> > m_pendingJobs;
+    QHash<QString, int> m_runningJobs;
+
+    void startJobs();
+};
+
+#endif // MOUNTJOBQUEUE_H
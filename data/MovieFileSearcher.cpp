@@ -6,9 +6,9 @@
 #include <QtConcurrent/QtConcurrentMap>
 #include <QtConcurrent/QtConcurrentRun>
 #include <QDebug>
-#include <QDirIterator>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include "data/DirectoryWalker.h"
 #include "data/Subtitle.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
@@ -21,6 +21,7 @@ MovieFileSearcher::MovieFileSearcher(QObject *parent) :
     QObject(parent)
 {
     m_progressMessageId = Constants::MovieFileSearcherProgressMessageId;
+    m_batchSize = 100;
 }
 
 /**
@@ -55,95 +56,105 @@ void MovieFileSearcher::reload(bool force)
             return;
 
         QList<Movie*> moviesFromDb;
-        if (!dir.autoReload && !force)
+        if (!force)
             moviesFromDb = Manager::instance()->database()->movies(dir.path);
 
-        if (dir.autoReload || force || moviesFromDb.count() == 0) {
-            emit currentDir(dir.path);
-            qApp->processEvents();
+        if (!dir.autoReload && !force && moviesFromDb.count() > 0) {
+            dbMovies.append(moviesFromDb);
+            movieSum += moviesFromDb.count();
+            continue;
+        }
+
+        // Auto reload directories are scanned incrementally when the folder states of the last scan are known
+        QHash<QString, qint64> folders;
+        if (!moviesFromDb.isEmpty() && !Settings::instance()->advanced()->movieFilters().isEmpty())
+            folders = Manager::instance()->database()->movieFolders(dir.path);
+        if (folders.isEmpty()) {
+            qDeleteAll(moviesFromDb);
+            moviesFromDb.clear();
             Manager::instance()->database()->clearMovies(dir.path);
-            QMap<QString, QStringList> contents;
-            if (Settings::instance()->advanced()->movieFilters().isEmpty())
-                continue;
-            qDebug() << "Scanning directory" << dir.path;
-            qDebug() << "Filters are" << Settings::instance()->advanced()->movieFilters();
-            QString lastDir;
-            QDirIterator it(dir.path, Settings::instance()->advanced()->movieFilters(), QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files, QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
-            while (it.hasNext()) {
-                if (m_aborted)
-                    return;
-                it.next();
-
-                QString dirName = it.fileInfo().dir().dirName();
-                QString fileName = it.fileName();
-                if (fileName.contains("-trailer", Qt::CaseInsensitive) || fileName.contains("-sample", Qt::CaseInsensitive))
-                    continue;
-
-                // Skip actors folder
-                if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0)
-                    continue;
-
-                // Skip extras folder
-                if (QString::compare("extras", dirName, Qt::CaseInsensitive) == 0)
-                    continue;
-
-                // Skip extra fanarts folder
-                if (QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0)
-                    continue;
-
-                // Skip extra thumbs folder
-                if (QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0)
-                    continue;
-
-                // Skip BluRay backup folder
-                if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0 && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0)
-                    continue;
-
-                if (dirName != lastDir) {
-                    lastDir = dirName;
-                    if (contents.count()%20 == 0)
-                        emit currentDir(dirName);
-                }
+        }
 
-                if (QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-                    qDebug() << "Found BluRay structure";
-                    QDir dir(it.fileInfo().dir());
-                    if (QString::compare(dir.dirName(), "BDMV", Qt::CaseInsensitive) == 0)
-                        dir.cdUp();
-                    bluRays << dir.path();
-                }
-                if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
-                    qDebug() << "Found DVD structure";
-                    QDir dir(it.fileInfo().dir());
-                    if (QString::compare(dir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0)
-                        dir.cdUp();
-                    dvds << dir.path();
-                }
+        if (Settings::instance()->advanced()->movieFilters().isEmpty())
+            continue;
+        qDebug() << "Scanning directory" << dir.path << (folders.isEmpty() ? "" : "(incremental)");
+
+        MovieContents con;
+        con.path = dir.path;
+        con.inSeparateFolder = dir.separateFolders;
+        con.moviesFromDb = moviesFromDb;
+        con.folders = folders;
+        c.append(con);
+    }
+
+    qDebug() << "Filters are" << Settings::instance()->advanced()->movieFilters();
+    scanMovieDirs(c, bluRays, dvds);
+    if (m_aborted)
+        return;
 
-                QString path = it.fileInfo().path();
-                if (!contents.contains(path))
-                    contents.insert(path, QStringList());
-                contents[path].append(it.filePath());
-                m_lastModifications.insert(it.filePath(), it.fileInfo().lastModified());
+    for (int i=0, n=c.count() ; i<n ; ++i) {
+        MovieContents &con = c[i];
+
+        // Keep cached movies of unchanged folders, drop the ones of changed or removed folders
+        Manager::instance()->database()->transaction();
+        foreach (Movie *movie, con.moviesFromDb) {
+            QString movieFolder = movie->files().isEmpty() ? "" : QDir::cleanPath(QFileInfo(movie->files().first()).path());
+            if (movie->files().isEmpty() || con.changedFolders.contains(movieFolder) || !con.folders.contains(movieFolder)) {
+                Manager::instance()->database()->remove(movie);
+                delete movie;
+                continue;
             }
-            movieSum += contents.count();
-            MovieContents con;
-            con.path = dir.path;
-            con.inSeparateFolder = dir.separateFolders;
-            con.contents = contents;
-            c.append(con);
-        } else {
-            dbMovies.append(moviesFromDb);
-            movieSum += moviesFromDb.count();
+            if (movie->discType() != DiscSingle) {
+                QDir discDir(movieFolder);
+                if (QString::compare(discDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0 ||
+                    QString::compare(discDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0)
+                    discDir.cdUp();
+                if (movie->discType() == DiscBluRay)
+                    bluRays << discDir.path();
+                else
+                    dvds << discDir.path();
+            }
+            dbMovies.append(movie);
+            movieSum++;
         }
+        con.moviesFromDb.clear();
+        Manager::instance()->database()->setMovieFolders(con.path, con.folders);
+        Manager::instance()->database()->commit();
+
+        movieSum += con.contents.count();
     }
 
     emit searchStarted(tr("Loading Movies..."), m_progressMessageId);
 
-    qDebug() << "Now processing files";
+    // Cached movies are loaded first and added to the model in batches, so they show up while the new files are processed
     QList<Movie*> movies;
-    foreach (const MovieContents &con, c) {
+    for (int i=0, n=dbMovies.count() ; i<n ; i += m_batchSize) {
+        if (m_aborted)
+            return;
+        QList<Movie*> batch = dbMovies.mid(i, m_batchSize);
+        QtConcurrent::blockingMapped(batch, MovieFileSearcher::loadMovieData);
+        // Entries written before the column cache existed had to be parsed, store their columns now.
+        // Their details are dropped afterwards, they're read again when the movie is opened.
         Manager::instance()->database()->transaction();
+        foreach (Movie *movie, batch) {
+            if (!movie->controller()->infoFromCache()) {
+                Manager::instance()->database()->update(movie);
+                movie->controller()->unloadDetails();
+            }
+        }
+        Manager::instance()->database()->commit();
+        movieCounter += batch.count();
+        emit currentDir(batch.last()->name());
+        emit progress(movieCounter, movieSum, m_progressMessageId);
+        movies.append(batch);
+        addMoviesToModel(movies, false);
+    }
+    addMoviesToModel(movies, true);
+
+    qDebug() << "Now processing files";
+    // All new movies of this scan are written within one transaction
+    Manager::instance()->database()->transaction();
+    foreach (const MovieContents &con, c) {
         QMapIterator<QString, QStringList> itContents(con.contents);
         while (itContents.hasNext()) {
             if (m_aborted) {
@@ -223,7 +234,9 @@ void MovieFileSearcher::reload(bool force)
                     }
                 }
                 Manager::instance()->database()->add(movie, con.path);
+                movie->controller()->unloadDetails();
                 movies.append(movie);
+                addMoviesToModel(movies, false);
                 //emit currentDir(movie->name());
             } else {
                 QMap<QString, QStringList> stacked;
@@ -251,7 +264,9 @@ void MovieFileSearcher::reload(bool force)
                     movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
                     movie->setLabel(Manager::instance()->database()->getLabel(movie->files()));
                     Manager::instance()->database()->add(movie, con.path);
+                    movie->controller()->unloadDetails();
                     movies.append(movie);
+                    addMoviesToModel(movies, false);
                     //emit currentDir(movie->name());
                 }
             }
@@ -259,35 +274,154 @@ void MovieFileSearcher::reload(bool force)
             if (movieCounter%20 == 0)
                 emit currentDir("");
         }
-        Manager::instance()->database()->commit();
     }
+    Manager::instance()->database()->commit();
 
     emit currentDir("");
 
-    QtConcurrent::blockingMapped(dbMovies, MovieFileSearcher::loadMovieData);
-
-    foreach (Movie *movie, dbMovies) {
-        if (m_aborted)
-            return;
-        movies.append(movie);
-        if (movieCounter%20 == 0)
-            emit currentDir(movie->name());
-        emit progress(++movieCounter, movieSum, m_progressMessageId);
-    }
-
-    foreach (Movie *movie, movies)
-        Manager::instance()->movieModel()->addMovie(movie);
+    addMoviesToModel(movies, true);
 
     if (!m_aborted)
         emit moviesLoaded(m_progressMessageId);
 }
 
+/**
+ * @brief Adds loaded movies to the model once a batch is complete
+ * @param movies Loaded movies which are not in the model yet, cleared after adding
+ * @param flush Add the movies even if the batch is not complete
+ */
+void MovieFileSearcher::addMoviesToModel(QList<Movie*> &movies, bool flush)
+{
+    if (movies.isEmpty() || (!flush && movies.count() < m_batchSize))
+        return;
+    Manager::instance()->movieModel()->addMovies(movies);
+    movies.clear();
+    qApp->processEvents();
+}
+
 Movie *MovieFileSearcher::loadMovieData(Movie *movie)
 {
     movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
     return movie;
 }
 
+/**
+ * @brief Walks all movie directories in parallel and collects the movie files of new or changed folders.
+ * Folders whose modification time equals the one stored in MovieContents::folders are not listed again,
+ * only their already known subfolders are visited. Afterwards MovieContents::folders holds the current state.
+ * @param contents Movie directories to scan
+ * @param bluRays List of found BluRay structures
+ * @param dvds List of found DVD structures
+ */
+void MovieFileSearcher::scanMovieDirs(QList<MovieContents> &contents, QStringList &bluRays, QStringList &dvds)
+{
+    DirectoryWalker walker(Settings::instance()->advanced()->movieFilters());
+    QList<QMultiHash<QString, QString> > knownSubFolders;
+    QList<QHash<QString, qint64> > currentFolders;
+    for (int i=0, n=contents.count() ; i<n ; ++i) {
+        QMultiHash<QString, QString> subFolders;
+        QHashIterator<QString, qint64> itFolders(contents.at(i).folders);
+        while (itFolders.hasNext()) {
+            itFolders.next();
+            subFolders.insert(QFileInfo(itFolders.key()).path(), itFolders.key());
+        }
+        knownSubFolders.append(subFolders);
+        currentFolders.append(QHash<QString, qint64>());
+
+        QString path = QDir::cleanPath(contents.at(i).path);
+        emit currentDir(path);
+        walker.enqueue(path, i, contents.at(i).folders.value(path, -1));
+    }
+
+    int changedFolderCount = 0;
+    DirectoryWalker::Listing listing;
+    while (walker.next(listing)) {
+        if (m_aborted) {
+            walker.abort();
+            return;
+        }
+
+        MovieContents &con = contents[listing.root];
+        currentFolders[listing.root].insert(listing.path, listing.lastModified);
+
+        if (!listing.listed) {
+            foreach (const QString &subFolder, knownSubFolders.at(listing.root).values(listing.path))
+                walker.enqueue(subFolder, listing.root, con.folders.value(subFolder, -1));
+            continue;
+        }
+
+        con.changedFolders.insert(listing.path);
+        if (++changedFolderCount%20 == 0)
+            emit currentDir(QFileInfo(listing.path).fileName());
+
+        foreach (const QFileInfo &fi, listing.dirs) {
+            // Disc structures are listed again when their parent folder has changed
+            bool isDiscFolder = QString::compare(fi.fileName(), "BDMV", Qt::CaseInsensitive) == 0 ||
+                                QString::compare(fi.fileName(), "VIDEO_TS", Qt::CaseInsensitive) == 0;
+            walker.enqueue(fi.filePath(), listing.root, isDiscFolder ? -1 : con.folders.value(fi.filePath(), -1));
+        }
+        foreach (const QFileInfo &fi, listing.files)
+            addMovieFile(fi, con.contents, bluRays, dvds);
+    }
+
+    for (int i=0, n=contents.count() ; i<n ; ++i)
+        contents[i].folders = currentFolders.at(i);
+}
+
+/**
+ * @brief Adds a file found while scanning to the contents of its folder
+ * Trailers, samples, files in extra folders and BluRay backups are skipped.
+ * @param fi File
+ * @param contents Movie files grouped by folder
+ * @param bluRays List of found BluRay structures
+ * @param dvds List of found DVD structures
+ */
+void MovieFileSearcher::addMovieFile(const QFileInfo &fi, QMap<QString, QStringList> &contents, QStringList &bluRays, QStringList &dvds)
+{
+    QString dirName = fi.dir().dirName();
+    QString fileName = fi.fileName();
+    if (fileName.contains("-trailer", Qt::CaseInsensitive) || fileName.contains("-sample", Qt::CaseInsensitive))
+        return;
+
+    // Skip actors folder
+    if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0)
+        return;
+
+    // Skip extras folder
+    if (QString::compare("extras", dirName, Qt::CaseInsensitive) == 0)
+        return;
+
+    // Skip extra fanarts folder
+    if (QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0)
+        return;
+
+    // Skip extra thumbs folder
+    if (QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0)
+        return;
+
+    // Skip BluRay backup folder
+    if (QString::compare("backup", dirName, Qt::CaseInsensitive) == 0 && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0)
+        return;
+
+    if (QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+        qDebug() << "Found BluRay structure";
+        QDir dir(fi.dir());
+        if (QString::compare(dir.dirName(), "BDMV", Qt::CaseInsensitive) == 0)
+            dir.cdUp();
+        bluRays << dir.path();
+    }
+    if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
+        qDebug() << "Found DVD structure";
+        QDir dir(fi.dir());
+        if (QString::compare(dir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0)
+            dir.cdUp();
+        dvds << dir.path();
+    }
+
+    contents[fi.path()].append(fi.filePath());
+    m_lastModifications.insert(fi.filePath(), fi.lastModified());
+}
+
 /**
  * @brief Sets the directories to scan for movies. Not existing directories are skipped.
  * @param directories List of directories
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QDir>
 #include <QHash>
+#include <QSet>
 #include <QTime>
 
 #include "movies/Movie.h"
@@ -37,6 +38,7 @@ private:
 
     QList<SettingsDir> m_directories;
     int m_progressMessageId;
+    int m_batchSize;
     QHash<QString, QDateTime> m_lastModifications;
     bool m_aborted;
 
@@ -44,7 +46,14 @@ private:
         QString path;
         bool inSeparateFolder;
         QMap<QString, QStringList> contents;
+        QList<Movie*> moviesFromDb;
+        QHash<QString, qint64> folders;
+        QSet<QString> changedFolders;
     };
+
+    void scanMovieDirs(QList<MovieContents> &contents, QStringList &bluRays, QStringList &dvds);
+    void addMoviesToModel(QList<Movie*> &movies, bool flush);
+    void addMovieFile(const QFileInfo &fi, QMap<QString, QStringList> &contents, QStringList &bluRays, QStringList &dvds);
 };
 
 #endif // MOVIEFILESEARCHER_H
@@ -0,0 +1,246 @@
+#include "MovieFilterIndex.h"
+
+#include "globals/Globals.h"
+
+/**
+ * @brief MovieFilterIndex::MovieFilterIndex
+ */
+MovieFilterIndex::MovieFilterIndex() :
+    m_capacity(0),
+    m_revision(0)
+{
+}
+
+/**
+ * @brief Removes all movies from the index
+ */
+void MovieFilterIndex::clear()
+{
+    m_attributes.clear();
+    m_keys.clear();
+    m_capacity = 0;
+    m_revision++;
+}
+
+/**
+ * @brief Adds a movie to the index
+ * @param row Row of the movie in the MovieModel, movies have to be added in the order of their rows
+ * @param movie Movie to add
+ */
+void MovieFilterIndex::addMovie(int row, Movie *movie)
+{
+    if (row != m_keys.count())
+        return;
+    reserve(row+1);
+    QList<Key> movieKeys = keys(movie);
+    m_keys.append(movieKeys);
+    setBits(row, movieKeys, true);
+    m_revision++;
+}
+
+/**
+ * @brief Updates the index with the current attributes of a movie
+ *        The revision is only increased if an indexed attribute has changed.
+ * @param row Row of the movie in the MovieModel
+ * @param movie Movie which has changed
+ */
+void MovieFilterIndex::updateMovie(int row, Movie *movie)
+{
+    if (row < 0 || row >= m_keys.count())
+        return;
+    QList<Key> movieKeys = keys(movie);
+    if (movieKeys == m_keys.at(row))
+        return;
+    setBits(row, m_keys.at(row), false);
+    setBits(row, movieKeys, true);
+    m_keys[row] = movieKeys;
+    m_revision++;
+}
+
+/**
+ * @brief Returns the rows accepted by all given filters
+ * @param filters Filters, each of them has to be indexed
+ * @return Bit array, a bit is set if the movie in this row is accepted
+ * @see MovieFilterIndex::isIndexed
+ */
+QBitArray MovieFilterIndex::matches(QList<Filter*> filters) const
+{
+    QBitArray result(m_capacity, true);
+    foreach (Filter *filter, filters)
+        result &= bits(filter);
+    return result;
+}
+
+/**
+ * @brief The revision is increased each time the index changes
+ * @return Revision of the index
+ */
+int MovieFilterIndex::revision() const
+{
+    return m_revision;
+}
+
+/**
+ * @brief Checks if the rows accepted by a filter can be taken from the index
+ * @param filter Filter to check
+ * @return True if the filter is indexed
+ */
+bool MovieFilterIndex::isIndexed(Filter *filter)
+{
+    switch (filter->info()) {
+    case MovieFilters::Poster:
+    case MovieFilters::Backdrop:
+    case MovieFilters::ExtraFanarts:
+    case MovieFilters::Logo:
+    case MovieFilters::ClearArt:
+    case MovieFilters::Banner:
+    case MovieFilters::Thumb:
+    case MovieFilters::CdArt:
+    case MovieFilters::Watched:
+    case MovieFilters::Certification:
+    case MovieFilters::Genres:
+    case MovieFilters::Studio:
+    case MovieFilters::Set:
+    case MovieFilters::Country:
+    case MovieFilters::Tags:
+    case MovieFilters::Label:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Returns the rows accepted by a single indexed filter
+ * @param filter Filter
+ * @return Bit array of the accepted rows
+ */
+QBitArray MovieFilterIndex::bits(Filter *filter) const
+{
+    Attribute attribute = m_attributes.value(filter->info());
+    QBitArray none = attribute.none.isEmpty() ? QBitArray(m_capacity) : attribute.none;
+
+    switch (filter->info()) {
+    case MovieFilters::Label:
+        return attribute.values.value(QString::number(filter->data()), QBitArray(m_capacity));
+    case MovieFilters::Certification:
+    case MovieFilters::Genres:
+    case MovieFilters::Studio:
+    case MovieFilters::Set:
+    case MovieFilters::Country:
+    case MovieFilters::Tags:
+        if (!filter->hasInfo())
+            return none;
+        if (filter->shortText().isEmpty() && (filter->info() == MovieFilters::Certification || filter->info() == MovieFilters::Set))
+            return none;
+        return attribute.values.value(filter->shortText(), QBitArray(m_capacity));
+    default:
+        return filter->hasInfo() ? ~none : none;
+    }
+}
+
+/**
+ * @brief Returns the index keys of a movie
+ * @param movie Movie
+ * @return List of keys
+ */
+QList<MovieFilterIndex::Key> MovieFilterIndex::keys(Movie *movie) const
+{
+    QList<Key> movieKeys;
+    addFlag(movieKeys, MovieFilters::Poster, movie->hasImage(ImageType::MoviePoster));
+    addFlag(movieKeys, MovieFilters::Backdrop, movie->hasImage(ImageType::MovieBackdrop));
+    addFlag(movieKeys, MovieFilters::ExtraFanarts, movie->hasExtraFanarts());
+    addFlag(movieKeys, MovieFilters::Logo, movie->hasImage(ImageType::MovieLogo));
+    addFlag(movieKeys, MovieFilters::ClearArt, movie->hasImage(ImageType::MovieClearArt));
+    addFlag(movieKeys, MovieFilters::Banner, movie->hasImage(ImageType::MovieBanner));
+    addFlag(movieKeys, MovieFilters::Thumb, movie->hasImage(ImageType::MovieThumb));
+    addFlag(movieKeys, MovieFilters::CdArt, movie->hasImage(ImageType::MovieCdArt));
+    addFlag(movieKeys, MovieFilters::Watched, movie->watched());
+    addKey(movieKeys, MovieFilters::Certification, movie->certification());
+    addKey(movieKeys, MovieFilters::Set, movie->set());
+    addKey(movieKeys, MovieFilters::Label, QString::number(movie->label()));
+    addKeys(movieKeys, MovieFilters::Genres, movie->genres());
+    addKeys(movieKeys, MovieFilters::Studio, movie->studios());
+    addKeys(movieKeys, MovieFilters::Country, movie->countries());
+    addKeys(movieKeys, MovieFilters::Tags, movie->tags());
+    return movieKeys;
+}
+
+void MovieFilterIndex::addKey(QList<Key> &keys, int info, const QString &value) const
+{
+    Key key;
+    key.info = info;
+    key.value = value;
+    key.none = value.isEmpty();
+    keys.append(key);
+}
+
+void MovieFilterIndex::addKeys(QList<Key> &keys, int info, const QStringList &values) const
+{
+    if (values.isEmpty()) {
+        addKey(keys, info, QString());
+        return;
+    }
+    foreach (const QString &value, values)
+        addKey(keys, info, value);
+}
+
+void MovieFilterIndex::addFlag(QList<Key> &keys, int info, bool flag) const
+{
+    Key key;
+    key.info = info;
+    key.none = !flag;
+    keys.append(key);
+}
+
+/**
+ * @brief Sets or clears the bits of a row
+ * @param row Row of the movie
+ * @param keys Keys of the movie
+ * @param value Set or clear the bits
+ */
+void MovieFilterIndex::setBits(int row, const QList<Key> &keys, bool value)
+{
+    foreach (const Key &key, keys) {
+        Attribute &attribute = m_attributes[key.info];
+        if (attribute.none.size() != m_capacity)
+            attribute.none.resize(m_capacity);
+        if (key.none) {
+            attribute.none.setBit(row, value);
+        } else if (!key.value.isEmpty()) {
+            if (!attribute.values.contains(key.value))
+                attribute.values.insert(key.value, QBitArray(m_capacity));
+            attribute.values[key.value].setBit(row, value);
+        }
+    }
+}
+
+/**
+ * @brief Grows the bit arrays, the capacity is doubled to keep adding movies cheap
+ * @param count Number of rows which have to fit
+ */
+void MovieFilterIndex::reserve(int count)
+{
+    if (count <= m_capacity)
+        return;
+    int capacity = qMax(64, m_capacity);
+    while (capacity < count)
+        capacity *= 2;
+    m_capacity = capacity;
+
+    QMutableHashIterator<int, Attribute> it(m_attributes);
+    while (it.hasNext()) {
+        it.next();
+        it.value().none.resize(m_capacity);
+        QMutableHashIterator<QString, QBitArray> valueIt(it.value().values);
+        while (valueIt.hasNext()) {
+            valueIt.next();
+            valueIt.value().resize(m_capacity);
+        }
+    }
+}
+
+bool MovieFilterIndex::Key::operator==(const Key &other) const
+{
+    return info == other.info && value == other.value && none == other.none;
+}
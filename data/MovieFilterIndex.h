@@ -0,0 +1,57 @@
+#ifndef MOVIEFILTERINDEX_H
+#define MOVIEFILTERINDEX_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include "globals/Filter.h"
+#include "movies/Movie.h"
+
+/**
+ * @brief The MovieFilterIndex class
+ * Inverted index over the filterable attributes of the movies in the MovieModel.
+ * For every value of an attribute (e.g. a genre) a bit array holds the rows of the
+ * movies having this value, so the rows accepted by a list of filters are the
+ * intersection of the bit arrays. Filters which compare free text (title, path, ...)
+ * are not indexed and have to be checked with Filter::accepts.
+ */
+class MovieFilterIndex
+{
+public:
+    MovieFilterIndex();
+    void clear();
+    void addMovie(int row, Movie *movie);
+    void updateMovie(int row, Movie *movie);
+    QBitArray matches(QList<Filter*> filters) const;
+    int revision() const;
+    static bool isIndexed(Filter *filter);
+
+private:
+    struct Key {
+        int info;
+        QString value;
+        bool none;
+        bool operator==(const Key &other) const;
+    };
+
+    struct Attribute {
+        QHash<QString, QBitArray> values;
+        QBitArray none;
+    };
+
+    QHash<int, Attribute> m_attributes;
+    QList<QList<Key> > m_keys;
+    int m_capacity;
+    int m_revision;
+
+    QList<Key> keys(Movie *movie) const;
+    void addKey(QList<Key> &keys, int info, const QString &value) const;
+    void addKeys(QList<Key> &keys, int info, const QStringList &values) const;
+    void addFlag(QList<Key> &keys, int info, bool flag) const;
+    void setBits(int row, const QList<Key> &keys, bool value);
+    void reserve(int count);
+    QBitArray bits(Filter *filter) const;
+};
+
+#endif // MOVIEFILTERINDEX_H
@@ -4,6 +4,7 @@
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
+#include "settings/Settings.h"
 
 /**
  * @brief MovieModel::MovieModel
@@ -21,6 +22,7 @@ MovieModel::MovieModel(QObject *parent) :
     m_syncIcon = font->icon("refresh_cloud", QColor(248, 148, 6), QColor(255, 255, 255), "", 0, 1.0);
     m_newIcon = font->icon("star", QColor(58, 135, 173), QColor(255, 255, 255), "", 0, 1.0);
 #endif
+    connect(Settings::instance(), SIGNAL(sigSettingsSaved()), this, SLOT(onSettingsSaved()));
 }
 
 /**
@@ -30,19 +32,46 @@ MovieModel::MovieModel(QObject *parent) :
 void MovieModel::addMovie(Movie *movie)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
+    m_filterIndex.addMovie(m_movies.count(), movie);
+    updateSortKeys(movie);
+    updateFacets(movie);
     m_movies.append(movie);
     endInsertRows();
     connect(movie, SIGNAL(sigChanged(Movie*)), this, SLOT(onMovieChanged(Movie*)), Qt::UniqueConnection);
 }
 
+/**
+ * @brief Adds several movies to the model with a single row insertion
+ * @param movies Movies to add
+ */
+void MovieModel::addMovies(QList<Movie*> movies)
+{
+    if (movies.isEmpty())
+        return;
+    beginInsertRows(QModelIndex(), rowCount(), rowCount()+movies.count()-1);
+    for (int i=0, n=movies.count() ; i<n ; ++i) {
+        m_filterIndex.addMovie(m_movies.count()+i, movies.at(i));
+        updateSortKeys(movies.at(i));
+        updateFacets(movies.at(i));
+    }
+    m_movies.append(movies);
+    endInsertRows();
+    foreach (Movie *movie, movies)
+        connect(movie, SIGNAL(sigChanged(Movie*)), this, SLOT(onMovieChanged(Movie*)), Qt::UniqueConnection);
+}
+
 /**
  * @brief Called when a movies data has changed
- * Emits dataChanged
+ * Updates the filter index, the sort keys and the facet counts and emits dataChanged
  * @param movie Movie which has changed
  */
 void MovieModel::onMovieChanged(Movie *movie)
 {
-    QModelIndex index = createIndex(m_movies.indexOf(movie), 0);
+    int row = m_movies.indexOf(movie);
+    m_filterIndex.updateMovie(row, movie);
+    updateSortKeys(movie);
+    updateFacets(movie);
+    QModelIndex index = createIndex(row, 0);
     emit dataChanged(index, index);
 }
 
@@ -140,7 +169,7 @@ QVariant MovieModel::data(const QModelIndex &index, int role) const
         QString icon;
         switch (MovieModel::columnToMediaStatus(index.column())) {
         case MediaStatusActors:
-            icon = (movie->actors().isEmpty()) ? "actors/red" : "actors/green";
+            icon = (movie->hasActors()) ? "actors/green" : "actors/red";
             break;
         case MediaStatusTrailer:
             icon = (movie->trailer().isEmpty()) ? "trailer/red" : "trailer/green";
@@ -227,9 +256,105 @@ void MovieModel::clear()
     foreach (Movie *movie, m_movies)
         movie->deleteLater();
     m_movies.clear();
+    m_detailsLru.clear();
+    m_filterIndex.clear();
+    m_sortKeys.clear();
+    m_facets.clear();
     endRemoveRows();
 }
 
+/**
+ * @brief Marks the details of a movie as used. If more movies than configured
+ *        hold their details, the details of the least recently used ones are dropped.
+ * @param movie Movie whose details were loaded
+ * @see MovieController::unloadDetails
+ */
+void MovieModel::touchDetails(Movie *movie)
+{
+    m_detailsLru.removeOne(movie);
+    m_detailsLru.prepend(movie);
+    int maxMovies = qMax(1, Settings::instance()->advanced()->movieDetailsCacheSize());
+    for (int i=m_detailsLru.count()-1 ; i>=maxMovies ; --i) {
+        if (m_detailsLru.at(i)->controller()->unloadDetails())
+            m_detailsLru.removeAt(i);
+    }
+}
+
+/**
+ * @brief Returns the index of the filterable attributes of all movies
+ * @return Filter index
+ */
+const MovieFilterIndex *MovieModel::filterIndex() const
+{
+    return &m_filterIndex;
+}
+
+/**
+ * @brief Returns the precomputed sort keys of all movies
+ *        The number holds the last modification of the file, the flags hold the SortKeyFlags
+ *        and the year of the release shifted by SortKeyYearShift.
+ * @return Sort keys
+ */
+const SortKeyCache *MovieModel::sortKeys() const
+{
+    return &m_sortKeys;
+}
+
+/**
+ * @brief Computes the sort keys of a movie
+ * @param movie Movie
+ */
+void MovieModel::updateSortKeys(Movie *movie)
+{
+    QDateTime lastModified = movie->fileLastModified();
+    qint64 added = lastModified.isValid() ? lastModified.toMSecsSinceEpoch() : 0;
+    int flags = 0;
+    if (movie->controller()->infoLoaded())
+        flags |= SortKeyInfoLoaded;
+    if (movie->watched())
+        flags |= SortKeyWatched;
+    if (movie->released().isValid())
+        flags |= movie->released().year() << SortKeyYearShift;
+    m_sortKeys.setKeys(movie, movie->name(), added, flags);
+}
+
+/**
+ * @brief Returns how many movies have each genre, studio, country, tag, director, year, certification and set
+ * @return Facet counts, the facets are the filter infos (e.g. MovieFilters::Genres)
+ */
+const FacetCounts *MovieModel::facets() const
+{
+    return &m_facets;
+}
+
+/**
+ * @brief Updates the facet values of a movie
+ * @param movie Movie
+ */
+void MovieModel::updateFacets(Movie *movie)
+{
+    FacetCounts::Values values;
+    FacetCounts::addValues(values, MovieFilters::Genres, movie->genres());
+    FacetCounts::addValues(values, MovieFilters::Studio, movie->studios());
+    FacetCounts::addValues(values, MovieFilters::Country, movie->countries());
+    FacetCounts::addValues(values, MovieFilters::Tags, movie->tags());
+    FacetCounts::addValue(values, MovieFilters::Director, movie->director());
+    FacetCounts::addValue(values, MovieFilters::Certification, movie->certification());
+    FacetCounts::addValue(values, MovieFilters::Set, movie->set());
+    if (movie->released().isValid())
+        FacetCounts::addValue(values, MovieFilters::Released, QString::number(movie->released().year()));
+    m_facets.setValues(movie, values);
+}
+
+/**
+ * @brief Computes the sort keys of all movies again, the articles to ignore may have changed
+ */
+void MovieModel::onSettingsSaved()
+{
+    foreach (Movie *movie, m_movies)
+        updateSortKeys(movie);
+}
+
 /**
  * @brief Returns a list of all movies
  * @return List of movies
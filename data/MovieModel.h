@@ -3,6 +3,9 @@
 
 #include <QAbstractItemModel>
 #include <QIcon>
+#include "data/MovieFilterIndex.h"
+#include "globals/FacetCounts.h"
+#include "globals/SortKeyCache.h"
 #include "movies/Movie.h"
 
 /**
@@ -16,8 +19,14 @@ public:
          NameRole = Qt::UserRole + 1,
          FileNameRole
     };
+    enum SortKeyFlags {
+        SortKeyInfoLoaded = 0x1,
+        SortKeyWatched = 0x2,
+        SortKeyYearShift = 2
+    };
     explicit MovieModel(QObject *parent = 0);
     void addMovie(Movie *movie);
+    void addMovies(QList<Movie*> movies);
     void clear();
     virtual QList<Movie*> movies();
     Movie *movie(int row);
@@ -31,12 +40,24 @@ public:
     static QString mediaStatusToText(MediaStatusColumns column);
     static MediaStatusColumns columnToMediaStatus(int column);
     void update();
+    void touchDetails(Movie *movie);
+    const MovieFilterIndex *filterIndex() const;
+    const SortKeyCache *sortKeys() const;
+    const FacetCounts *facets() const;
 
 private slots:
     void onMovieChanged(Movie *movie);
+    void onSettingsSaved();
 
 private:
     QList<Movie*> m_movies;
+    QList<Movie*> m_detailsLru;
+    MovieFilterIndex m_filterIndex;
+    SortKeyCache m_sortKeys;
+    FacetCounts m_facets;
+
+    void updateSortKeys(Movie *movie);
+    void updateFacets(Movie *movie);
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
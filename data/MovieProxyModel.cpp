@@ -9,14 +9,17 @@
  * @param parent
  */
 MovieProxyModel::MovieProxyModel(QObject *parent) :
-    QSortFilterProxyModel(parent)
+    QSortFilterProxyModel(parent),
+    m_filterRevision(-1)
 {
     m_sortBy = SortByNew;
     sort(0, Qt::AscendingOrder);
 }
 
 /**
- * @brief Checks if a row accepts the filter. Checks the first two "columns" of our model (Movie name and folder name)
+ * @brief Checks if a row accepts the filter.
+ *        The rows accepted by the indexed filters are taken from the filter index of the model,
+ *        they are computed again when the index has changed. The remaining filters are checked on the movie.
  * @param sourceRow
  * @param sourceParent
  * @return Filter is accepted or not
@@ -24,12 +27,21 @@ MovieProxyModel::MovieProxyModel(QObject *parent) :
 bool MovieProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
     Q_UNUSED(sourceParent);
-    QList<Movie*> movies = Manager::instance()->movieModel()->movies();
-    if (sourceRow < 0 || sourceRow >= movies.count())
+    MovieModel *model = Manager::instance()->movieModel();
+    Movie *movie = model->movie(sourceRow);
+    if (!movie)
         return true;
 
-    Movie *movie = movies.at(sourceRow);
-    foreach (Filter *filter, m_filters) {
+    if (!m_indexedFilters.isEmpty()) {
+        if (m_filterRevision != model->filterIndex()->revision()) {
+            m_filterRows = model->filterIndex()->matches(m_indexedFilters);
+            m_filterRevision = model->filterIndex()->revision();
+        }
+        if (sourceRow >= m_filterRows.size() || !m_filterRows.testBit(sourceRow))
+            return false;
+    }
+
+    foreach (Filter *filter, m_otherFilters) {
         if (!filter->accepts(movie))
             return false;
     }
@@ -39,42 +51,44 @@ bool MovieProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceP
 
 /**
  * @brief Sort function for the movie model. Sorts movies by name and new files to top.
+ *        Uses the precomputed sort keys of the model.
  * @param left
  * @param right
  * @return
  */
 bool MovieProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
-    int cmp = QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString());
+    MovieModel *model = Manager::instance()->movieModel();
+    const SortKeyCache::SortKey *leftKey = model->sortKeys()->key(model->movie(left.row()));
+    const SortKeyCache::SortKey *rightKey = model->sortKeys()->key(model->movie(right.row()));
+    if (!leftKey || !rightKey)
+        return QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString()) < 0;
 
-    if (m_sortBy == SortByAdded) {
-        // Qt::UserRole+5
-        return sourceModel()->data(left, Qt::UserRole+5).toDateTime() >= sourceModel()->data(right, Qt::UserRole+5).toDateTime();
-    }
+    if (m_sortBy == SortByAdded)
+        return leftKey->number >= rightKey->number;
 
     if (m_sortBy == SortBySeen) {
-        // Qt::UserRole+4
-        if (sourceModel()->data(left, Qt::UserRole+4).toBool() && !sourceModel()->data(right, Qt::UserRole+4).toBool() )
-            return false;
-        if (!sourceModel()->data(left, Qt::UserRole+4).toBool() && sourceModel()->data(right, Qt::UserRole+4).toBool() )
-            return true;
+        bool leftSeen = leftKey->flags & MovieModel::SortKeyWatched;
+        bool rightSeen = rightKey->flags & MovieModel::SortKeyWatched;
+        if (leftSeen != rightSeen)
+            return rightSeen;
     }
 
     if (m_sortBy == SortByYear) {
-        // Qt::UserRole+3
-        if (sourceModel()->data(left, Qt::UserRole+3).toDate().year() != sourceModel()->data(right, Qt::UserRole+3).toDate().year())
-            return sourceModel()->data(left, Qt::UserRole+3).toDate().year() >= sourceModel()->data(right, Qt::UserRole+3).toDate().year();
+        int leftYear = leftKey->flags >> MovieModel::SortKeyYearShift;
+        int rightYear = rightKey->flags >> MovieModel::SortKeyYearShift;
+        if (leftYear != rightYear)
+            return leftYear >= rightYear;
     }
 
     if (m_sortBy == SortByNew) {
-        // Qt::UserRole+1
-        if (sourceModel()->data(left, Qt::UserRole+1).toBool() && !sourceModel()->data(right, Qt::UserRole+1).toBool() )
-            return false;
-        if (!sourceModel()->data(left, Qt::UserRole+1).toBool() && sourceModel()->data(right, Qt::UserRole+1).toBool() )
-            return true;
+        bool leftLoaded = leftKey->flags & MovieModel::SortKeyInfoLoaded;
+        bool rightLoaded = rightKey->flags & MovieModel::SortKeyInfoLoaded;
+        if (leftLoaded != rightLoaded)
+            return rightLoaded;
     }
 
-    return (cmp < 0);
+    return leftKey->compareTitle(*rightKey) < 0;
 }
 
 /**
@@ -86,6 +100,15 @@ void MovieProxyModel::setFilter(QList<Filter*> filters, QString text)
 {
     m_filters = filters;
     m_filterText = text;
+    m_indexedFilters.clear();
+    m_otherFilters.clear();
+    foreach (Filter *filter, filters) {
+        if (MovieFilterIndex::isIndexed(filter))
+            m_indexedFilters.append(filter);
+        else
+            m_otherFilters.append(filter);
+    }
+    m_filterRevision = -1;
 }
 
 /**
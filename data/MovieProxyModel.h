@@ -1,6 +1,7 @@
 #ifndef MOVIEPROXYMODEL_H
 #define MOVIEPROXYMODEL_H
 
+#include <QBitArray>
 #include <QSortFilterProxyModel>
 #include "globals/Filter.h"
 
@@ -19,8 +20,12 @@ protected:
     bool lessThan(const QModelIndex &left, const QModelIndex &right) const;
 private:
     QList<Filter*> m_filters;
+    QList<Filter*> m_indexedFilters;
+    QList<Filter*> m_otherFilters;
     QString m_filterText;
     SortBy m_sortBy;
+    mutable QBitArray m_filterRows;
+    mutable int m_filterRevision;
 };
 
 #endif // MOVIEPROXYMODEL_H
@@ -2,10 +2,11 @@
 
 #include <QApplication>
 #include <QDebug>
-#include <QDir>
 #include <QFileInfo>
 #include <QProcess>
+#include "data/DiscStructure.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "settings/Settings.h"
 
 #include "MediaInfoDLL/MediaInfoDLL.h"
@@ -51,62 +52,128 @@ void StreamDetails::clear()
 
 /**
  * @brief Loads stream details from the file
+ * Details stored in the database are used as long as size and modification time of the files don't change.
  */
 void StreamDetails::loadStreamDetails()
 {
     clear();
-    if (m_files.isEmpty())
+    if (!canLoadFromFile(m_files))
         return;
 
-    if (m_files.first().endsWith(".iso", Qt::CaseInsensitive) || m_files.first().endsWith(".img", Qt::CaseInsensitive))
+    QString cacheFile = m_files.first();
+    qint64 size;
+    QDateTime lastModified;
+    fileState(m_files, size, lastModified);
+    if (lastModified.isValid() && Manager::instance()->database()->streamDetails(this, cacheFile, size, lastModified))
         return;
 
-    // If it's a DVD structure, compute the biggest part (main movie) and use this IFO file
-    if (m_files.first().endsWith("VIDEO_TS.IFO")) {
-        QMap<QString, qint64> sizes;
-        QString biggest;
-        qint64 biggestSize = 0;
-        QFileInfo fi(m_files.first());
-        foreach (const QFileInfo &fiVob, fi.dir().entryInfoList(QStringList() << "VTS_*.VOB" << "vts_*.vob", QDir::Files, QDir::Name)) {
-            QRegExp rx("VTS_([0-9]*)_[0-9]*.VOB");
-            rx.setMinimal(true);
-            rx.setCaseSensitivity(Qt::CaseInsensitive);
-            if (rx.indexIn(fiVob.fileName()) != -1) {
-                if (!sizes.contains(rx.cap(1)))
-                    sizes.insert(rx.cap(1), 0);
-                sizes[rx.cap(1)] += fiVob.size();
-                if (sizes[rx.cap(1)] > biggestSize) {
-                    biggestSize = sizes[rx.cap(1)];
-                    biggest = rx.cap(1);
-                }
-            }
+    loadFromFile();
+
+    if (lastModified.isValid() && hasFileDetails())
+        Manager::instance()->database()->setStreamDetails(this, cacheFile, size, lastModified);
+}
+
+/**
+ * @brief Reads the stream details with MediaInfo without using the database cache.
+ * This doesn't touch the database, so it may be called from worker threads.
+ * @see StreamDetailsLoader
+ */
+void StreamDetails::loadFromFile()
+{
+    clear();
+    if (!canLoadFromFile(m_files))
+        return;
+
+    // For DVD and BluRay structures the main title is read, the duration of a BluRay
+    // playlist can be longer than the clip MediaInfo reads
+    DiscStructure::Title title = DiscStructure::mainTitle(m_files.first());
+    loadWithLibrary(title.file);
+    if (title.durationInSeconds > 0)
+        setVideoDetail("durationinseconds", QString("%1").arg(title.durationInSeconds));
+}
+
+/**
+ * @brief Holds if stream details can be read from files, images (iso, img) can't be read
+ * @param files Files of the item
+ * @return True if MediaInfo can be used
+ */
+bool StreamDetails::canLoadFromFile(const QStringList &files)
+{
+    if (files.isEmpty())
+        return false;
+    return !files.first().endsWith(".iso", Qt::CaseInsensitive) && !files.first().endsWith(".img", Qt::CaseInsensitive);
+}
+
+/**
+ * @brief Holds if the details were read from a file. Nothing but the duration is set if MediaInfo could not read the file.
+ * @return True if details besides the duration are present
+ */
+bool StreamDetails::hasFileDetails() const
+{
+    return m_videoDetails.count() > 1 || !m_audioDetails.isEmpty();
+}
+
+/**
+ * @brief Replaces all details with the ones of another object
+ * @param streamDetails Stream details to copy
+ */
+void StreamDetails::copyFrom(StreamDetails *streamDetails)
+{
+    clear();
+    QMapIterator<QString, QString> it(streamDetails->videoDetails());
+    while (it.hasNext()) {
+        it.next();
+        setVideoDetail(it.key(), it.value());
+    }
+    QList<QMap<QString, QString> > audioDetails = streamDetails->audioDetails();
+    for (int i=0, n=audioDetails.count() ; i<n ; ++i) {
+        QMapIterator<QString, QString> it(audioDetails.at(i));
+        while (it.hasNext()) {
+            it.next();
+            setAudioDetail(i, it.key(), it.value());
         }
-        if (!biggest.isEmpty()) {
-            QFileInfo fiNew(fi.absolutePath() + "/VTS_" + biggest + "_0.IFO");
-            if (fiNew.isFile() && fiNew.exists())
-                m_files = QStringList() << fiNew.absoluteFilePath();
+    }
+    QList<QMap<QString, QString> > subtitleDetails = streamDetails->subtitleDetails();
+    for (int i=0, n=subtitleDetails.count() ; i<n ; ++i) {
+        QMapIterator<QString, QString> it(subtitleDetails.at(i));
+        while (it.hasNext()) {
+            it.next();
+            setSubtitleDetail(i, it.key(), it.value());
         }
     }
+}
 
-    loadWithLibrary();
+/**
+ * @brief Computes the state of files used to validate cached stream details
+ * @param files Files of the item
+ * @param size Summed size of all files
+ * @param lastModified Newest modification time, invalid if no file exists
+ */
+void StreamDetails::fileState(const QStringList &files, qint64 &size, QDateTime &lastModified)
+{
+    size = 0;
+    lastModified = QDateTime();
+    foreach (const QString &file, files) {
+        QFileInfo fi(file);
+        if (!fi.exists())
+            continue;
+        size += fi.size();
+        if (!lastModified.isValid() || fi.lastModified() > lastModified)
+            lastModified = fi.lastModified();
+    }
 }
 
-void StreamDetails::loadWithLibrary()
+/**
+ * @brief Reads the stream details with MediaInfo
+ * @param fileName File to read, the durations of all files are summed up for multipart items
+ */
+void StreamDetails::loadWithLibrary(const QString &fileName)
 {
     MediaInfo MI;
     MI.Option(__T("Info_Version"), __T("0.7.70;MediaElch;2"));
     MI.Option(__T("Internet"), __T("no"));
     MI.Option(__T("Complete"), __T("1"));
 
-    QString fileName = m_files.first();
-    if (m_files.count() == 1 && m_files.first().endsWith("index.bdmv")) {
-        QFileInfo fi(fileName);
-        QDir dir(fi.absolutePath() + "/STREAM");
-        QStringList files = dir.entryList(QStringList() << "*.m2ts", QDir::NoDotAndDotDot | QDir::Files, QDir::Name);
-        if (!files.isEmpty())
-            fileName = dir.absolutePath() + "/" + files.first();
-    }
-
     MI.Open(QString2MI(fileName));
 
     int duration = 0;
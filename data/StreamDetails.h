@@ -1,6 +1,7 @@
 #ifndef STREAMDETAILS_H
 #define STREAMDETAILS_H
 
+#include <QDateTime>
 #include <QMap>
 #include <QObject>
 #include "data/MediaCenterInterface.h"
@@ -16,6 +17,11 @@ class StreamDetails : public QObject
 public:
     explicit StreamDetails(QObject *parent, QStringList files);
     void loadStreamDetails();
+    void loadFromFile();
+    static bool canLoadFromFile(const QStringList &files);
+    bool hasFileDetails() const;
+    void copyFrom(StreamDetails *streamDetails);
+    static void fileState(const QStringList &files, qint64 &size, QDateTime &lastModified);
     void setVideoDetail(QString key, QString value);
     void setAudioDetail(int streamNumber, QString key, QString value);
     void setSubtitleDetail(int streamNumber, QString key, QString value);
@@ -34,7 +40,7 @@ private:
     QString videoFormat(QString format, QString version);
     QString audioFormat(const QString &codec, const QString &profile);
     QString stereoFormat(const QString &format);
-    void loadWithLibrary();
+    void loadWithLibrary(const QString &fileName);
 
     QStringList m_files;
     QMap<QString, QString> m_videoDetails;
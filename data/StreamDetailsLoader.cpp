@@ -0,0 +1,349 @@
+#include "StreamDetailsLoader.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QtCore/qmath.h>
+#include "globals/Helper.h"
+#include "globals/Manager.h"
+#include "notifications/NotificationBox.h"
+#include "settings/Settings.h"
+
+/**
+ * @brief The StreamDetailsLoaderJob class
+ * Reads the stream details of a single item in the thread pool of a StreamDetailsLoader
+ */
+class StreamDetailsLoaderJob : public QRunnable
+{
+public:
+    StreamDetailsLoaderJob(StreamDetailsLoader *loader, StreamDetailsLoader::Job job) :
+        m_loader(loader),
+        m_job(job)
+    {
+    }
+    void run()
+    {
+        m_loader->run(m_job);
+    }
+
+private:
+    StreamDetailsLoader *m_loader;
+    StreamDetailsLoader::Job m_job;
+};
+
+/**
+ * @brief StreamDetailsLoader::StreamDetailsLoader
+ * @param parent
+ */
+StreamDetailsLoader::StreamDetailsLoader(QObject *parent) :
+    QObject(parent),
+    m_jobs(Settings::instance()->advanced()->mediaInfoThreadsPerMount()),
+    m_jobsDone(0),
+    m_jobsTotal(0)
+{
+}
+
+/**
+ * @brief StreamDetailsLoader::~StreamDetailsLoader
+ */
+StreamDetailsLoader::~StreamDetailsLoader()
+{
+    abort();
+    m_jobs.waitForDone();
+    foreach (const Result &result, m_results)
+        delete result.streamDetails;
+}
+
+/**
+ * @brief Loads the stream details of movies in the background
+ * @param movies Movies to load
+ */
+void StreamDetailsLoader::load(QList<Movie*> movies)
+{
+    prepare();
+    foreach (Movie *movie, movies)
+        enqueue(movie, movie->files(), true);
+    start();
+}
+
+/**
+ * @brief Loads the stream details of concerts in the background
+ * @param concerts Concerts to load
+ */
+void StreamDetailsLoader::load(QList<Concert*> concerts)
+{
+    prepare();
+    foreach (Concert *concert, concerts)
+        enqueue(concert, concert->files(), true);
+    start();
+}
+
+/**
+ * @brief Loads the stream details of episodes in the background
+ * @param episodes Episodes to load
+ */
+void StreamDetailsLoader::load(QList<TvShowEpisode*> episodes)
+{
+    prepare();
+    foreach (TvShowEpisode *episode, episodes)
+        enqueue(episode, episode->files(), true);
+    start();
+}
+
+/**
+ * @brief Loads the stream details of all movies which don't have them yet.
+ *        Called when the movie scan has finished, does nothing unless stream details are loaded automatically.
+ *        The movies are not marked as changed, the results mainly fill the stream details cache.
+ */
+void StreamDetailsLoader::loadMovieLibrary()
+{
+    if (!Settings::instance()->autoLoadStreamDetails())
+        return;
+    prepare();
+    foreach (Movie *movie, Manager::instance()->movieModel()->movies()) {
+        if (!movie->streamDetailsLoaded())
+            enqueue(movie, movie->files(), false);
+    }
+    start();
+}
+
+/**
+ * @brief Loads the stream details of all concerts which don't have them yet
+ * @see StreamDetailsLoader::loadMovieLibrary
+ */
+void StreamDetailsLoader::loadConcertLibrary()
+{
+    if (!Settings::instance()->autoLoadStreamDetails())
+        return;
+    prepare();
+    foreach (Concert *concert, Manager::instance()->concertModel()->concerts()) {
+        if (!concert->streamDetailsLoaded())
+            enqueue(concert, concert->files(), false);
+    }
+    start();
+}
+
+/**
+ * @brief Loads the stream details of all episodes which don't have them yet, missing episodes are skipped
+ * @see StreamDetailsLoader::loadMovieLibrary
+ */
+void StreamDetailsLoader::loadTvShowLibrary()
+{
+    if (!Settings::instance()->autoLoadStreamDetails())
+        return;
+    prepare();
+    foreach (TvShow *show, Manager::instance()->tvShowModel()->tvShows()) {
+        foreach (TvShowEpisode *episode, show->episodes()) {
+            if (!episode->streamDetailsLoaded() && !episode->isDummy())
+                enqueue(episode, episode->files(), false);
+        }
+    }
+    start();
+}
+
+/**
+ * @brief Holds if items are waiting for their stream details
+ * @return True if jobs are left
+ */
+bool StreamDetailsLoader::isRunning() const
+{
+    return m_jobsDone < m_jobsTotal;
+}
+
+/**
+ * @brief Drops all jobs which were not started yet, running jobs are finished and applied
+ */
+void StreamDetailsLoader::abort()
+{
+    QMutexLocker locker(&m_mutex);
+    m_jobsTotal -= m_jobs.clear();
+    m_queuedItems.clear();
+    QMetaObject::invokeMethod(this, "onJobsFinished", Qt::QueuedConnection);
+}
+
+/**
+ * @brief Reads the cached stream details and looks up the mounts of the media directories when a new run starts
+ */
+void StreamDetailsLoader::prepare()
+{
+    if (isRunning())
+        return;
+
+    m_jobsDone = 0;
+    m_jobsTotal = 0;
+    m_cachedFiles = Manager::instance()->database()->streamDetailsFiles();
+    m_rootMounts.clear();
+    QList<SettingsDir> dirs = Settings::instance()->movieDirectories();
+    dirs << Settings::instance()->tvShowDirectories() << Settings::instance()->concertDirectories();
+    foreach (const SettingsDir &dir, dirs)
+        m_rootMounts.insert(QDir::cleanPath(dir.path), Helper::instance()->mountOf(dir.path));
+    NotificationBox::instance()->showProgressBar(tr("Loading stream details..."), Constants::StreamDetailsLoaderProgressMessageId);
+}
+
+/**
+ * @brief Reports the queued items and applies results which are already available
+ */
+void StreamDetailsLoader::start()
+{
+    NotificationBox::instance()->progressBarProgress(m_jobsDone, m_jobsTotal, Constants::StreamDetailsLoaderProgressMessageId);
+    QMetaObject::invokeMethod(this, "onJobsFinished", Qt::QueuedConnection);
+}
+
+/**
+ * @brief Adds an item to the queue of its mount, items which are already queued are skipped
+ * @param item Movie, Concert or TvShowEpisode
+ * @param files Files of the item
+ * @param markChanged Mark the item as changed when its stream details are loaded
+ */
+void StreamDetailsLoader::enqueue(QObject *item, QStringList files, bool markChanged)
+{
+    if (!StreamDetails::canLoadFromFile(files) || m_queuedItems.contains(item))
+        return;
+
+    Job job;
+    job.item = item;
+    job.files = files;
+    job.mount = mountOfFile(files.first());
+    job.markChanged = markChanged;
+    QPair<qint64, qint64> cached = m_cachedFiles.value(files.first(), qMakePair(qint64(-1), qint64(-1)));
+    job.cachedSize = cached.first;
+    job.cachedLastModified = cached.second;
+
+    QMutexLocker locker(&m_mutex);
+    m_queuedItems.insert(item);
+    m_jobsTotal++;
+    m_jobs.enqueue(job.mount, new StreamDetailsLoaderJob(this, job));
+}
+
+/**
+ * @brief Returns the mount of the media directory a file is located in.
+ *        Files outside of the media directories share one queue.
+ * @param file Path of the file
+ * @return Mount, empty if it's not known
+ */
+QString StreamDetailsLoader::mountOfFile(const QString &file) const
+{
+    QString mount;
+    int rootLength = -1;
+    QMapIterator<QString, QString> it(m_rootMounts);
+    while (it.hasNext()) {
+        it.next();
+        if (it.key().length() > rootLength && file.startsWith(it.key() + "/")) {
+            mount = it.value();
+            rootLength = it.key().length();
+        }
+    }
+    return mount;
+}
+
+/**
+ * @brief Reads the stream details of an item with MediaInfo unless the cached ones are still valid.
+ * Runs in the job queue, the database and the item are not touched here.
+ * @param job Item to load
+ */
+void StreamDetailsLoader::run(Job job)
+{
+    Result result;
+    result.item = job.item;
+    result.markChanged = job.markChanged;
+    result.file = job.files.first();
+    result.streamDetails = 0;
+    StreamDetails::fileState(job.files, result.size, result.lastModified);
+    result.cached = result.lastModified.isValid() && result.size == job.cachedSize &&
+                    result.lastModified.toMSecsSinceEpoch() == job.cachedLastModified;
+    if (!result.cached) {
+        result.streamDetails = new StreamDetails(0, job.files);
+        result.streamDetails->loadFromFile();
+        result.streamDetails->moveToThread(QCoreApplication::instance()->thread());
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_jobs.finish(job.mount);
+    m_results.enqueue(result);
+    QMetaObject::invokeMethod(this, "onJobsFinished", Qt::QueuedConnection);
+}
+
+/**
+ * @brief Applies finished jobs to their items and reports the progress
+ */
+void StreamDetailsLoader::onJobsFinished()
+{
+    m_mutex.lock();
+    QQueue<Result> results = m_results;
+    m_results.clear();
+    m_mutex.unlock();
+
+    if (!results.isEmpty()) {
+        Manager::instance()->database()->transaction();
+        foreach (const Result &result, results) {
+            apply(result);
+            m_jobsDone++;
+        }
+        Manager::instance()->database()->commit();
+        NotificationBox::instance()->progressBarProgress(m_jobsDone, m_jobsTotal, Constants::StreamDetailsLoaderProgressMessageId);
+    }
+
+    if (!isRunning()) {
+        NotificationBox::instance()->hideProgressBar(Constants::StreamDetailsLoaderProgressMessageId);
+        m_cachedFiles.clear();
+        m_rootMounts.clear();
+        m_queuedItems.clear();
+        emit sigFinished();
+    }
+}
+
+/**
+ * @brief Fills the stream details of an item and stores new ones in the database
+ * @param result Finished job
+ */
+void StreamDetailsLoader::apply(const Result &result)
+{
+    QObject *item = result.item.data();
+    m_queuedItems.remove(item);
+    Movie *movie = qobject_cast<Movie*>(item);
+    Concert *concert = qobject_cast<Concert*>(item);
+    TvShowEpisode *episode = qobject_cast<TvShowEpisode*>(item);
+
+    StreamDetails *streamDetails = 0;
+    if (movie)
+        streamDetails = movie->streamDetails();
+    else if (concert)
+        streamDetails = concert->streamDetails();
+    else if (episode)
+        streamDetails = episode->streamDetails();
+
+    if (streamDetails) {
+        streamDetails->clear();
+        if (result.cached) {
+            Manager::instance()->database()->streamDetails(streamDetails, result.file, result.size, result.lastModified);
+        } else {
+            streamDetails->copyFrom(result.streamDetails);
+            if (result.lastModified.isValid() && result.streamDetails->hasFileDetails())
+                Manager::instance()->database()->setStreamDetails(streamDetails, result.file, result.size, result.lastModified);
+        }
+
+        int runtime = qFloor(streamDetails->videoDetails().value("durationinseconds").toInt()/60);
+        if (movie) {
+            movie->setRuntime(runtime);
+            movie->setStreamDetailsLoaded(true);
+            if (result.markChanged)
+                movie->setChanged(true);
+            emit sigLoaded(movie);
+        } else if (concert) {
+            concert->setRuntime(runtime);
+            concert->setStreamDetailsLoaded(true);
+            if (result.markChanged)
+                concert->setChanged(true);
+            emit sigLoaded(concert);
+        } else if (episode) {
+            episode->setStreamDetailsLoaded(true);
+            if (result.markChanged)
+                episode->setChanged(true);
+            emit sigLoaded(episode);
+        }
+    }
+
+    delete result.streamDetails;
+}
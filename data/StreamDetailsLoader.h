@@ -0,0 +1,91 @@
+#ifndef STREAMDETAILSLOADER_H
+#define STREAMDETAILSLOADER_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QPointer>
+#include <QQueue>
+#include <QSet>
+#include <QStringList>
+
+#include "data/Concert.h"
+#include "data/MountJobQueue.h"
+#include "data/StreamDetails.h"
+#include "data/TvShowEpisode.h"
+#include "movies/Movie.h"
+
+/**
+ * @brief The StreamDetailsLoader class
+ * Loads the stream details of many items in the background. MediaInfo runs in a MountJobQueue,
+ * at most a configurable number of files per mount at a time. Results are applied to the items
+ * and written to the stream details cache of the database in the main thread.
+ * When stream details are loaded automatically, the loader fills the whole library after a scan.
+ */
+class StreamDetailsLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit StreamDetailsLoader(QObject *parent = 0);
+    ~StreamDetailsLoader();
+    void load(QList<Movie*> movies);
+    void load(QList<Concert*> concerts);
+    void load(QList<TvShowEpisode*> episodes);
+    bool isRunning() const;
+
+public slots:
+    void abort();
+    void loadMovieLibrary();
+    void loadConcertLibrary();
+    void loadTvShowLibrary();
+
+signals:
+    void sigLoaded(Movie *movie);
+    void sigLoaded(Concert *concert);
+    void sigLoaded(TvShowEpisode *episode);
+    void sigFinished();
+
+private slots:
+    void onJobsFinished();
+
+private:
+    struct Job {
+        QPointer<QObject> item;
+        QStringList files;
+        QString mount;
+        bool markChanged;
+        qint64 cachedSize;
+        qint64 cachedLastModified;
+    };
+    struct Result {
+        QPointer<QObject> item;
+        QString file;
+        qint64 size;
+        QDateTime lastModified;
+        bool markChanged;
+        bool cached;
+        StreamDetails *streamDetails;
+    };
+    friend class StreamDetailsLoaderJob;
+
+    MountJobQueue m_jobs;
+    QMutex m_mutex;
+    QMap<QString, QString> m_rootMounts;
+    QHash<QString, QPair<qint64, qint64> > m_cachedFiles;
+    QSet<QObject*> m_queuedItems;
+    QQueue<Result> m_results;
+    int m_jobsDone;
+    int m_jobsTotal;
+
+    void prepare();
+    void start();
+    void enqueue(QObject *item, QStringList files, bool markChanged);
+    QString mountOfFile(const QString &file) const;
+    void run(Job job);
+    void apply(const Result &result);
+};
+
+#endif // STREAMDETAILSLOADER_H
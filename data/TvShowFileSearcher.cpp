@@ -6,6 +6,7 @@
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QtConcurrent/QtConcurrentMap>
+#include "data/DirectoryWalker.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "data/TvShow.h"
@@ -51,21 +52,32 @@ void TvShowFileSearcher::reload(bool force)
 
     emit searchStarted(tr("Searching for TV Shows..."), m_progressMessageId);
     QList<TvShow*> dbShows;
+    QMap<int, QList<TvShowEpisode*> > dbEpisodes;
     Manager::instance()->tvShowModel()->clear();
     Manager::instance()->tvShowFilesWidget()->renewModel();
     QMap<QString, QList<QStringList> > contents;
+    QStringList scanDirs;
+    Manager::instance()->database()->resetQueryCount();
     foreach (SettingsDir dir, m_directories) {
         if (m_aborted)
             return;
 
         QList<TvShow*> showsFromDatabase = Manager::instance()->database()->shows(dir.path);
         if (dir.autoReload || force || showsFromDatabase.count() == 0) {
+            qDeleteAll(showsFromDatabase);
             Manager::instance()->database()->clearTvShows(dir.path);
-            getTvShows(dir.path, contents);
+            scanDirs << dir.path;
         } else {
             dbShows.append(showsFromDatabase);
+            QMapIterator<int, QList<TvShowEpisode*> > itEpisodes(Manager::instance()->database()->episodesOfShows(dir.path));
+            while (itEpisodes.hasNext()) {
+                itEpisodes.next();
+                dbEpisodes.insert(itEpisodes.key(), itEpisodes.value());
+            }
         }
     }
+    qDebug() << "Loaded" << dbShows.count() << "shows from the database with" << Manager::instance()->database()->queryCount() << "queries";
+    scanTvShowDirs(scanDirs, true, contents);
     emit currentDir("");
 
     emit searchStarted(tr("Loading TV Shows..."), m_progressMessageId);
@@ -78,10 +90,13 @@ void TvShowFileSearcher::reload(bool force)
     }
     it.toFront();
 
-    // Setup shows
+    // Setup shows, all new shows and episodes of this scan are written within one transaction
+    Manager::instance()->database()->transaction();
     while (it.hasNext()) {
-        if (m_aborted)
+        if (m_aborted) {
+            Manager::instance()->database()->commit();
             return;
+        }
 
         it.next();
 
@@ -106,7 +121,6 @@ void TvShowFileSearcher::reload(bool force)
         Manager::instance()->database()->add(show, path);
         TvShowModelItem *showItem = Manager::instance()->tvShowModel()->appendChild(show);
 
-        Manager::instance()->database()->transaction();
         QMap<int, TvShowModelItem*> seasonItems;
         QList<TvShowEpisode*> episodes;
 
@@ -124,19 +138,18 @@ void TvShowFileSearcher::reload(bool force)
 
         // Load episodes data
         QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
+        Manager::instance()->database()->add(episodes, path, show->databaseId());
 
         // Add episodes to model
         foreach (TvShowEpisode *episode, episodes) {
-            Manager::instance()->database()->add(episode, path, show->databaseId());
             show->addEpisode(episode);
             if (!seasonItems.contains(episode->season()))
                 seasonItems.insert(episode->season(), showItem->appendChild(episode->season(), episode->seasonString(), show));
             seasonItems.value(episode->season())->appendChild(episode);
             emit progress(++episodeCounter, episodeSum, m_progressMessageId);
         }
-
-        Manager::instance()->database()->commit();
     }
+    Manager::instance()->database()->commit();
 
     emit currentDir("");
 
@@ -149,7 +162,7 @@ void TvShowFileSearcher::reload(bool force)
         TvShowModelItem *showItem = Manager::instance()->tvShowModel()->appendChild(show);
 
         QMap<int, TvShowModelItem*> seasonItems;
-        QList<TvShowEpisode*> episodes = Manager::instance()->database()->episodes(show->databaseId());
+        QList<TvShowEpisode*> episodes = dbEpisodes.take(show->databaseId());
         QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::loadEpisodeData);
         foreach (TvShowEpisode *episode, episodes) {
             episode->setShow(show);
@@ -213,8 +226,9 @@ void TvShowFileSearcher::reloadEpisodes(QString showDir)
         path = m_directories[index].path;
 
     // search for contents
-    QList<QStringList> contents;
-    scanTvShowDir(path, showDir, contents);
+    QMap<QString, QList<QStringList> > showContents;
+    scanTvShowDirs(QStringList() << showDir, false, showContents);
+    QList<QStringList> contents = showContents.value(showDir);
     TvShow *show = new TvShow(showDir, this);
     show->loadData(Manager::instance()->mediaCenterInterfaceTvShow());
     Manager::instance()->database()->add(show, path);
@@ -241,9 +255,9 @@ void TvShowFileSearcher::reloadEpisodes(QString showDir)
     }
 
     QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
+    Manager::instance()->database()->add(episodes, path, show->databaseId());
 
     foreach (TvShowEpisode *episode, episodes) {
-        Manager::instance()->database()->add(episode, path, show->databaseId());
         show->addEpisode(episode);
         if (!seasonItems.contains(episode->season()))
             seasonItems.insert(episode->season(), showItem->appendChild(episode->season(), episode->seasonString(), show));
@@ -262,66 +276,88 @@ TvShowEpisode *TvShowFileSearcher::reloadEpisodeData(TvShowEpisode *episode)
 }
 
 /**
- * @brief Scans a dir for tv show files
- * @param path Directory to scan
- * @param contents
+ * @brief Scans tv show directories for episode files. All directories are walked in parallel.
+ * @param paths Directories to scan
+ * @param showsInSubDirs When true every subfolder of a directory is a tv show, otherwise the directories are tv shows themselves
+ * @param contents Found episode files per tv show dir, every episode is a QStringList
  */
-void TvShowFileSearcher::getTvShows(QString path, QMap<QString, QList<QStringList> > &contents)
+void TvShowFileSearcher::scanTvShowDirs(QStringList paths, bool showsInSubDirs, QMap<QString, QList<QStringList> > &contents)
 {
-    QDir dir(path);
-    QStringList tvShows = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    foreach (const QString &cDir, tvShows) {
-        if (m_aborted)
-            return;
-
-        QList<QStringList> tvShowContents;
-        scanTvShowDir(path, path + QDir::separator() + cDir, tvShowContents);
-        contents.insert(QDir::toNativeSeparators(dir.path() + QDir::separator() + cDir), tvShowContents);
+    DirectoryWalker walker(Settings::instance()->advanced()->tvShowFilters());
+    walker.setDetectDiscs(true);
+
+    // Maps every folder to walk to its tv show dir
+    QHash<QString, QString> showDirs;
+    QSet<QString> showFolders;
+    for (int i=0, n=paths.count() ; i<n ; ++i) {
+        if (!showsInSubDirs) {
+            contents.insert(paths.at(i), QList<QStringList>());
+            showDirs.insert(paths.at(i), paths.at(i));
+            showFolders.insert(paths.at(i));
+        }
+        walker.enqueue(paths.at(i), i);
     }
-}
 
-/**
- * @brief Scans the given path for tv show files.
- * Results are in a list which contains a QStringList for every episode.
- * @param startPath Scanning started at this path
- * @param path Path to scan
- * @param contents List of contents
- */
-void TvShowFileSearcher::scanTvShowDir(QString startPath, QString path, QList<QStringList> &contents)
-{
-    emit currentDir(path.mid(startPath.length()));
-
-    QDir dir(path);
-    foreach (const QString &cDir, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-        if (m_aborted)
+    DirectoryWalker::Listing listing;
+    while (walker.next(listing)) {
+        if (m_aborted) {
+            walker.abort();
             return;
+        }
 
-        // Skip "Extras" folder
-        if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0 ||
-            QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0 ||
-            QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0)
+        if (!showDirs.contains(listing.path)) {
+            foreach (const QFileInfo &fi, listing.dirs) {
+                QString showDir = QDir::toNativeSeparators(fi.filePath());
+                contents.insert(showDir, QList<QStringList>());
+                showDirs.insert(fi.filePath(), showDir);
+                showFolders.insert(fi.filePath());
+                walker.enqueue(fi.filePath(), listing.root);
+            }
             continue;
+        }
+
+        QString showDir = showDirs.value(listing.path);
 
-        // Handle DVD
-        if (Helper::instance()->isDvd(path + QDir::separator() + cDir)) {
-            contents.append(QStringList() << QDir::toNativeSeparators(path + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO"));
+        // Handle DVD and BluRay structures
+        if (!showFolders.contains(listing.path) && listing.discType == DiscDvd) {
+            contents[showDir].append(QStringList() << QDir::toNativeSeparators(listing.path + "/VIDEO_TS/VIDEO_TS.IFO"));
             continue;
         }
-        if (Helper::instance()->isDvd(path + QDir::separator() + cDir, true)) {
-            contents.append(QStringList() << QDir::toNativeSeparators(path + "/" + cDir + "/VIDEO_TS.IFO"));
+        if (!showFolders.contains(listing.path) && listing.discType == DiscBluRay) {
+            contents[showDir].append(QStringList() << QDir::toNativeSeparators(listing.path + "/BDMV/index.bdmv"));
             continue;
         }
 
-        // Handle BluRay
-        if (Helper::instance()->isBluRay(path + QDir::separator() + cDir)) {
-            contents.append(QStringList() << QDir::toNativeSeparators(path + "/" + cDir + "/BDMV/index.bdmv"));
-            continue;
+        emit currentDir(listing.path.mid(paths.at(listing.root).length()));
+
+        foreach (const QFileInfo &fi, listing.dirs) {
+            // Skip "Extras" folder
+            if (QString::compare(fi.fileName(), "Extras", Qt::CaseInsensitive) == 0 ||
+                QString::compare(fi.fileName(), ".actors", Qt::CaseInsensitive) == 0 ||
+                QString::compare(fi.fileName(), "extrafanarts", Qt::CaseInsensitive) == 0)
+                continue;
+            showDirs.insert(fi.filePath(), showDir);
+            walker.enqueue(fi.filePath(), listing.root);
         }
-        scanTvShowDir(startPath, path + "/" + cDir, contents);
+
+        QStringList files;
+        foreach (const QFileInfo &fi, listing.files)
+            files << fi.fileName();
+        addEpisodeFiles(listing.path, files, contents[showDir]);
     }
+}
 
-    QStringList files;
-    QStringList entries = getFiles(path);
+/**
+ * @brief Groups the files of a folder to episodes.
+ * Results are in a list which contains a QStringList for every episode.
+ * @param path Folder of the files
+ * @param files File names
+ * @param contents List of contents
+ */
+void TvShowFileSearcher::addEpisodeFiles(QString path, QStringList files, QList<QStringList> &contents)
+{
+    QStringList entries = files;
+    files.clear();
     foreach (const QString &file, entries) {
         // Skip Trailers and Sample files
         if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive))
@@ -361,19 +397,6 @@ void TvShowFileSearcher::scanTvShowDir(QString startPath, QString path, QList<QS
     }
 }
 
-/**
- * @brief Get a list of files in a directory
- * @param path
- * @return
- */
-QStringList TvShowFileSearcher::getFiles(QString path)
-{
-    if (Settings::instance()->advanced()->tvShowFilters().isEmpty())
-        return QStringList();
-
-    return QDir(path).entryList(Settings::instance()->advanced()->tvShowFilters(), QDir::Files | QDir::System);
-}
-
 void TvShowFileSearcher::abort()
 {
     m_aborted = true;
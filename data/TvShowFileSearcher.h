@@ -34,9 +34,8 @@ signals:
 private:
     QList<SettingsDir> m_directories;
     int m_progressMessageId;
-    void getTvShows(QString path, QMap<QString, QList<QStringList> > &contents);
-    void scanTvShowDir(QString startPath, QString path, QList<QStringList> &contents);
-    QStringList getFiles(QString path);
+    void scanTvShowDirs(QStringList paths, bool showsInSubDirs, QMap<QString, QList<QStringList> > &contents);
+    void addEpisodeFiles(QString path, QStringList files, QList<QStringList> &contents);
     bool m_aborted;
 };
 
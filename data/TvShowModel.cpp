@@ -45,6 +45,8 @@ TvShowModel::TvShowModel(QObject *parent)
     m_icons[TvShowRoles::HasCharacterArt].insert(true, QIcon(":mediaStatus/actors/green"));
     m_icons[TvShowRoles::HasBanner].insert(false, QIcon(":mediaStatus/banner/red"));
     m_icons[TvShowRoles::HasBanner].insert(true, QIcon(":mediaStatus/banner/green"));
+
+    connect(Settings::instance(), SIGNAL(sigSettingsSaved()), this, SLOT(onSettingsSaved()));
 }
 
 /**
@@ -238,6 +240,7 @@ TvShowModelItem *TvShowModel::appendChild(TvShow *show)
     TvShowModelItem *parentItem = m_rootItem;
     beginInsertRows(QModelIndex(), parentItem->childCount(), parentItem->childCount());
     TvShowModelItem *item = parentItem->appendChild(show);
+    m_sortKeys.setKeys(show, show->name());
     endInsertRows();
     connect(item, SIGNAL(sigChanged(TvShowModelItem*,TvShowModelItem*,TvShowModelItem*)), this, SLOT(onSigChanged(TvShowModelItem*,TvShowModelItem*,TvShowModelItem*)));
     connect(show, SIGNAL(sigChanged(TvShow*)), this, SLOT(onShowChanged(TvShow*)));
@@ -276,6 +279,10 @@ bool TvShowModel::removeRows(int position, int rows, const QModelIndex &parent)
     bool success = true;
 
     beginRemoveRows(parent, position, position + rows - 1);
+    if (parentItem == m_rootItem) {
+        for (int i=position ; i<position+rows && i<parentItem->childCount() ; ++i)
+            m_sortKeys.remove(parentItem->child(i)->tvShow());
+    }
     success = parentItem->removeChildren(position, rows);
     endRemoveRows();
 
@@ -300,6 +307,7 @@ void TvShowModel::clear()
 {
     beginRemoveRows(QModelIndex(), 0, m_rootItem->childCount());
     m_rootItem->removeChildren(0, m_rootItem->childCount());
+    m_sortKeys.clear();
     endRemoveRows();
 }
 
@@ -323,10 +331,29 @@ void TvShowModel::onSigChanged(TvShowModelItem *showItem, TvShowModelItem *seaso
  */
 void TvShowModel::onShowChanged(TvShow *show)
 {
+    m_sortKeys.setKeys(show, show->name());
     QModelIndex index = this->index(show->modelItem()->childNumber(), 0);
     emit dataChanged(index, index);
 }
 
+/**
+ * @brief Computes the sort keys of all tv shows again, the articles to ignore may have changed
+ */
+void TvShowModel::onSettingsSaved()
+{
+    foreach (TvShow *show, tvShows())
+        m_sortKeys.setKeys(show, show->name());
+}
+
+/**
+ * @brief Returns the precomputed sort keys of the tv shows
+ * @return Sort keys
+ */
+const SortKeyCache *TvShowModel::sortKeys() const
+{
+    return &m_sortKeys;
+}
+
 /**
  * @brief TvShowModel::tvShows
  * @return
@@ -7,6 +7,7 @@
 #include <QVariant>
 #include "data/TvShow.h"
 #include "data/TvShowEpisode.h"
+#include "globals/SortKeyCache.h"
 
 class TvShowModelItem;
 
@@ -33,10 +34,12 @@ public:
     QList<TvShow*> tvShows();
     int hasNewShowOrEpisode();
     void removeShow(TvShow *show);
+    const SortKeyCache *sortKeys() const;
 
 private slots:
     void onSigChanged(TvShowModelItem *showItem, TvShowModelItem *seasonItem, TvShowModelItem *episodeItem);
     void onShowChanged(TvShow *show);
+    void onSettingsSaved();
 
 private:
     TvShowModelItem *m_rootItem;
@@ -44,6 +47,7 @@ private:
     QIcon m_newIcon;
     QIcon m_syncIcon;
     QIcon m_missingIcon;
+    SortKeyCache m_sortKeys;
 };
 
 #endif // TVSHOWMODEL_H
@@ -112,6 +112,11 @@ bool TvShowProxyModel::lessThan(const QModelIndex &left, const QModelIndex &righ
             return true;
         if (!leftNew && rightNew)
             return false;
+
+        const SortKeyCache::SortKey *leftKey = model->sortKeys()->key(leftItem->tvShow());
+        const SortKeyCache::SortKey *rightKey = model->sortKeys()->key(rightItem->tvShow());
+        if (leftKey && rightKey)
+            return leftKey->compareTitle(*rightKey) < 0;
     }
 
     return (QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString()) < 0);
@@ -3,6 +3,7 @@
 
 #include <QFileDialog>
 #include "export/ExportTemplateLoader.h"
+#include "globals/Helper.h"
 #include "globals/Manager.h"
 
 ExportDialog::ExportDialog(QWidget *parent) :
@@ -169,6 +170,9 @@ void ExportDialog::parseAndSaveMovies(QDir dir, ExportTemplate *exportTemplate,
         if (m_canceled)
             return;
 
+        // Details read only for the export are dropped again afterwards
+        bool unloadDetails = movie->controller()->infoFromCache();
+        movie->controller()->completeFromNfo(Manager::instance()->mediaCenterInterface());
         QString movieTemplate = itemContent;
         replaceVars(movieTemplate, movie, dir, true);
         QFile file(dir.currentPath() + QString("/movies/%1.html").arg(movie->movieId()));
@@ -176,6 +180,8 @@ void ExportDialog::parseAndSaveMovies(QDir dir, ExportTemplate *exportTemplate,
             file.write(movieTemplate.toUtf8());
             file.close();
         }
+        if (unloadDetails)
+            movie->controller()->unloadDetails();
 
         QString m = listMovieItem;
         replaceVars(m, movie, dir);
@@ -537,8 +543,7 @@ void ExportDialog::replaceMultiBlock(QString &m, QString blockName, QStringList
 
 void ExportDialog::saveImage(QSize size, QString imageFile, QString destinationFile, const char *format, int quality)
 {
-    QImage img(imageFile);
-    img = img.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QImage img = Helper::instance()->getImage(imageFile, size.width(), size.height());
     img.save(destinationFile, format, quality);
 }
 
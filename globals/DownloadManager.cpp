@@ -5,6 +5,8 @@
 #include <QTimer>
 
 #include "globals/DownloadManagerElement.h"
+#include "globals/Manager.h"
+#include "settings/Settings.h"
 
 /**
  * @brief DownloadManager::DownloadManager
@@ -13,8 +15,10 @@
 DownloadManager::DownloadManager(QObject *parent) :
     QObject(parent)
 {
-    m_downloading = false;
-    connect(&m_timer, SIGNAL(timeout()), this, SLOT(downloadTimeout()));
+    m_maxDownloads = qMax(1, Settings::instance()->advanced()->downloadConnections());
+    m_maxDownloadsPerHost = qMax(1, Settings::instance()->advanced()->downloadConnectionsPerHost());
+    m_timer.setInterval(1000);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(checkTimeouts()));
 }
 
 /**
@@ -23,8 +27,7 @@ DownloadManager::DownloadManager(QObject *parent) :
  */
 QNetworkAccessManager *DownloadManager::qnam()
 {
-    static QNetworkAccessManager *qnam = new QNetworkAccessManager();
-    return qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
@@ -35,10 +38,20 @@ QNetworkAccessManager *DownloadManager::qnam()
 void DownloadManager::addDownload(DownloadManagerElement elem)
 {
     qDebug() << "Entered, url=" << elem.url;
-    if (m_queue.isEmpty())
-        QTimer::singleShot(0, this, SLOT(startNextDownload()));
+    if (m_queue.isEmpty() && m_priorityQueue.isEmpty())
+        QTimer::singleShot(0, this, SLOT(startDownloads()));
+
+    Download download;
+    download.elem = elem;
+    download.host = elem.url.host();
+    download.retries = 0;
+    download.timeout = 8000;
     m_mutex.lock();
-    m_queue.enqueue(elem);
+    if (elem.priority)
+        m_priorityQueue.enqueue(download);
+    else
+        m_queue.enqueue(download);
+    countDownload(elem);
     m_mutex.unlock();
 }
 
@@ -50,221 +63,253 @@ void DownloadManager::addDownload(DownloadManagerElement elem)
 void DownloadManager::setDownloads(QList<DownloadManagerElement> elements)
 {
     qDebug() << "Entered";
-    if (m_downloading)
-        m_currentReply->abort();
+    abortRunning();
 
-    m_timer.stop();
     m_mutex.lock();
+    m_priorityQueue.clear();
     m_queue.clear();
+    clearCounts();
     m_mutex.unlock();
 
     foreach (const DownloadManagerElement &elem, elements)
         addDownload(elem);
 
-    if (m_queue.isEmpty())
+    if (m_queue.isEmpty() && m_priorityQueue.isEmpty())
         QTimer::singleShot(0, this, SIGNAL(allDownloadsFinished()));
 }
 
 /**
- * @brief Starts the next download
+ * @brief Starts queued downloads until all connections are in use
+ * Elements of the priority queue are started first. Elements whose host has no free
+ * connection are skipped, so one slow host doesn't block the others.
  */
-void DownloadManager::startNextDownload()
+void DownloadManager::startDownloads()
 {
-    m_timer.stop();
-    if (m_currentDownloadElement.movie) {
-        int numDownloadsLeft = 0;
-        for (int i=0, n=m_queue.size() ; i<n ; ++i) {
-            if (m_queue[i].movie == m_currentDownloadElement.movie)
-                numDownloadsLeft++;
-        }
-        if (numDownloadsLeft == 0)
-            emit allDownloadsFinished(m_currentDownloadElement.movie);
+    while (m_running.count() < m_maxDownloads) {
+        if (!startDownload(m_priorityQueue) && !startDownload(m_queue))
+            break;
     }
 
-    if (m_currentDownloadElement.show) {
-        int numDownloadsLeft = 0;
-        for (int i=0, n=m_queue.size() ; i<n ; ++i) {
-            if (m_queue[i].show == m_currentDownloadElement.show)
-                numDownloadsLeft++;
-        }
-        if (numDownloadsLeft == 0)
-            emit allDownloadsFinished(m_currentDownloadElement.show);
-    }
-
-    if (m_currentDownloadElement.concert) {
-        int numDownloadsLeft = 0;
-        for (int i=0, n=m_queue.size() ; i<n ; ++i) {
-            if (m_queue[i].concert == m_currentDownloadElement.concert)
-                numDownloadsLeft++;
-        }
-        if (numDownloadsLeft == 0)
-            emit allDownloadsFinished(m_currentDownloadElement.concert);
-    }
-
-    if (m_currentDownloadElement.artist) {
-        int numDownloadsLeft = 0;
-        for (int i=0, n=m_queue.size() ; i<n ; ++i) {
-            if (m_queue[i].artist == m_currentDownloadElement.artist)
-                numDownloadsLeft++;
-        }
-        if (numDownloadsLeft == 0)
-            emit allDownloadsFinished(m_currentDownloadElement.artist);
-    }
-
-    if (m_currentDownloadElement.album) {
-        int numDownloadsLeft = 0;
-        for (int i=0, n=m_queue.size() ; i<n ; ++i) {
-            if (m_queue[i].album == m_currentDownloadElement.album)
-                numDownloadsLeft++;
-        }
-        if (numDownloadsLeft == 0)
-            emit allDownloadsFinished(m_currentDownloadElement.album);
-    }
-
-    if (m_queue.isEmpty()) {
+    if (m_running.isEmpty() && m_queue.isEmpty() && m_priorityQueue.isEmpty()) {
+        m_timer.stop();
         qDebug() << "All downloads finished";
         emit allDownloadsFinished();
-        return;
     }
+}
 
-    m_timer.start(8000);
-    m_downloading = true;
+/**
+ * @brief Starts the first element of a queue whose host has a free connection
+ * @param queue Queue to take the element from
+ * @return True if a download was started
+ */
+bool DownloadManager::startDownload(QQueue<Download> &queue)
+{
     m_mutex.lock();
-    m_currentDownloadElement = m_queue.dequeue();
-    m_mutex.unlock();
-    if (!m_currentDownloadElement.url.toString().startsWith("//")) {
-        m_currentReply = qnam()->get(QNetworkRequest(m_currentDownloadElement.url));
-        connect(m_currentReply, SIGNAL(finished()), this, SLOT(downloadFinished()));
-        connect(m_currentReply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(downloadProgress(qint64,qint64)));
-    }
-
-    if (m_currentDownloadElement.imageType == ImageType::Actor || m_currentDownloadElement.imageType == ImageType::TvShowEpisodeThumb) {
-        if (m_currentDownloadElement.movie) {
-            int numDownloadsLeft = 0;
-            m_mutex.lock();
-            for (int i=0, n=m_queue.size() ; i<n ; ++i) {
-                if (m_queue[i].movie == m_currentDownloadElement.movie)
-                    numDownloadsLeft++;
-            }
-            m_mutex.unlock();
-            emit downloadsLeft(numDownloadsLeft, m_currentDownloadElement);
-        } else if (m_currentDownloadElement.show) {
-            int numDownloadsLeft = 0;
-            m_mutex.lock();
-            for (int i=0, n=m_queue.size() ; i<n ; ++i) {
-                if (m_queue[i].show == m_currentDownloadElement.show)
-                    numDownloadsLeft++;
-            }
+    for (int i=0, n=queue.count() ; i<n ; ++i) {
+        if (m_runningPerHost.value(queue[i].host) < m_maxDownloadsPerHost || queue[i].elem.url.toString().startsWith("//")) {
+            Download download = queue.takeAt(i);
             m_mutex.unlock();
-            emit downloadsLeft(numDownloadsLeft, m_currentDownloadElement);
-        } else {
-            emit downloadsLeft(m_queue.size());
+            start(download);
+            return true;
         }
     }
+    m_mutex.unlock();
+    return false;
+}
+
+/**
+ * @brief Starts a download. Local files are read immediately.
+ * @param download Download to start
+ */
+void DownloadManager::start(Download download)
+{
+    DownloadManagerElement &elem = download.elem;
+    if (elem.imageType == ImageType::Actor || elem.imageType == ImageType::TvShowEpisodeThumb) {
+        if (elem.movie)
+            emit downloadsLeft(pendingDownloads(elem.movie)-1, elem);
+        else if (elem.show)
+            emit downloadsLeft(pendingDownloads(elem.show)-1, elem);
+        else
+            emit downloadsLeft(downloadQueueSize());
+    }
 
-    if (m_currentDownloadElement.url.toString().startsWith("//")) {
-        QFile file(m_currentDownloadElement.url.toString());
+    if (elem.url.toString().startsWith("//")) {
+        QFile file(elem.url.toString());
         QByteArray data;
         if (file.open(QIODevice::ReadOnly)) {
             data = file.readAll();
             file.close();
         }
-        m_currentDownloadElement.data = data;
-        if (m_currentDownloadElement.imageType == ImageType::Actor && !m_currentDownloadElement.movie)
-            m_currentDownloadElement.actor->image = data;
-        else if (m_currentDownloadElement.imageType == ImageType::TvShowEpisodeThumb && !m_currentDownloadElement.directDownload)
-            m_currentDownloadElement.episode->setThumbnailImage(data);
-        else
-            emit downloadFinished(m_currentDownloadElement);
-        startNextDownload();
+        elem.data = data;
+        finish(elem, false);
+        return;
     }
+
+    QNetworkReply *reply = qnam()->get(QNetworkRequest(elem.url));
+    connect(reply, SIGNAL(finished()), this, SLOT(downloadFinished()));
+    connect(reply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(downloadProgress(qint64,qint64)));
+    download.lastActivity.start();
+    m_running.insert(reply, download);
+    m_runningPerHost[download.host]++;
+    if (!m_timer.isActive())
+        m_timer.start();
 }
 
 /**
- * @brief Called by the current network reply
+ * @brief Called by a network reply
  * @param received Received bytes
  * @param total Total bytes
  */
 void DownloadManager::downloadProgress(qint64 received, qint64 total)
 {
-    m_timer.start(5000);
-    m_currentDownloadElement.bytesReceived = received;
-    m_currentDownloadElement.bytesTotal = total;
-    emit downloadProgress(m_currentDownloadElement);
+    QNetworkReply *reply = static_cast<QNetworkReply*>(QObject::sender());
+    if (!m_running.contains(reply))
+        return;
+    Download &download = m_running[reply];
+    download.timeout = 5000;
+    download.lastActivity.restart();
+    download.elem.bytesReceived = received;
+    download.elem.bytesTotal = total;
+    emit downloadProgress(download.elem);
 }
 
 /**
- * @brief Stops the current download and prepends it to the queue
+ * @brief Aborts downloads without activity and requeues them in front of their queue.
+ * Downloads are given up after 3 tries.
  */
-void DownloadManager::downloadTimeout()
+void DownloadManager::checkTimeouts()
 {
-    if (!m_downloading)
-        return;
-    qWarning() << "Download timed out" << m_currentDownloadElement.url;
-    m_retries++;
-    m_currentReply->abort();
-    m_currentReply->deleteLater();
-    if (m_retries <= 2) {
-        qDebug() << "Restarting the download";
-        m_queue.prepend(m_currentDownloadElement);
-    } else {
-        qDebug() << "Giving up on this file, tried 3 times";
-        m_retries = 0;
+    QList<QNetworkReply*> timedOut;
+    QHashIterator<QNetworkReply*, Download> it(m_running);
+    while (it.hasNext()) {
+        it.next();
+        if (it.value().lastActivity.elapsed() > it.value().timeout)
+            timedOut.append(it.key());
     }
-    startNextDownload();
+
+    foreach (QNetworkReply *reply, timedOut) {
+        Download download = m_running.take(reply);
+        m_runningPerHost[download.host]--;
+        qWarning() << "Download timed out" << download.elem.url;
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+        download.retries++;
+        if (download.retries <= 2) {
+            qDebug() << "Restarting the download";
+            download.timeout = 8000;
+            m_mutex.lock();
+            if (download.elem.priority)
+                m_priorityQueue.prepend(download);
+            else
+                m_queue.prepend(download);
+            m_mutex.unlock();
+        } else {
+            qDebug() << "Giving up on this file, tried 3 times";
+            finish(download.elem, false);
+        }
+    }
+
+    if (!timedOut.isEmpty())
+        startDownloads();
 }
 
 /**
- * @brief Called by the current network reply
- * Starts the next download if there is one
+ * @brief Called by a network reply
+ * Starts the next downloads if there are any
  */
 void DownloadManager::downloadFinished()
 {
     qDebug() << "Entered";
 
     QNetworkReply *reply = static_cast<QNetworkReply*>(QObject::sender());
+    reply->deleteLater();
+    if (!m_running.contains(reply))
+        return;
+    Download download = m_running.take(reply);
+
     if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 302 ||
         reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 301) {
-        reply->deleteLater();
-        m_currentReply = qnam()->get(QNetworkRequest(reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl()));
-        connect(m_currentReply, SIGNAL(finished()), this, SLOT(downloadFinished()));
-        connect(m_currentReply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(downloadProgress(qint64,qint64)));
+        QNetworkReply *redirect = qnam()->get(QNetworkRequest(reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl()));
+        connect(redirect, SIGNAL(finished()), this, SLOT(downloadFinished()));
+        connect(redirect, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(downloadProgress(qint64,qint64)));
+        download.lastActivity.restart();
+        m_running.insert(redirect, download);
         return;
     }
 
-    m_downloading = false;
-    m_retries = 0;
+    m_runningPerHost[download.host]--;
     QByteArray data;
-    if (m_currentReply->error() != QNetworkReply::NoError) {
-        qWarning() << "Network Error" << m_currentReply->errorString();
-    } else {
-        data = m_currentReply->readAll();
-    }
-    m_currentDownloadElement.data = data;
-    reply->deleteLater();
-    if (m_currentDownloadElement.imageType == ImageType::Actor && !m_currentDownloadElement.movie)
-        m_currentDownloadElement.actor->image = data;
-    else if (m_currentDownloadElement.imageType == ImageType::TvShowEpisodeThumb && !m_currentDownloadElement.directDownload)
-        m_currentDownloadElement.episode->setThumbnailImage(data);
+    if (reply->error() != QNetworkReply::NoError)
+        qWarning() << "Network Error" << reply->errorString();
+    else
+        data = reply->readAll();
+    download.elem.data = data;
+    finish(download.elem, true);
+    startDownloads();
+}
+
+/**
+ * @brief Hands a finished element to its receivers and reports items without downloads left
+ * @param elem Finished element
+ * @param downloaded True if the element was loaded by a network reply
+ */
+void DownloadManager::finish(DownloadManagerElement elem, bool downloaded)
+{
+    m_mutex.lock();
+    uncountDownload(elem);
+    m_mutex.unlock();
+
+    if (elem.imageType == ImageType::Actor && !elem.movie)
+        elem.actor->image = elem.data;
+    else if (elem.imageType == ImageType::TvShowEpisodeThumb && !elem.directDownload)
+        elem.episode->setThumbnailImage(elem.data);
     else
-        emit downloadFinished(m_currentDownloadElement);
-    emit sigElemDownloaded(m_currentDownloadElement);
-    startNextDownload();
+        emit downloadFinished(elem);
+    if (downloaded)
+        emit sigElemDownloaded(elem);
+
+    if (elem.movie && pendingDownloads(elem.movie) == 0)
+        emit allDownloadsFinished(elem.movie);
+    if (elem.show && pendingDownloads(elem.show) == 0)
+        emit allDownloadsFinished(elem.show);
+    if (elem.concert && pendingDownloads(elem.concert) == 0)
+        emit allDownloadsFinished(elem.concert);
+    if (elem.artist && pendingDownloads(elem.artist) == 0)
+        emit allDownloadsFinished(elem.artist);
+    if (elem.album && pendingDownloads(elem.album) == 0)
+        emit allDownloadsFinished(elem.album);
+}
+
+/**
+ * @brief Aborts all running downloads, their elements are dropped
+ */
+void DownloadManager::abortRunning()
+{
+    m_timer.stop();
+    QHashIterator<QNetworkReply*, Download> it(m_running);
+    while (it.hasNext()) {
+        it.next();
+        it.key()->disconnect(this);
+        it.key()->abort();
+        it.key()->deleteLater();
+    }
+    m_running.clear();
+    m_runningPerHost.clear();
 }
 
 /**
- * @brief Aborts the current download and clears the queue
+ * @brief Aborts the current downloads and clears the queue
  */
 void DownloadManager::abortDownloads()
 {
     qDebug() << "Entered";
-    m_timer.stop();
     m_mutex.lock();
+    m_priorityQueue.clear();
     m_queue.clear();
+    clearCounts();
     m_mutex.unlock();
-    if (m_downloading) {
-        m_currentReply->abort();
-    }
+    abortRunning();
 }
 
 /**
@@ -273,16 +318,16 @@ void DownloadManager::abortDownloads()
  */
 bool DownloadManager::isDownloading()
 {
-    return m_downloading;
+    return !m_running.isEmpty();
 }
 
 /**
- * @brief Returns the number of elements in queue
- * @return Number of elements in queue
+ * @brief Returns the number of elements which are queued or being downloaded
+ * @return Number of elements left
  */
 int DownloadManager::downloadQueueSize()
 {
-    return m_queue.size();
+    return m_queue.size() + m_priorityQueue.size() + m_running.size();
 }
 
 /**
@@ -292,14 +337,147 @@ int DownloadManager::downloadQueueSize()
  */
 int DownloadManager::downloadsLeftForShow(TvShow *show)
 {
-    qDebug() << "Entered, show=" << show->name();
-    int left = 0;
-    m_mutex.lock();
-    for (int i=0, n=m_queue.count() ; i<n ; ++i) {
-        if (m_queue[i].show == show)
-            left++;
+    return pendingDownloads(show);
+}
+
+/**
+ * @brief Returns the number of queued and running downloads of a movie
+ * @param movie Movie
+ * @return Number of downloads left
+ */
+int DownloadManager::pendingDownloads(Movie *movie) const
+{
+    return m_pendingPerItem.value(movie);
+}
+
+/**
+ * @brief Returns the number of queued and running downloads of a tv show
+ * @param show Tv show
+ * @return Number of downloads left
+ */
+int DownloadManager::pendingDownloads(TvShow *show) const
+{
+    return m_pendingPerItem.value(show);
+}
+
+/**
+ * @brief Returns the number of queued and running downloads of a concert
+ * @param concert Concert
+ * @return Number of downloads left
+ */
+int DownloadManager::pendingDownloads(Concert *concert) const
+{
+    return m_pendingPerItem.value(concert);
+}
+
+/**
+ * @brief Returns the number of queued and running downloads of an artist
+ * @param artist Artist
+ * @return Number of downloads left
+ */
+int DownloadManager::pendingDownloads(Artist *artist) const
+{
+    return m_pendingPerItem.value(artist);
+}
+
+/**
+ * @brief Returns the number of queued and running downloads of an album
+ * @param album Album
+ * @return Number of downloads left
+ */
+int DownloadManager::pendingDownloads(Album *album) const
+{
+    return m_pendingPerItem.value(album);
+}
+
+/**
+ * @brief Returns the number of downloads of a movie since it had no downloads left
+ * @param movie Movie
+ * @return Number of downloads, finished and left ones
+ */
+int DownloadManager::totalDownloads(Movie *movie) const
+{
+    return m_totalPerItem.value(movie);
+}
+
+/**
+ * @brief Returns the number of downloads of a tv show since it had no downloads left
+ * @param show Tv show
+ * @return Number of downloads, finished and left ones
+ */
+int DownloadManager::totalDownloads(TvShow *show) const
+{
+    return m_totalPerItem.value(show);
+}
+
+/**
+ * @brief Returns the number of downloads of a concert since it had no downloads left
+ * @param concert Concert
+ * @return Number of downloads, finished and left ones
+ */
+int DownloadManager::totalDownloads(Concert *concert) const
+{
+    return m_totalPerItem.value(concert);
+}
+
+/**
+ * @brief Returns the number of downloads of an artist since it had no downloads left
+ * @param artist Artist
+ * @return Number of downloads, finished and left ones
+ */
+int DownloadManager::totalDownloads(Artist *artist) const
+{
+    return m_totalPerItem.value(artist);
+}
+
+/**
+ * @brief Returns the number of downloads of an album since it had no downloads left
+ * @param album Album
+ * @return Number of downloads, finished and left ones
+ */
+int DownloadManager::totalDownloads(Album *album) const
+{
+    return m_totalPerItem.value(album);
+}
+
+/**
+ * @brief Counts a queued element for all items it belongs to
+ * Must be called with the mutex locked.
+ * @param elem Queued element
+ */
+void DownloadManager::countDownload(const DownloadManagerElement &elem)
+{
+    QList<QObject*> items;
+    items << elem.movie << elem.show << elem.concert << elem.artist << elem.album;
+    foreach (QObject *item, items) {
+        if (!item)
+            continue;
+        m_pendingPerItem[item]++;
+        m_totalPerItem[item]++;
     }
-    m_mutex.unlock();
-    qDebug() << "Downloads left" << left;
-    return left;
+}
+
+/**
+ * @brief Removes a finished element from the counts of all items it belongs to
+ * Must be called with the mutex locked.
+ * @param elem Finished element
+ */
+void DownloadManager::uncountDownload(const DownloadManagerElement &elem)
+{
+    QList<QObject*> items;
+    items << elem.movie << elem.show << elem.concert << elem.artist << elem.album;
+    foreach (QObject *item, items) {
+        if (!item || !m_pendingPerItem.contains(item))
+            continue;
+        if (--m_pendingPerItem[item] <= 0) {
+            m_pendingPerItem.remove(item);
+            m_totalPerItem.remove(item);
+        }
+    }
+}
+
+void DownloadManager::clearCounts()
+{
+    m_pendingPerItem.clear();
+    m_totalPerItem.clear();
 }
@@ -1,6 +1,8 @@
 #ifndef DOWNLOADMANAGER_H
 #define DOWNLOADMANAGER_H
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMutex>
 #include <QQueue>
 #include <QObject>
@@ -17,6 +19,10 @@
 
 /**
  * @brief The DownloadManager class
+ * Downloads several elements at once, limited overall and per host by the advanced settings.
+ * Elements marked as priority are started before all others.
+ * The queued and running downloads are counted per item, so the progress of an item
+ * can be queried without looking at the queue.
  */
 class DownloadManager : public QObject
 {
@@ -29,6 +35,16 @@ public:
     bool isDownloading();
     int downloadQueueSize();
     int downloadsLeftForShow(TvShow *show);
+    int pendingDownloads(Movie *movie) const;
+    int pendingDownloads(TvShow *show) const;
+    int pendingDownloads(Concert *concert) const;
+    int pendingDownloads(Artist *artist) const;
+    int pendingDownloads(Album *album) const;
+    int totalDownloads(Movie *movie) const;
+    int totalDownloads(TvShow *show) const;
+    int totalDownloads(Concert *concert) const;
+    int totalDownloads(Artist *artist) const;
+    int totalDownloads(Album *album) const;
 
 signals:
     void downloadProgress(DownloadManagerElement);
@@ -46,18 +62,37 @@ signals:
 private slots:
     void downloadProgress(qint64 received, qint64 total);
     void downloadFinished();
-    void startNextDownload();
-    void downloadTimeout();
+    void startDownloads();
+    void checkTimeouts();
 
 private:
-    QNetworkReply *m_currentReply;
-    DownloadManagerElement m_currentDownloadElement;
-    QQueue<DownloadManagerElement> m_queue;
+    struct Download {
+        DownloadManagerElement elem;
+        QString host;
+        int retries;
+        int timeout;
+        QElapsedTimer lastActivity;
+    };
+
+    QQueue<Download> m_priorityQueue;
+    QQueue<Download> m_queue;
+    QHash<QNetworkReply*, Download> m_running;
+    QHash<QString, int> m_runningPerHost;
+    QHash<QObject*, int> m_pendingPerItem;
+    QHash<QObject*, int> m_totalPerItem;
+    int m_maxDownloads;
+    int m_maxDownloadsPerHost;
     QNetworkAccessManager *qnam();
-    bool m_downloading;
     QMutex m_mutex;
     QTimer m_timer;
-    int m_retries;
+
+    bool startDownload(QQueue<Download> &queue);
+    void start(Download download);
+    void finish(DownloadManagerElement elem, bool downloaded);
+    void abortRunning();
+    void countDownload(const DownloadManagerElement &elem);
+    void uncountDownload(const DownloadManagerElement &elem);
+    void clearCounts();
 };
 
 #endif // DOWNLOADMANAGER_H
@@ -6,5 +6,9 @@ DownloadManagerElement::DownloadManagerElement()
     episode = 0;
     show = 0;
     concert = 0;
+    album = 0;
+    artist = 0;
+    actor = 0;
     directDownload = false;
+    priority = false;
 }
@@ -31,6 +31,7 @@ public:
     Artist *artist;
     int season;
     bool directDownload;
+    bool priority;
 };
 
 #endif // DOWNLOADMANAGERELEMENT_H
@@ -0,0 +1,110 @@
+#include "FacetCounts.h"
+
+/**
+ * @brief FacetCounts::FacetCounts
+ */
+FacetCounts::FacetCounts() :
+    m_revision(0)
+{
+}
+
+/**
+ * @brief Sets the facet values of an item, the counts of its previous values are decreased
+ * @param item Item of the model
+ * @param values Facet values of the item
+ */
+void FacetCounts::setValues(const void *item, const Values &values)
+{
+    QHash<const void*, Values>::iterator it = m_values.find(item);
+    if (it != m_values.end()) {
+        if (it.value() == values)
+            return;
+        count(it.value(), -1);
+        it.value() = values;
+    } else {
+        m_values.insert(item, values);
+    }
+    count(values, 1);
+    m_revision++;
+}
+
+/**
+ * @brief Removes an item, the counts of its values are decreased
+ * @param item Item of the model
+ */
+void FacetCounts::remove(const void *item)
+{
+    QHash<const void*, Values>::iterator it = m_values.find(item);
+    if (it == m_values.end())
+        return;
+    count(it.value(), -1);
+    m_values.erase(it);
+    m_revision++;
+}
+
+/**
+ * @brief Removes all items
+ */
+void FacetCounts::clear()
+{
+    m_counts.clear();
+    m_values.clear();
+    m_revision++;
+}
+
+/**
+ * @brief Returns the values of a facet
+ * @param facet Facet
+ * @return Number of items per value, values no item has are not contained
+ */
+QHash<QString, int> FacetCounts::counts(int facet) const
+{
+    return m_counts.value(facet);
+}
+
+/**
+ * @brief The revision is increased each time a count has changed
+ * @return Revision
+ */
+int FacetCounts::revision() const
+{
+    return m_revision;
+}
+
+/**
+ * @brief Adds a value of a facet, empty values and values already contained are skipped
+ * @param values Facet values of an item
+ * @param facet Facet
+ * @param value Value to add
+ */
+void FacetCounts::addValue(Values &values, int facet, const QString &value)
+{
+    if (value.isEmpty() || values.contains(qMakePair(facet, value)))
+        return;
+    values.append(qMakePair(facet, value));
+}
+
+/**
+ * @brief Adds several values of a facet
+ * @param values Facet values of an item
+ * @param facet Facet
+ * @param facetValues Values to add
+ * @see FacetCounts::addValue
+ */
+void FacetCounts::addValues(Values &values, int facet, const QStringList &facetValues)
+{
+    foreach (const QString &value, facetValues)
+        addValue(values, facet, value);
+}
+
+void FacetCounts::count(const Values &values, int diff)
+{
+    for (int i=0, n=values.count() ; i<n ; ++i) {
+        QHash<QString, int> &facetCounts = m_counts[values.at(i).first];
+        int count = facetCounts.value(values.at(i).second) + diff;
+        if (count > 0)
+            facetCounts.insert(values.at(i).second, count);
+        else
+            facetCounts.remove(values.at(i).second);
+    }
+}
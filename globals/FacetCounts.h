@@ -0,0 +1,39 @@
+#ifndef FACETCOUNTS_H
+#define FACETCOUNTS_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The FacetCounts class
+ * Counts how many items of a model have a value of a facet (e.g. how many movies have the genre "Action").
+ * Models update the values of an item when it is added or has changed, so the filter widget
+ * can list the values of a facet without walking all items.
+ * Facets are identified by the filter info they belong to (e.g. MovieFilters::Genres).
+ */
+class FacetCounts
+{
+public:
+    typedef QList<QPair<int, QString> > Values;
+
+    FacetCounts();
+    void setValues(const void *item, const Values &values);
+    void remove(const void *item);
+    void clear();
+    QHash<QString, int> counts(int facet) const;
+    int revision() const;
+    static void addValue(Values &values, int facet, const QString &value);
+    static void addValues(Values &values, int facet, const QStringList &facetValues);
+
+private:
+    QHash<int, QHash<QString, int> > m_counts;
+    QHash<const void*, Values> m_values;
+    int m_revision;
+
+    void count(const Values &values, int diff);
+};
+
+#endif // FACETCOUNTS_H
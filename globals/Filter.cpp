@@ -1,5 +1,7 @@
 #include "Filter.h"
 
+#include "globals/Manager.h"
+
 /**
  * @brief Filter::Filter
  * @param text Text displayed in the list of filters
@@ -16,6 +18,7 @@ Filter::Filter(QString text, QString shortText, QStringList filterText, int info
     m_info = info;
     m_hasInfo = hasInfo;
     m_data = data;
+    m_searchRevision = -1;
 }
 
 /**
@@ -27,6 +30,8 @@ bool Filter::accepts(QString text) const
 {
     if (m_info == MovieFilters::Title || (m_info == MovieFilters::ImdbId && m_hasInfo) || m_info == MovieFilters::Path || m_info == TvShowFilters::Title || m_info == ConcertFilters::Title)
         return true;
+    if ((m_info == MovieFilters::FullText || m_info == ConcertFilters::FullText) && Manager::instance()->database()->hasSearchIndex())
+        return true;
     foreach (const QString &filterText, m_filterText) {
         if (filterText.startsWith(text, Qt::CaseInsensitive))
             return true;
@@ -48,6 +53,15 @@ bool Filter::hasInfo() const
     return m_hasInfo;
 }
 
+/**
+ * @brief Additional data of the filter, e.g. the color of a label filter
+ * @return Filter data
+ */
+int Filter::data() const
+{
+    return m_data;
+}
+
 /**
  * @brief Sets the filter text
  * @param text Text to set
@@ -98,7 +112,7 @@ bool Filter::accepts(Movie *movie)
     if (m_info == MovieFilters::ExtraFanarts)
         return (m_hasInfo && movie->hasExtraFanarts()) || (!m_hasInfo && !movie->hasExtraFanarts());
     if (m_info == MovieFilters::Actors)
-        return (m_hasInfo && !movie->actors().isEmpty()) || (!m_hasInfo && movie->actors().isEmpty());
+        return (m_hasInfo && movie->hasActors()) || (!m_hasInfo && !movie->hasActors());
     if (m_info == MovieFilters::Logo)
         return (m_hasInfo && movie->hasImage(ImageType::MovieLogo)) || (!m_hasInfo && !movie->hasImage(ImageType::MovieLogo));
     if (m_info == MovieFilters::ClearArt)
@@ -186,6 +200,9 @@ bool Filter::accepts(Movie *movie)
     if (m_info == MovieFilters::Label)
         return movie->label() == m_data;
 
+    if (m_info == MovieFilters::FullText)
+        return acceptsSearch(movie->databaseId(), false);
+
     return true;
 }
 
@@ -217,5 +234,32 @@ bool Filter::accepts(Concert *concert)
 {
     if (m_info == ConcertFilters::Title)
         return concert->name().contains(m_shortText, Qt::CaseInsensitive);
+    if (m_info == ConcertFilters::FullText)
+        return acceptsSearch(concert->databaseId(), true);
+    if (m_info == ConcertFilters::Genres)
+        return concert->genres().contains(m_shortText);
+    if (m_info == ConcertFilters::Tags)
+        return concert->tags().contains(m_shortText);
     return true;
 }
+
+/**
+ * @brief Checks if an item is found by the full text search for the short text.
+ *        The search is run once and repeated only if the text or the search index have changed.
+ * @param databaseId Database id of the item
+ * @param concerts Search concerts instead of movies
+ * @return True if the item was found
+ */
+bool Filter::acceptsSearch(int databaseId, bool concerts)
+{
+    if (m_shortText.isEmpty())
+        return true;
+
+    Database *database = Manager::instance()->database();
+    if (m_searchText != m_shortText || m_searchRevision != database->searchRevision()) {
+        m_searchResults = concerts ? database->searchConcerts(m_shortText) : database->searchMovies(m_shortText);
+        m_searchText = m_shortText;
+        m_searchRevision = database->searchRevision();
+    }
+    return m_searchResults.contains(databaseId);
+}
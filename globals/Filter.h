@@ -2,6 +2,7 @@
 #define FILTER_H
 
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include "data/Concert.h"
@@ -27,6 +28,7 @@ public:
     void setShortText(QString shortText);
     void setText(QString text);
     bool hasInfo() const;
+    int data() const;
 
 private:
     QString m_text;
@@ -35,6 +37,11 @@ private:
     int m_info;
     bool m_hasInfo;
     int m_data;
+    QString m_searchText;
+    int m_searchRevision;
+    QSet<int> m_searchResults;
+
+    bool acceptsSearch(int databaseId, bool concerts);
 };
 
 Q_DECLARE_METATYPE(Filter*)
@@ -19,6 +19,7 @@ namespace Constants {
     const int ConcertFileSearcherProgressMessageId = 10005;
     const int TvShowUpdaterProgressMessageId       = 10006;
     const int MusicFileSearcherProgressMessageId   = 10007;
+    const int StreamDetailsLoaderProgressMessageId = 10008;
     const int MovieProgressMessageId               = 20000;
     const int TvShowProgressMessageId              = 40000;
     const int EpisodeProgressMessageId             = 60000;
@@ -349,6 +350,7 @@ namespace MovieFilters {
     const int AudioQuality        = 31;
     const int HasSubtitle         = 33;
     const int HasExternalSubtitle = 34;
+    const int FullText            = 35;
 }
 
 namespace TvShowFilters {
@@ -357,6 +359,9 @@ namespace TvShowFilters {
 
 namespace ConcertFilters {
     const int Title         = 27;
+    const int FullText      = 36;
+    const int Genres        = 37;
+    const int Tags          = 38;
 }
 
 namespace MusicFilters {
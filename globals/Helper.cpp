@@ -8,6 +8,7 @@
 #include <QDoubleSpinBox>
 #include <QFile>
 #include <QGraphicsDropShadowEffect>
+#include <QImageReader>
 #include <QLabel>
 #include <QLineEdit>
 #include <QListWidget>
@@ -15,6 +16,9 @@
 #include <QPushButton>
 #include <QRegExp>
 #include <QSpinBox>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+#include <QStorageInfo>
+#endif
 #include <QWidget>
 #include "globals/Globals.h"
 #include "settings/Settings.h"
@@ -800,6 +804,93 @@ QImage Helper::getImage(QString path)
     return img;
 }
 
+/**
+ * @brief Loads an image at the size it's shown at. The image is decoded directly at the target size
+ *        where the format supports it (JPEG uses DCT scaling), so large images are never decoded completely.
+ * @param path Path of the image
+ * @param width Width to scale to, 0 to keep the aspect ratio
+ * @param height Height to scale to, 0 to keep the aspect ratio. If both are 0 the image is not scaled.
+ * @param origSize If set, receives the size of the original image
+ * @return Scaled image
+ */
+QImage Helper::getImage(QString path, int width, int height, QSize *origSize)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (origSize)
+            *origSize = QSize();
+        return QImage();
+    }
+    return readScaledImage(&file, width, height, origSize);
+}
+
+/**
+ * @brief Loads an image from data at the size it's shown at
+ * @param data Image data
+ * @param width Width to scale to, 0 to keep the aspect ratio
+ * @param height Height to scale to, 0 to keep the aspect ratio. If both are 0 the image is not scaled.
+ * @param origSize If set, receives the size of the original image
+ * @return Scaled image
+ * @see Helper::getImage(QString, int, int, QSize*)
+ */
+QImage Helper::getImage(const QByteArray &data, int width, int height, QSize *origSize)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return readScaledImage(&buffer, width, height, origSize);
+}
+
+/**
+ * @brief Reads the size of an image from its header without decoding it
+ * @param data Image data
+ * @return Size of the image
+ */
+QSize Helper::imageSize(const QByteArray &data)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    QSize size = reader.size();
+    if (!size.isValid())
+        size = QImage::fromData(data).size();
+    return size;
+}
+
+QImage Helper::readScaledImage(QIODevice *device, int width, int height, QSize *origSize)
+{
+    QImageReader reader(device);
+    QSize size = reader.size();
+    if (!size.isValid()) {
+        // The format can't tell its size without decoding, scale afterwards
+        device->seek(0);
+        QImage img = QImage::fromData(device->readAll());
+        if (origSize)
+            *origSize = img.size();
+        if (width != 0 && height != 0)
+            return img.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        else if (width != 0)
+            return img.scaledToWidth(width, Qt::SmoothTransformation);
+        else if (height != 0)
+            return img.scaledToHeight(height, Qt::SmoothTransformation);
+        return img;
+    }
+
+    if (origSize)
+        *origSize = size;
+    QSize scaledSize = size;
+    if (width != 0 && height != 0)
+        scaledSize.scale(width, height, Qt::KeepAspectRatio);
+    else if (width != 0)
+        scaledSize = QSize(width, qMax(1, qRound(qreal(size.height())*width/size.width())));
+    else if (height != 0)
+        scaledSize = QSize(qMax(1, qRound(qreal(size.width())*height/size.height())), height);
+    if (scaledSize != size)
+        reader.setScaledSize(scaledSize);
+    return reader.read();
+}
+
 QString Helper::secondsToTimeCode(quint32 duration)
 {
     QString res;
@@ -815,3 +906,20 @@ QString Helper::secondsToTimeCode(quint32 duration)
         return res.sprintf("%02d:%02d:%02d", hours, minutes, seconds);
     return res.sprintf("%dd%02d:%02d:%02d", days, hours, minutes, seconds);
 }
+
+/**
+ * @brief Returns the root path of the mount a path is located on
+ * @param path Path
+ * @return Mount root, an empty string if it can't be determined
+ */
+QString Helper::mountOf(QString path)
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+    QStorageInfo storage(path);
+    if (storage.isValid())
+        return storage.rootPath();
+#else
+    Q_UNUSED(path);
+#endif
+    return QString();
+}
@@ -3,6 +3,7 @@
 
 #include <QComboBox>
 #include <QImage>
+#include <QIODevice>
 #include <QLabel>
 #include <QObject>
 #include <QPushButton>
@@ -56,7 +57,14 @@ public:
     virtual QMap<QString, QString> stereoModes();
     virtual QString matchResolution(int width, int height, const QString &scanType);
     virtual QImage getImage(QString path);
+    virtual QImage getImage(QString path, int width, int height, QSize *origSize = 0);
+    virtual QImage getImage(const QByteArray &data, int width, int height, QSize *origSize = 0);
+    virtual QSize imageSize(const QByteArray &data);
     virtual QString secondsToTimeCode(quint32 duration);
+    virtual QString mountOf(QString path);
+
+private:
+    QImage readScaledImage(QIODevice *device, int width, int height, QSize *origSize);
 };
 
 #endif // HELPER_H
@@ -304,7 +304,7 @@ void ImageDialog::setDownloads(QList<Poster> downloads, bool initial)
  */
 QNetworkAccessManager *ImageDialog::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
@@ -95,7 +95,6 @@ private:
         QString hint;
     };
 
-    QNetworkAccessManager m_qnam;
     int m_currentDownloadIndex;
     QNetworkReply *m_currentDownloadReply;
     int m_imageType;
@@ -4,6 +4,7 @@
 #include <QDesktopServices>
 #include <QSqlQuery>
 #include "globals/Globals.h"
+#include "globals/NetworkCache.h"
 #include "imageProviders/Coverlib.h"
 #include "imageProviders/FanartTv.h"
 #include "imageProviders/FanartTvMusic.h"
@@ -53,6 +54,10 @@ Manager::Manager(QObject *parent) :
     m_concertModel = new ConcertModel(this);
     m_musicModel = new MusicModel(this);
     m_database = new Database(this);
+    m_streamDetailsLoader = new StreamDetailsLoader(this);
+    connect(m_movieFileSearcher, SIGNAL(moviesLoaded(int)), m_streamDetailsLoader, SLOT(loadMovieLibrary()));
+    connect(m_tvShowFileSearcher, SIGNAL(tvShowsLoaded(int)), m_streamDetailsLoader, SLOT(loadTvShowLibrary()));
+    connect(m_concertFileSearcher, SIGNAL(concertsLoaded(int)), m_streamDetailsLoader, SLOT(loadConcertLibrary()));
 
     m_mediaCenters.append(new XbmcXml(this));
     m_mediaCentersTvShow.append(new XbmcXml(this));
@@ -102,6 +107,21 @@ Manager* Manager::instance()
     return m_instance;
 }
 
+/**
+ * @brief Returns the network access manager of the scrapers and image providers
+ * All of them share one disk cache, so repeated requests are answered from the cache.
+ * @return Network access manager
+ */
+QNetworkAccessManager *Manager::networkAccessManager()
+{
+    static QNetworkAccessManager *qnam = 0;
+    if (qnam == 0) {
+        qnam = new QNetworkAccessManager(qApp);
+        qnam->setCache(new NetworkCache(qnam));
+    }
+    return qnam;
+}
+
 /**
  * @brief Returns the active MediaCenterInterface
  * @return Instance of a MediaCenterInterface
@@ -286,6 +306,15 @@ Database *Manager::database()
     return m_database;
 }
 
+/**
+ * @brief Manager::streamDetailsLoader
+ * @return
+ */
+StreamDetailsLoader *Manager::streamDetailsLoader()
+{
+    return m_streamDetailsLoader;
+}
+
 /**
  * @brief Manager::setTvShowFilesWidget
  * @param widget
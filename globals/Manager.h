@@ -1,6 +1,7 @@
 #ifndef MANAGER_H
 #define MANAGER_H
 
+#include <QNetworkAccessManager>
 #include <QObject>
 #include "settings/Settings.h"
 #include "data/ConcertFileSearcher.h"
@@ -12,6 +13,7 @@
 #include "data/MovieFileSearcher.h"
 #include "data/MusicScraperInterface.h"
 #include "data/ScraperInterface.h"
+#include "data/StreamDetailsLoader.h"
 #include "data/TvScraperInterface.h"
 #include "data/TvShowFileSearcher.h"
 #include "data/MovieModel.h"
@@ -56,6 +58,7 @@ public:
     ConcertFileSearcher* concertFileSearcher();
     MusicFileSearcher* musicFileSearcher();
     Database* database();
+    StreamDetailsLoader* streamDetailsLoader();
     MovieModel* movieModel();
     TvShowModel* tvShowModel();
     TvShowProxyModel *tvShowProxyModel();
@@ -71,6 +74,7 @@ public:
     void setMusicFilesWidget(MusicFilesWidget *widget);
     void setFileScannerDialog(FileScannerDialog *dialog);
     static QList<ScraperInterface*> constructNativeScrapers(QObject *parent);
+    static QNetworkAccessManager *networkAccessManager();
 
 private:
     QList<MediaCenterInterface*> m_mediaCenters;
@@ -92,6 +96,7 @@ private:
     MusicModel* m_musicModel;
     Settings *m_settings;
     Database *m_database;
+    StreamDetailsLoader *m_streamDetailsLoader;
     TvShowFilesWidget *m_tvShowFilesWidget;
     MusicFilesWidget *m_musicFilesWidget;
     FileScannerDialog *m_fileScannerDialog;
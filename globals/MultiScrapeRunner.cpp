@@ -0,0 +1,220 @@
+#include "MultiScrapeRunner.h"
+
+#include <QDebug>
+#include <QTimer>
+#include "settings/Settings.h"
+
+/**
+ * @brief MultiScrapeRunner::MultiScrapeRunner
+ * @param parent
+ */
+MultiScrapeRunner::MultiScrapeRunner(QObject *parent) :
+    QObject(parent),
+    m_running(false),
+    m_jobsScheduled(false),
+    m_concurrency(1),
+    m_done(0),
+    m_scraped(0),
+    m_searchingItem(0)
+{
+}
+
+/**
+ * @brief Starts running the items, the number of items in progress is taken from the advanced settings
+ * @param items Items to scrape
+ */
+void MultiScrapeRunner::start(QList<QObject*> items)
+{
+    if (m_running)
+        return;
+
+    m_concurrency = qMax(1, Settings::instance()->advanced()->multiScrapeConcurrency());
+    m_queue.clear();
+    m_queue.append(items);
+    m_done = 0;
+    m_scraped = 0;
+    m_running = true;
+    m_elapsed.start();
+    qDebug() << "Scraping" << items.count() << "items," << m_concurrency << "at the same time";
+    scheduleJobs(0);
+}
+
+/**
+ * @brief Stops running, items in progress are dropped without sigItemDone
+ */
+void MultiScrapeRunner::abort()
+{
+    m_running = false;
+    m_queue.clear();
+    m_active.clear();
+    m_searchQueue.clear();
+    m_loadQueue.clear();
+    m_searchingItem = 0;
+}
+
+bool MultiScrapeRunner::isRunning() const
+{
+    return m_running;
+}
+
+/**
+ * @brief Queues the search of an item, sigStartSearch is emitted when it may be started
+ * @param item Item in progress
+ * @param scraper Identifier of the scraper which searches
+ */
+void MultiScrapeRunner::requestSearch(QObject *item, const QString &scraper)
+{
+    if (!m_running || !m_active.contains(item))
+        return;
+    Request request;
+    request.item = item;
+    request.scraper = scraper;
+    m_searchQueue.enqueue(request);
+    scheduleJobs(0);
+}
+
+/**
+ * @brief Frees the search of the item returned by searchingItem()
+ */
+void MultiScrapeRunner::searchDone()
+{
+    m_searchingItem = 0;
+    scheduleJobs(0);
+}
+
+/**
+ * @brief Queues the load of an item, sigStartLoad is emitted when it may be started
+ * @param item Item in progress
+ * @param scraper Identifier of the scraper which loads
+ */
+void MultiScrapeRunner::requestLoad(QObject *item, const QString &scraper)
+{
+    if (!m_running || !m_active.contains(item))
+        return;
+    Request request;
+    request.item = item;
+    request.scraper = scraper;
+    m_loadQueue.enqueue(request);
+    scheduleJobs(0);
+}
+
+/**
+ * @brief Removes an item from the items in progress and makes room for the next one
+ * @param item Item in progress
+ * @param scraped False if the item was skipped or not found
+ */
+void MultiScrapeRunner::itemDone(QObject *item, bool scraped)
+{
+    if (!m_running || !m_active.contains(item))
+        return;
+
+    m_active.removeOne(item);
+    removeRequests(m_searchQueue, item);
+    removeRequests(m_loadQueue, item);
+    if (m_searchingItem == item)
+        m_searchingItem = 0;
+    m_done++;
+    if (scraped)
+        m_scraped++;
+    emit sigItemDone(item);
+    scheduleJobs(0);
+}
+
+/**
+ * @brief Returns the item whose search is running
+ * @return Item, 0 if no search is running
+ */
+QObject *MultiScrapeRunner::searchingItem() const
+{
+    return m_searchingItem;
+}
+
+QList<QObject*> MultiScrapeRunner::activeItems() const
+{
+    return m_active;
+}
+
+/**
+ * @brief Returns the number of items which were scraped or skipped
+ * @return Number of items
+ */
+int MultiScrapeRunner::itemsDone() const
+{
+    return m_done;
+}
+
+/**
+ * @brief Returns the number of items scraped per minute since running started
+ * @return Titles per minute
+ */
+double MultiScrapeRunner::titlesPerMinute() const
+{
+    if (!m_elapsed.isValid() || m_elapsed.elapsed() <= 0)
+        return 0;
+    return m_scraped*60000.0/m_elapsed.elapsed();
+}
+
+/**
+ * @brief Starts new items and grants the searches and loads the rate limits allow
+ */
+void MultiScrapeRunner::startJobs()
+{
+    m_jobsScheduled = false;
+    if (!m_running)
+        return;
+
+    while (m_running && m_active.count() < m_concurrency && !m_queue.isEmpty()) {
+        QObject *item = m_queue.dequeue();
+        m_active.append(item);
+        emit sigStartItem(item);
+    }
+
+    int wait = 0;
+    if (m_running && !m_searchingItem && !m_searchQueue.isEmpty()) {
+        wait = m_rateLimiter.wait(m_searchQueue.head().scraper);
+        if (wait == 0) {
+            Request request = m_searchQueue.dequeue();
+            m_searchingItem = request.item;
+            m_rateLimiter.started(request.scraper);
+            emit sigStartSearch(request.item);
+        }
+    }
+
+    while (m_running && !m_loadQueue.isEmpty()) {
+        int loadWait = m_rateLimiter.wait(m_loadQueue.head().scraper);
+        if (loadWait > 0) {
+            wait = (wait == 0) ? loadWait : qMin(wait, loadWait);
+            break;
+        }
+        Request request = m_loadQueue.dequeue();
+        m_rateLimiter.started(request.scraper);
+        emit sigStartLoad(request.item);
+    }
+
+    if (wait > 0)
+        scheduleJobs(wait);
+
+    if (m_running && m_active.isEmpty() && m_queue.isEmpty()) {
+        m_running = false;
+        qDebug() << "Scraped" << m_scraped << "items," << titlesPerMinute() << "per minute";
+        emit sigFinished();
+    }
+}
+
+void MultiScrapeRunner::scheduleJobs(int msec)
+{
+    if (msec == 0) {
+        if (m_jobsScheduled)
+            return;
+        m_jobsScheduled = true;
+    }
+    QTimer::singleShot(msec, this, SLOT(startJobs()));
+}
+
+void MultiScrapeRunner::removeRequests(QQueue<Request> &queue, QObject *item)
+{
+    for (int i=queue.count()-1 ; i>=0 ; --i) {
+        if (queue[i].item == item)
+            queue.removeAt(i);
+    }
+}
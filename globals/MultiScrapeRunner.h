@@ -0,0 +1,67 @@
+#ifndef MULTISCRAPERUNNER_H
+#define MULTISCRAPERUNNER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QQueue>
+#include "globals/RateLimiter.h"
+
+/**
+ * @brief The MultiScrapeRunner class
+ * Runs the items of a multi scrape with a bounded number of items in progress.
+ * An item keeps its slot from sigStartItem until itemDone() is called, so the searches and loads of
+ * later items overlap with the image downloads of earlier ones.
+ * Searches are granted one at a time, because scrapers report their results without the item
+ * they belong to. Searches and loads of a scraper are spaced by the RateLimiter.
+ */
+class MultiScrapeRunner : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MultiScrapeRunner(QObject *parent = 0);
+    void start(QList<QObject*> items);
+    void abort();
+    bool isRunning() const;
+    void requestSearch(QObject *item, const QString &scraper);
+    void searchDone();
+    void requestLoad(QObject *item, const QString &scraper);
+    void itemDone(QObject *item, bool scraped = true);
+    QObject *searchingItem() const;
+    QList<QObject*> activeItems() const;
+    int itemsDone() const;
+    double titlesPerMinute() const;
+
+signals:
+    void sigStartItem(QObject*);
+    void sigStartSearch(QObject*);
+    void sigStartLoad(QObject*);
+    void sigItemDone(QObject*);
+    void sigFinished();
+
+private slots:
+    void startJobs();
+
+private:
+    struct Request {
+        QObject *item;
+        QString scraper;
+    };
+
+    bool m_running;
+    bool m_jobsScheduled;
+    int m_concurrency;
+    int m_done;
+    int m_scraped;
+    QElapsedTimer m_elapsed;
+    RateLimiter m_rateLimiter;
+    QQueue<QObject*> m_queue;
+    QList<QObject*> m_active;
+    QQueue<Request> m_searchQueue;
+    QQueue<Request> m_loadQueue;
+    QObject *m_searchingItem;
+
+    void scheduleJobs(int msec);
+    void removeRequests(QQueue<Request> &queue, QObject *item);
+};
+
+#endif // MULTISCRAPERUNNER_H
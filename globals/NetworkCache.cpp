@@ -0,0 +1,96 @@
+#include "NetworkCache.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QLocale>
+#include <QNetworkRequest>
+#include <QUrl>
+#include "settings/Settings.h"
+
+/**
+ * @brief NetworkCache::NetworkCache
+ * @param parent
+ */
+NetworkCache::NetworkCache(QObject *parent) :
+    QNetworkDiskCache(parent)
+{
+    QString location = Settings::instance()->imageCacheDir() + "/network";
+    QDir dir(location);
+    if (!dir.exists())
+        dir.mkpath(location);
+    setCacheDirectory(location);
+    setMaximumCacheSize(qint64(qMax(1, Settings::instance()->advanced()->networkCacheSize()))*1024*1024);
+    m_ttls = Settings::instance()->advanced()->networkCacheTtls();
+    qDebug() << "Network cache dir" << location;
+}
+
+/**
+ * @brief Stores a new response, responses of hosts with a ttl are stored
+ *        even when the server doesn't want them to be cached
+ * @param metaData Meta data of the response
+ * @return Device to write the response to, 0 if it should not be cached
+ */
+QIODevice *NetworkCache::prepare(const QNetworkCacheMetaData &metaData)
+{
+    QNetworkCacheMetaData data = applyTtl(metaData);
+    if (ttl(data.url()) > 0 && data.attributes().value(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200)
+        data.setSaveToDisk(true);
+    return QNetworkDiskCache::prepare(data);
+}
+
+/**
+ * @brief Called when a cached response was revalidated by the server
+ * @param metaData New meta data of the response
+ */
+void NetworkCache::updateMetaData(const QNetworkCacheMetaData &metaData)
+{
+    QNetworkDiskCache::updateMetaData(applyTtl(metaData));
+}
+
+/**
+ * @brief Returns the ttl of the host of an url
+ * @param url Url
+ * @return Ttl in seconds, 0 if the response headers decide
+ */
+int NetworkCache::ttl(const QUrl &url) const
+{
+    QString host = url.host().toLower();
+    while (!host.isEmpty()) {
+        if (m_ttls.contains(host))
+            return m_ttls.value(host);
+        int pos = host.indexOf(".");
+        if (pos == -1)
+            break;
+        host = host.mid(pos+1);
+    }
+    return 0;
+}
+
+/**
+ * @brief Replaces the caching headers of a response by the ttl of its host
+ * @param metaData Meta data of the response
+ * @return Meta data which expires after the ttl, unchanged if the host has no ttl
+ */
+QNetworkCacheMetaData NetworkCache::applyTtl(const QNetworkCacheMetaData &metaData) const
+{
+    int seconds = ttl(metaData.url());
+    if (seconds <= 0)
+        return metaData;
+
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    QNetworkCacheMetaData::RawHeaderList headers;
+    foreach (const QNetworkCacheMetaData::RawHeader &header, metaData.rawHeaders()) {
+        QByteArray name = header.first.toLower();
+        if (name == "cache-control" || name == "expires" || name == "pragma" || name == "date" || name == "age")
+            continue;
+        headers.append(header);
+    }
+    // The freshness is computed from the date of the response, so it's reset with every update
+    headers.append(qMakePair(QByteArray("Date"), QLocale::c().toString(now, "ddd, dd MMM yyyy hh:mm:ss 'GMT'").toLatin1()));
+
+    QNetworkCacheMetaData data = metaData;
+    data.setRawHeaders(headers);
+    data.setExpirationDate(now.addSecs(seconds));
+    return data;
+}
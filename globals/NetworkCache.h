@@ -0,0 +1,27 @@
+#ifndef NETWORKCACHE_H
+#define NETWORKCACHE_H
+
+#include <QHash>
+#include <QNetworkDiskCache>
+
+/**
+ * @brief The NetworkCache class
+ * Disk cache of the network access manager shared by the scrapers and image providers.
+ * Responses of hosts with a ttl from the advanced settings are used without asking the server
+ * until the ttl has passed, afterwards they are revalidated by their ETag or Last-Modified header.
+ */
+class NetworkCache : public QNetworkDiskCache
+{
+    Q_OBJECT
+public:
+    explicit NetworkCache(QObject *parent = 0);
+    QIODevice *prepare(const QNetworkCacheMetaData &metaData);
+    void updateMetaData(const QNetworkCacheMetaData &metaData);
+
+private:
+    QHash<QString, int> m_ttls;
+    int ttl(const QUrl &url) const;
+    QNetworkCacheMetaData applyTtl(const QNetworkCacheMetaData &metaData) const;
+};
+
+#endif // NETWORKCACHE_H
@@ -0,0 +1,41 @@
+#include "RateLimiter.h"
+
+#include "settings/Settings.h"
+
+/**
+ * @brief RateLimiter::RateLimiter
+ */
+RateLimiter::RateLimiter()
+{
+    m_intervals = Settings::instance()->advanced()->scraperRequestIntervals();
+}
+
+/**
+ * @brief Returns the time until the next request to a scraper may be started
+ * @param scraper Identifier of the scraper
+ * @return Time in milliseconds, 0 if a request can be started now
+ */
+int RateLimiter::wait(const QString &scraper) const
+{
+    int interval = m_intervals.value(scraper);
+    if (interval <= 0 || !m_lastRequests.contains(scraper))
+        return 0;
+    return qMax(qint64(0), interval - m_lastRequests[scraper].elapsed());
+}
+
+/**
+ * @brief Marks that a request to a scraper was started
+ * @param scraper Identifier of the scraper
+ */
+void RateLimiter::started(const QString &scraper)
+{
+    m_lastRequests[scraper].start();
+}
+
+/**
+ * @brief Forgets all requests
+ */
+void RateLimiter::reset()
+{
+    m_lastRequests.clear();
+}
@@ -0,0 +1,26 @@
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+
+/**
+ * @brief The RateLimiter class
+ * Keeps a minimum time between two requests to the same scraper.
+ * The intervals are taken from the advanced settings, scrapers without an interval are not limited.
+ */
+class RateLimiter
+{
+public:
+    RateLimiter();
+    int wait(const QString &scraper) const;
+    void started(const QString &scraper);
+    void reset();
+
+private:
+    QHash<QString, int> m_intervals;
+    QHash<QString, QElapsedTimer> m_lastRequests;
+};
+
+#endif // RATELIMITER_H
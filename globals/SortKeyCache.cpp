@@ -0,0 +1,78 @@
+#include "SortKeyCache.h"
+
+#include "globals/Helper.h"
+
+SortKeyCache::SortKey::SortKey(const TitleKey &title, qint64 number, int flags) :
+    title(title),
+    number(number),
+    flags(flags)
+{
+}
+
+/**
+ * @brief Compares the titles of two sort keys
+ * @param other Sort key to compare with
+ * @return Negative, zero or positive if this title is less than, equal to or greater than the other one
+ */
+int SortKeyCache::SortKey::compareTitle(const SortKey &other) const
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 2, 0))
+    return title.compare(other.title);
+#else
+    return QString::localeAwareCompare(title, other.title);
+#endif
+}
+
+/**
+ * @brief SortKeyCache::SortKeyCache
+ */
+SortKeyCache::SortKeyCache()
+{
+}
+
+/**
+ * @brief Computes and stores the sort keys of an item
+ * @param item Item of the model
+ * @param title Title of the item, the sort key respects the "ignore articles" setting
+ * @param number Numeric sort key, e.g. a date
+ * @param flags Flags used for sorting
+ */
+void SortKeyCache::setKeys(const void *item, const QString &title, qint64 number, int flags)
+{
+    m_keys.remove(item);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 2, 0))
+    m_keys.insert(item, SortKey(m_collator.sortKey(Helper::instance()->appendArticle(title)), number, flags));
+#else
+    m_keys.insert(item, SortKey(Helper::instance()->appendArticle(title), number, flags));
+#endif
+}
+
+/**
+ * @brief Removes the sort keys of an item
+ * @param item Item of the model
+ */
+void SortKeyCache::remove(const void *item)
+{
+    m_keys.remove(item);
+}
+
+/**
+ * @brief Removes all sort keys
+ */
+void SortKeyCache::clear()
+{
+    m_keys.clear();
+}
+
+/**
+ * @brief Returns the sort keys of an item
+ * @param item Item of the model
+ * @return Sort keys, 0 if the item has no keys
+ */
+const SortKeyCache::SortKey *SortKeyCache::key(const void *item) const
+{
+    QHash<const void*, SortKey>::const_iterator it = m_keys.constFind(item);
+    if (it == m_keys.constEnd())
+        return 0;
+    return &it.value();
+}
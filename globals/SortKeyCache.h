@@ -0,0 +1,49 @@
+#ifndef SORTKEYCACHE_H
+#define SORTKEYCACHE_H
+
+#include <QHash>
+#include <QString>
+#include <QtGlobal>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 2, 0))
+#include <QCollator>
+#endif
+
+/**
+ * @brief The SortKeyCache class
+ * Holds precomputed sort keys of the items of a model, so proxy models don't have to
+ * fetch and compare display strings in lessThan.
+ * The title is stored as a QCollator sort key (articles are moved like in Helper::appendArticle),
+ * before Qt 5.2 the title itself is stored and compared with QString::localeAwareCompare.
+ * Additional criteria are stored as a number and a set of flags whose meaning is defined by the model.
+ */
+class SortKeyCache
+{
+public:
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 2, 0))
+    typedef QCollatorSortKey TitleKey;
+#else
+    typedef QString TitleKey;
+#endif
+
+    struct SortKey {
+        SortKey(const TitleKey &title, qint64 number, int flags);
+        int compareTitle(const SortKey &other) const;
+        TitleKey title;
+        qint64 number;
+        int flags;
+    };
+
+    SortKeyCache();
+    void setKeys(const void *item, const QString &title, qint64 number = 0, int flags = 0);
+    void remove(const void *item);
+    void clear();
+    const SortKey *key(const void *item) const;
+
+private:
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 2, 0))
+    QCollator m_collator;
+#endif
+    QHash<const void*, SortKey> m_keys;
+};
+
+#endif // SORTKEYCACHE_H
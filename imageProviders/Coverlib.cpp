@@ -5,6 +5,7 @@
 #include <QtScript/QScriptValueIterator>
 #include <QtScript/QScriptEngine>
 #include "data/Storage.h"
+#include "globals/Manager.h"
 #include "imageProviders/FanartTv.h"
 #include "scrapers/TMDb.h"
 
@@ -56,7 +57,7 @@ QWidget* Coverlib::settingsWidget()
 
 QNetworkAccessManager *Coverlib::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 void Coverlib::searchAlbum(QString artistName, QString searchStr, int limit)
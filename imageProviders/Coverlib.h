@@ -80,7 +80,6 @@ private slots:
 
 private:
     QList<int> m_provides;
-    QNetworkAccessManager m_qnam;
 
     QNetworkAccessManager *qnam();
     QList<Poster> parseData(QString html, int type);
@@ -7,6 +7,7 @@
 #include <QtScript/QScriptValueIterator>
 #include <QtScript/QScriptEngine>
 #include "data/Storage.h"
+#include "globals/Manager.h"
 #include "main/MainWindow.h"
 #include "scrapers/TMDb.h"
 
@@ -111,7 +112,7 @@ QList<int> FanartTv::provides()
  */
 QNetworkAccessManager *FanartTv::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
@@ -92,7 +92,6 @@ private:
     QList<int> m_provides;
     QString m_apiKey;
     QString m_personalApiKey;
-    QNetworkAccessManager m_qnam;
     int m_searchResultLimit;
     TheTvDb *m_tvdb;
     TMDb *m_tmdb;
@@ -5,6 +5,7 @@
 #include <QtScript/QScriptValueIterator>
 #include <QtScript/QScriptEngine>
 #include "data/Storage.h"
+#include "globals/Manager.h"
 #include "imageProviders/FanartTv.h"
 #include "scrapers/TMDb.h"
 
@@ -41,7 +42,7 @@ QList<int> FanartTvMusic::provides()
 
 QNetworkAccessManager *FanartTvMusic::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 void FanartTvMusic::searchAlbum(QString artistName, QString searchStr, int limit)
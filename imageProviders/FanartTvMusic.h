@@ -86,7 +86,6 @@ private:
     QList<int> m_provides;
     QString m_apiKey;
     QString m_personalApiKey;
-    QNetworkAccessManager m_qnam;
     int m_searchResultLimit;
     QString m_language;
 
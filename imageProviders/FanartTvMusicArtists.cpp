@@ -5,6 +5,7 @@
 #include <QtScript/QScriptValueIterator>
 #include <QtScript/QScriptEngine>
 #include "data/Storage.h"
+#include "globals/Manager.h"
 #include "imageProviders/FanartTv.h"
 #include "scrapers/TMDb.h"
 
@@ -56,7 +57,7 @@ QList<int> FanartTvMusicArtists::provides()
  */
 QNetworkAccessManager *FanartTvMusicArtists::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 
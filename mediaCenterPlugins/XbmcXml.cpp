@@ -5,6 +5,7 @@
 #include <QDebug>
 #include <QDir>
 #include <QFileInfo>
+#include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
 #include "globals/Globals.h"
@@ -394,114 +395,102 @@ bool XbmcXml::loadMovie(Movie *movie, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-    if (!domDoc.elementsByTagName("title").isEmpty())
-        movie->setName(domDoc.elementsByTagName("title").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("originaltitle").isEmpty())
-        movie->setOriginalName(domDoc.elementsByTagName("originaltitle").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("rating").isEmpty())
-        movie->setRating(domDoc.elementsByTagName("rating").at(0).toElement().text().replace(",", ".").toFloat());
-    if (!domDoc.elementsByTagName("votes").isEmpty())
-        movie->setVotes(domDoc.elementsByTagName("votes").at(0).toElement().text().replace(",", "").replace(".", "").toInt());
-    if (!domDoc.elementsByTagName("top250").isEmpty())
-        movie->setTop250(domDoc.elementsByTagName("top250").at(0).toElement().text().toInt());
-    if (!domDoc.elementsByTagName("year").isEmpty())
-        movie->setReleased(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
-    if (!domDoc.elementsByTagName("plot").isEmpty())
-        movie->setOverview(domDoc.elementsByTagName("plot").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("outline").isEmpty())
-        movie->setOutline(domDoc.elementsByTagName("outline").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("tagline").isEmpty())
-        movie->setTagline(domDoc.elementsByTagName("tagline").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("runtime").isEmpty())
-        movie->setRuntime(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt());
-    if (!domDoc.elementsByTagName("mpaa").isEmpty())
-        movie->setCertification(domDoc.elementsByTagName("mpaa").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("playcount").isEmpty())
-        movie->setPlayCount(domDoc.elementsByTagName("playcount").at(0).toElement().text().toInt());
-    if (!domDoc.elementsByTagName("lastplayed").isEmpty()) {
-        QDateTime lastPlayed = QDateTime::fromString(domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss");
-        if (!lastPlayed.isValid())
-            lastPlayed = QDateTime::fromString(domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd");
-        movie->setLastPlayed(lastPlayed);
-    }
-    if (!domDoc.elementsByTagName("dateadded").isEmpty())
-        movie->setDateAdded(QDateTime::fromString(domDoc.elementsByTagName("dateadded").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss"));
-    if (!domDoc.elementsByTagName("id").isEmpty())
-        movie->setId(domDoc.elementsByTagName("id").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("tmdbid").isEmpty())
-        movie->setTmdbId(domDoc.elementsByTagName("tmdbid").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("set").isEmpty())
-        movie->setSet(domDoc.elementsByTagName("set").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("sorttitle").isEmpty())
-        movie->setSortTitle(domDoc.elementsByTagName("sorttitle").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("trailer").isEmpty())
-        movie->setTrailer(QUrl(domDoc.elementsByTagName("trailer").at(0).toElement().text()));
-    if (!domDoc.elementsByTagName("watched").isEmpty()) {
-        movie->setWatched(domDoc.elementsByTagName("watched").at(0).toElement().text() == "true" ? true : false);
-    } else {
-        movie->setWatched(movie->playcount() > 0);
-    }
-
     QStringList writers;
-    for (int i=0, n=domDoc.elementsByTagName("credits").size() ; i<n ; i++) {
-        foreach (const QString &writer, domDoc.elementsByTagName("credits").at(i).toElement().text().split(",", QString::SkipEmptyParts))
-            writers.append(writer.trimmed());
-    }
-    movie->setWriter(writers.join(", "));
-
     QStringList directors;
-    for (int i=0, n=domDoc.elementsByTagName("director").size() ; i<n ; i++) {
-        foreach (const QString &director, domDoc.elementsByTagName("director").at(i).toElement().text().split(",", QString::SkipEmptyParts))
-            directors.append(director.trimmed());
-    }
-    movie->setDirector(directors.join(", "));
-
-    for (int i=0, n=domDoc.elementsByTagName("studio").size() ; i<n ; i++) {
-        foreach (const QString &studio, domDoc.elementsByTagName("studio").at(i).toElement().text().split("/", QString::SkipEmptyParts))
-            movie->addStudio(studio.trimmed());
-    }
-
-    for (int i=0, n=domDoc.elementsByTagName("genre").size() ; i<n ; i++) {
-        foreach (const QString &genre, domDoc.elementsByTagName("genre").at(i).toElement().text().split("/", QString::SkipEmptyParts))
-            movie->addGenre(genre.trimmed());
-    }
-
-    for (int i=0, n=domDoc.elementsByTagName("country").size() ; i<n ; i++) {
-        foreach (const QString &country, domDoc.elementsByTagName("country").at(i).toElement().text().split(" / ", QString::SkipEmptyParts))
-            movie->addCountry(country.trimmed());
-    }
-
-    for (int i=0, n=domDoc.elementsByTagName("tag").size() ; i<n ; i++)
-        movie->addTag(domDoc.elementsByTagName("tag").at(i).toElement().text());
-    for (int i=0, n=domDoc.elementsByTagName("actor").size() ; i<n ; i++) {
-        Actor a;
-        a.imageHasChanged = false;
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("name").isEmpty())
-            a.name = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("name").at(0).toElement().text();
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("role").isEmpty())
-            a.role = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("role").at(0).toElement().text();
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("thumb").isEmpty())
-            a.thumb = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("thumb").at(0).toElement().text();
-        movie->addActor(a);
-    }
-    for (int i=0, n=domDoc.elementsByTagName("thumb").size() ; i<n ; i++) {
-        QString parentTag = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().tagName();
-        if (parentTag == "movie") {
-            Poster p;
-            p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-            p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-            movie->addPoster(p);
-        } else if (parentTag == "fanart") {
-            Poster p;
-            p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-            p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-            movie->addBackdrop(p);
+    bool watchedLoaded = false;
+    bool streamDetailsLoaded = false;
+    movie->streamDetails()->clear();
+
+    QXmlStreamReader xml(nfoContent);
+    if (xml.readNextStartElement()) {
+        while (xml.readNextStartElement()) {
+            const QStringRef name = xml.name();
+            if (name == "title") {
+                movie->setName(readNfoText(xml));
+            } else if (name == "originaltitle") {
+                movie->setOriginalName(readNfoText(xml));
+            } else if (name == "rating") {
+                movie->setRating(readNfoText(xml).replace(",", ".").toFloat());
+            } else if (name == "votes") {
+                movie->setVotes(readNfoText(xml).replace(",", "").replace(".", "").toInt());
+            } else if (name == "top250") {
+                movie->setTop250(readNfoText(xml).toInt());
+            } else if (name == "year") {
+                movie->setReleased(QDate::fromString(readNfoText(xml), "yyyy"));
+            } else if (name == "plot") {
+                movie->setOverview(readNfoText(xml));
+            } else if (name == "outline") {
+                movie->setOutline(readNfoText(xml));
+            } else if (name == "tagline") {
+                movie->setTagline(readNfoText(xml));
+            } else if (name == "runtime") {
+                movie->setRuntime(readNfoText(xml).toInt());
+            } else if (name == "mpaa") {
+                movie->setCertification(readNfoText(xml));
+            } else if (name == "playcount") {
+                movie->setPlayCount(readNfoText(xml).toInt());
+            } else if (name == "lastplayed") {
+                QString value = readNfoText(xml);
+                QDateTime lastPlayed = QDateTime::fromString(value, "yyyy-MM-dd HH:mm:ss");
+                if (!lastPlayed.isValid())
+                    lastPlayed = QDateTime::fromString(value, "yyyy-MM-dd");
+                movie->setLastPlayed(lastPlayed);
+            } else if (name == "dateadded") {
+                movie->setDateAdded(QDateTime::fromString(readNfoText(xml), "yyyy-MM-dd HH:mm:ss"));
+            } else if (name == "id") {
+                movie->setId(readNfoText(xml));
+            } else if (name == "tmdbid") {
+                movie->setTmdbId(readNfoText(xml));
+            } else if (name == "set") {
+                movie->setSet(readNfoText(xml));
+            } else if (name == "sorttitle") {
+                movie->setSortTitle(readNfoText(xml));
+            } else if (name == "trailer") {
+                movie->setTrailer(QUrl(readNfoText(xml)));
+            } else if (name == "watched") {
+                movie->setWatched(readNfoText(xml) == "true");
+                watchedLoaded = true;
+            } else if (name == "credits") {
+                foreach (const QString &writer, readNfoText(xml).split(",", QString::SkipEmptyParts))
+                    writers.append(writer.trimmed());
+            } else if (name == "director") {
+                foreach (const QString &director, readNfoText(xml).split(",", QString::SkipEmptyParts))
+                    directors.append(director.trimmed());
+            } else if (name == "studio") {
+                foreach (const QString &studio, readNfoText(xml).split("/", QString::SkipEmptyParts))
+                    movie->addStudio(studio.trimmed());
+            } else if (name == "genre") {
+                foreach (const QString &genre, readNfoText(xml).split("/", QString::SkipEmptyParts))
+                    movie->addGenre(genre.trimmed());
+            } else if (name == "country") {
+                foreach (const QString &country, readNfoText(xml).split(" / ", QString::SkipEmptyParts))
+                    movie->addCountry(country.trimmed());
+            } else if (name == "tag") {
+                movie->addTag(readNfoText(xml));
+            } else if (name == "actor") {
+                movie->addActor(readActor(xml));
+            } else if (name == "thumb") {
+                movie->addPoster(readPoster(xml));
+            } else if (name == "fanart") {
+                while (xml.readNextStartElement()) {
+                    if (xml.name() == "thumb")
+                        movie->addBackdrop(readPoster(xml));
+                    else
+                        xml.skipCurrentElement();
+                }
+            } else if (name == "fileinfo") {
+                streamDetailsLoaded = loadFileInfo(movie->streamDetails(), xml) || streamDetailsLoaded;
+            } else {
+                xml.skipCurrentElement();
+            }
         }
     }
 
-    movie->setStreamDetailsLoaded(loadStreamDetails(movie->streamDetails(), domDoc));
+    movie->setWriter(writers.join(", "));
+    movie->setDirector(directors.join(", "));
+    if (!watchedLoaded)
+        movie->setWatched(movie->playcount() > 0);
+    movie->setStreamDetailsLoaded(streamDetailsLoaded);
 
     // Existence of images
     if (initialNfoContent.isEmpty()) {
@@ -514,52 +503,113 @@ bool XbmcXml::loadMovie(Movie *movie, QString initialNfoContent)
 }
 
 /**
- * @brief Loads the stream details from the dom document
+ * @brief Reads the text of the current element, including the text of child elements
+ * @param xml Stream reader positioned at the start of an element
+ * @return Text of the element
+ */
+QString XbmcXml::readNfoText(QXmlStreamReader &xml)
+{
+    return xml.readElementText(QXmlStreamReader::IncludeChildElements);
+}
+
+/**
+ * @brief Reads an actor element
+ * @param xml Stream reader positioned at the start of an actor element
+ * @return Actor
+ */
+Actor XbmcXml::readActor(QXmlStreamReader &xml)
+{
+    Actor a;
+    a.imageHasChanged = false;
+    while (xml.readNextStartElement()) {
+        if (xml.name() == "name")
+            a.name = readNfoText(xml);
+        else if (xml.name() == "role")
+            a.role = readNfoText(xml);
+        else if (xml.name() == "thumb")
+            a.thumb = readNfoText(xml);
+        else
+            xml.skipCurrentElement();
+    }
+    return a;
+}
+
+/**
+ * @brief Reads a thumb element
+ * @param xml Stream reader positioned at the start of a thumb element
+ * @param baseUrl Prefix of the urls (url attribute of the parent element)
+ * @return Poster
+ */
+Poster XbmcXml::readPoster(QXmlStreamReader &xml, const QString &baseUrl)
+{
+    Poster p;
+    QString preview = xml.attributes().value("preview").toString();
+    p.originalUrl = QUrl(baseUrl + readNfoText(xml));
+    p.thumbUrl = QUrl(baseUrl + preview);
+    return p;
+}
+
+/**
+ * @brief Loads the stream details from a fileinfo element
  * @param streamDetails StreamDetails object
- * @param domDoc Nfo document
+ * @param xml Stream reader positioned at the start of the fileinfo element
  * @return Infos loaded
  */
-bool XbmcXml::loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc)
+bool XbmcXml::loadFileInfo(StreamDetails *streamDetails, QXmlStreamReader &xml)
 {
-    streamDetails->clear();
-    if (!domDoc.elementsByTagName("streamdetails").isEmpty()) {
-        QDomElement elem = domDoc.elementsByTagName("streamdetails").at(0).toElement();
-        loadStreamDetails(streamDetails, elem);
-        return true;
+    bool loaded = false;
+    while (xml.readNextStartElement()) {
+        if (xml.name() == "streamdetails" && !loaded) {
+            loadStreamDetails(streamDetails, xml);
+            loaded = true;
+        } else {
+            xml.skipCurrentElement();
+        }
     }
-    return false;
+    return loaded;
 }
 
-void XbmcXml::loadStreamDetails(StreamDetails* streamDetails, QDomElement elem)
+/**
+ * @brief Loads the stream details from a streamdetails element
+ * @param streamDetails StreamDetails object
+ * @param xml Stream reader positioned at the start of the streamdetails element
+ */
+void XbmcXml::loadStreamDetails(StreamDetails *streamDetails, QXmlStreamReader &xml)
 {
-    if (!elem.elementsByTagName("video").isEmpty()) {
-        QDomElement videoElem = elem.elementsByTagName("video").at(0).toElement();
-        QStringList details = (QStringList() << "codec" << "aspect" << "width" << "height" << "durationinseconds" << "scantype" << "stereomode");
-        foreach (const QString &detail, details) {
-            if (!videoElem.elementsByTagName(detail).isEmpty())
-                streamDetails->setVideoDetail(detail, videoElem.elementsByTagName(detail).at(0).toElement().text());
-        }
-    }
-    if (!elem.elementsByTagName("audio").isEmpty()) {
-        for (int i=0, n=elem.elementsByTagName("audio").count() ; i<n ; ++i) {
-            QStringList details = QStringList() << "codec" << "language" << "channels";
-            QDomElement audioElem = elem.elementsByTagName("audio").at(i).toElement();
-            foreach (const QString &detail, details) {
-                if (!audioElem.elementsByTagName(detail).isEmpty())
-                    streamDetails->setAudioDetail(i, detail, audioElem.elementsByTagName(detail).at(0).toElement().text());
+    QStringList videoDetails = QStringList() << "codec" << "aspect" << "width" << "height" << "durationinseconds" << "scantype" << "stereomode";
+    QStringList audioDetails = QStringList() << "codec" << "language" << "channels";
+    bool videoLoaded = false;
+    int audioIndex = 0;
+    int subtitleIndex = 0;
+    while (xml.readNextStartElement()) {
+        if (xml.name() == "video" && !videoLoaded) {
+            videoLoaded = true;
+            while (xml.readNextStartElement()) {
+                QString detail = xml.name().toString();
+                QString value = readNfoText(xml);
+                if (videoDetails.contains(detail))
+                    streamDetails->setVideoDetail(detail, value);
             }
-        }
-    }
-    if (!elem.elementsByTagName("subtitle").isEmpty()) {
-        for (int i=0, n=elem.elementsByTagName("subtitle").count() ; i<n ; ++i) {
-            QStringList details = QStringList() << "language";
-            QDomElement subtitleElem = elem.elementsByTagName("subtitle").at(i).toElement();
-            if (!subtitleElem.elementsByTagName("file").isEmpty())
-                continue;
-            foreach (const QString &detail, details) {
-                if (!subtitleElem.elementsByTagName(detail).isEmpty())
-                    streamDetails->setSubtitleDetail(i, detail, subtitleElem.elementsByTagName(detail).at(0).toElement().text());
+        } else if (xml.name() == "audio") {
+            while (xml.readNextStartElement()) {
+                QString detail = xml.name().toString();
+                QString value = readNfoText(xml);
+                if (audioDetails.contains(detail))
+                    streamDetails->setAudioDetail(audioIndex, detail, value);
+            }
+            audioIndex++;
+        } else if (xml.name() == "subtitle") {
+            // Subtitles with a file element are external subtitles, they're not part of the stream details
+            QMap<QString, QString> details;
+            while (xml.readNextStartElement()) {
+                QString detail = xml.name().toString();
+                details.insert(detail, readNfoText(xml));
             }
+            if (!details.contains("file") && details.contains("language"))
+                streamDetails->setSubtitleDetail(subtitleIndex, "language", details.value("language"));
+            subtitleIndex++;
+        } else {
+            xml.skipCurrentElement();
         }
     }
 }
@@ -898,61 +948,66 @@ bool XbmcXml::loadConcert(Concert *concert, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-    if (!domDoc.elementsByTagName("id").isEmpty() )
-        concert->setId(domDoc.elementsByTagName("id").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("tmdbid").isEmpty() )
-        concert->setTmdbId(domDoc.elementsByTagName("tmdbid").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("title").isEmpty() )
-        concert->setName(domDoc.elementsByTagName("title").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("artist").isEmpty() )
-        concert->setArtist(domDoc.elementsByTagName("artist").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("album").isEmpty() )
-        concert->setAlbum(domDoc.elementsByTagName("album").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("rating").isEmpty())
-        concert->setRating(domDoc.elementsByTagName("rating").at(0).toElement().text().replace(",", ".").toFloat());
-    if (!domDoc.elementsByTagName("year").isEmpty())
-        concert->setReleased(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
-    if (!domDoc.elementsByTagName("plot").isEmpty())
-        concert->setOverview(domDoc.elementsByTagName("plot").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("tagline").isEmpty())
-        concert->setTagline(domDoc.elementsByTagName("tagline").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("runtime").isEmpty())
-        concert->setRuntime(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt());
-    if (!domDoc.elementsByTagName("mpaa").isEmpty())
-        concert->setCertification(domDoc.elementsByTagName("mpaa").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("playcount").isEmpty())
-        concert->setPlayCount(domDoc.elementsByTagName("playcount").at(0).toElement().text().toInt());
-    if (!domDoc.elementsByTagName("lastplayed").isEmpty())
-        concert->setLastPlayed(QDateTime::fromString(domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss"));
-    if (!domDoc.elementsByTagName("trailer").isEmpty())
-        concert->setTrailer(QUrl(domDoc.elementsByTagName("trailer").at(0).toElement().text()));
-    if (!domDoc.elementsByTagName("watched").isEmpty())
-        concert->setWatched(domDoc.elementsByTagName("watched").at(0).toElement().text() == "true" ? true : false);
-
-    for (int i=0, n=domDoc.elementsByTagName("genre").size() ; i<n ; i++) {
-        foreach (const QString &genre, domDoc.elementsByTagName("genre").at(i).toElement().text().split(" / ", QString::SkipEmptyParts))
-            concert->addGenre(genre);
-    }
-    for (int i=0, n=domDoc.elementsByTagName("tag").size() ; i<n ; i++)
-        concert->addTag(domDoc.elementsByTagName("tag").at(i).toElement().text());
-    for (int i=0, n=domDoc.elementsByTagName("thumb").size() ; i<n ; i++) {
-        QString parentTag = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().tagName();
-        if (parentTag == "musicvideo") {
-            Poster p;
-            p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-            p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-            concert->addPoster(p);
-        } else if (parentTag == "fanart") {
-            Poster p;
-            p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-            p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-            concert->addBackdrop(p);
-        }
-    }
-
-    concert->setStreamDetailsLoaded(loadStreamDetails(concert->streamDetails(), domDoc));
+    bool streamDetailsLoaded = false;
+    concert->streamDetails()->clear();
+
+    QXmlStreamReader xml(nfoContent);
+    if (xml.readNextStartElement()) {
+        while (xml.readNextStartElement()) {
+            const QStringRef name = xml.name();
+            if (name == "id") {
+                concert->setId(readNfoText(xml));
+            } else if (name == "tmdbid") {
+                concert->setTmdbId(readNfoText(xml));
+            } else if (name == "title") {
+                concert->setName(readNfoText(xml));
+            } else if (name == "artist") {
+                concert->setArtist(readNfoText(xml));
+            } else if (name == "album") {
+                concert->setAlbum(readNfoText(xml));
+            } else if (name == "rating") {
+                concert->setRating(readNfoText(xml).replace(",", ".").toFloat());
+            } else if (name == "year") {
+                concert->setReleased(QDate::fromString(readNfoText(xml), "yyyy"));
+            } else if (name == "plot") {
+                concert->setOverview(readNfoText(xml));
+            } else if (name == "tagline") {
+                concert->setTagline(readNfoText(xml));
+            } else if (name == "runtime") {
+                concert->setRuntime(readNfoText(xml).toInt());
+            } else if (name == "mpaa") {
+                concert->setCertification(readNfoText(xml));
+            } else if (name == "playcount") {
+                concert->setPlayCount(readNfoText(xml).toInt());
+            } else if (name == "lastplayed") {
+                concert->setLastPlayed(QDateTime::fromString(readNfoText(xml), "yyyy-MM-dd HH:mm:ss"));
+            } else if (name == "trailer") {
+                concert->setTrailer(QUrl(readNfoText(xml)));
+            } else if (name == "watched") {
+                concert->setWatched(readNfoText(xml) == "true");
+            } else if (name == "genre") {
+                foreach (const QString &genre, readNfoText(xml).split(" / ", QString::SkipEmptyParts))
+                    concert->addGenre(genre);
+            } else if (name == "tag") {
+                concert->addTag(readNfoText(xml));
+            } else if (name == "thumb") {
+                concert->addPoster(readPoster(xml));
+            } else if (name == "fanart") {
+                while (xml.readNextStartElement()) {
+                    if (xml.name() == "thumb")
+                        concert->addBackdrop(readPoster(xml));
+                    else
+                        xml.skipCurrentElement();
+                }
+            } else if (name == "fileinfo") {
+                streamDetailsLoaded = loadFileInfo(concert->streamDetails(), xml) || streamDetailsLoaded;
+            } else {
+                xml.skipCurrentElement();
+            }
+        }
+    }
+
+    concert->setStreamDetailsLoaded(streamDetailsLoaded);
 
     // Existence of images
     if (initialNfoContent.isEmpty()) {
@@ -1033,78 +1088,75 @@ bool XbmcXml::loadTvShow(TvShow *show, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-    if (!domDoc.elementsByTagName("id").isEmpty() )
-        show->setId(domDoc.elementsByTagName("id").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("tvdbid").isEmpty() )
-        show->setTvdbId(domDoc.elementsByTagName("tvdbid").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("imdbid").isEmpty() )
-        show->setImdbId(domDoc.elementsByTagName("imdbid").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("title").isEmpty() )
-        show->setName(domDoc.elementsByTagName("title").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("sorttitle").isEmpty() )
-        show->setSortTitle(domDoc.elementsByTagName("sorttitle").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("showtitle").isEmpty() )
-        show->setShowTitle(domDoc.elementsByTagName("showtitle").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("rating").isEmpty())
-        show->setRating(domDoc.elementsByTagName("rating").at(0).toElement().text().replace(",", ".").toFloat());
-    if (!domDoc.elementsByTagName("votes").isEmpty())
-        show->setVotes(domDoc.elementsByTagName("votes").at(0).toElement().text().replace(",", "").replace(".", "").toInt());
-    if (!domDoc.elementsByTagName("top250").isEmpty())
-        show->setTop250(domDoc.elementsByTagName("top250").at(0).toElement().text().toInt());
-    if (!domDoc.elementsByTagName("plot").isEmpty())
-        show->setOverview(domDoc.elementsByTagName("plot").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("mpaa").isEmpty())
-        show->setCertification(domDoc.elementsByTagName("mpaa").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("premiered").isEmpty())
-        show->setFirstAired(QDate::fromString(domDoc.elementsByTagName("premiered").at(0).toElement().text(), "yyyy-MM-dd"));
-    if (!domDoc.elementsByTagName("studio").isEmpty())
-        show->setNetwork(domDoc.elementsByTagName("studio").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("episodeguide").isEmpty() && !domDoc.elementsByTagName("episodeguide").at(0).toElement().elementsByTagName("url").isEmpty())
-        show->setEpisodeGuideUrl(domDoc.elementsByTagName("episodeguide").at(0).toElement().elementsByTagName("url").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("runtime").isEmpty())
-        show->setRuntime(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt());
-    if (!domDoc.elementsByTagName("status").isEmpty())
-        show->setStatus(domDoc.elementsByTagName("status").at(0).toElement().text());
-
-    for (int i=0, n=domDoc.elementsByTagName("genre").size() ; i<n ; i++) {
-        foreach (const QString &genre, domDoc.elementsByTagName("genre").at(i).toElement().text().split(" / ", QString::SkipEmptyParts))
-            show->addGenre(genre);
-    }
-    for (int i=0, n=domDoc.elementsByTagName("tag").size() ; i<n ; i++)
-        show->addTag(domDoc.elementsByTagName("tag").at(i).toElement().text());
-    for (int i=0, n=domDoc.elementsByTagName("actor").size() ; i<n ; i++) {
-        Actor a;
-        a.imageHasChanged = false;
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("name").isEmpty())
-            a.name = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("name").at(0).toElement().text();
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("role").isEmpty())
-            a.role = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("role").at(0).toElement().text();
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("thumb").isEmpty())
-            a.thumb = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("thumb").at(0).toElement().text();
-        show->addActor(a);
-    }
-    for (int i=0, n=domDoc.elementsByTagName("thumb").size() ; i<n ; i++) {
-        QString parentTag = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().tagName();
-        if (parentTag == "tvshow") {
-            QDomElement elem = domDoc.elementsByTagName("thumb").at(i).toElement();
-            Poster p;
-            p.originalUrl = QUrl(elem.text());
-            p.thumbUrl = QUrl(elem.text());
-            if (elem.hasAttribute("type") && elem.attribute("type") == "season") {
-                int season = elem.attribute("season").toInt();
-                if (season >= 0)
+    QXmlStreamReader xml(nfoContent);
+    if (xml.readNextStartElement()) {
+        while (xml.readNextStartElement()) {
+            const QStringRef name = xml.name();
+            if (name == "id") {
+                show->setId(readNfoText(xml));
+            } else if (name == "tvdbid") {
+                show->setTvdbId(readNfoText(xml));
+            } else if (name == "imdbid") {
+                show->setImdbId(readNfoText(xml));
+            } else if (name == "title") {
+                show->setName(readNfoText(xml));
+            } else if (name == "sorttitle") {
+                show->setSortTitle(readNfoText(xml));
+            } else if (name == "showtitle") {
+                show->setShowTitle(readNfoText(xml));
+            } else if (name == "rating") {
+                show->setRating(readNfoText(xml).replace(",", ".").toFloat());
+            } else if (name == "votes") {
+                show->setVotes(readNfoText(xml).replace(",", "").replace(".", "").toInt());
+            } else if (name == "top250") {
+                show->setTop250(readNfoText(xml).toInt());
+            } else if (name == "plot") {
+                show->setOverview(readNfoText(xml));
+            } else if (name == "mpaa") {
+                show->setCertification(readNfoText(xml));
+            } else if (name == "premiered") {
+                show->setFirstAired(QDate::fromString(readNfoText(xml), "yyyy-MM-dd"));
+            } else if (name == "studio") {
+                show->setNetwork(readNfoText(xml));
+            } else if (name == "episodeguide") {
+                while (xml.readNextStartElement()) {
+                    if (xml.name() == "url")
+                        show->setEpisodeGuideUrl(readNfoText(xml));
+                    else
+                        xml.skipCurrentElement();
+                }
+            } else if (name == "runtime") {
+                show->setRuntime(readNfoText(xml).toInt());
+            } else if (name == "status") {
+                show->setStatus(readNfoText(xml));
+            } else if (name == "genre") {
+                foreach (const QString &genre, readNfoText(xml).split(" / ", QString::SkipEmptyParts))
+                    show->addGenre(genre);
+            } else if (name == "tag") {
+                show->addTag(readNfoText(xml));
+            } else if (name == "actor") {
+                show->addActor(readActor(xml));
+            } else if (name == "thumb") {
+                bool isSeasonPoster = xml.attributes().value("type") == "season";
+                int season = xml.attributes().value("season").toString().toInt();
+                Poster p;
+                p.originalUrl = QUrl(readNfoText(xml));
+                p.thumbUrl = p.originalUrl;
+                if (!isSeasonPoster)
+                    show->addPoster(p);
+                else if (season >= 0)
                     show->addSeasonPoster(season, p);
+            } else if (name == "fanart") {
+                QString url = xml.attributes().value("url").toString();
+                while (xml.readNextStartElement()) {
+                    if (xml.name() == "thumb")
+                        show->addBackdrop(readPoster(xml, url));
+                    else
+                        xml.skipCurrentElement();
+                }
             } else {
-                show->addPoster(p);
+                xml.skipCurrentElement();
             }
-        } else if (parentTag == "fanart") {
-            QString url = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().attribute("url");
-            Poster p;
-            p.originalUrl = QUrl(url + domDoc.elementsByTagName("thumb").at(i).toElement().text());
-            p.thumbUrl = QUrl(url + domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-            show->addBackdrop(p);
         }
     }
 
@@ -1151,93 +1203,128 @@ bool XbmcXml::loadTvShowEpisode(TvShowEpisode *episode, QString initialNfoConten
             def = line;
     }
     QString nfoContentWithRoot = QString("%1\n<root>%2</root>").arg(def).arg(baseNfoContent.join("\n"));
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContentWithRoot);
 
-    QDomNodeList episodeDetailsList = domDoc.elementsByTagName("episodedetails");
-    if (episodeDetailsList.isEmpty())
+    // Multi episode files contain one episodedetails element per episode, pick the one matching season and episode
+    int episodeIndex = 0;
+    if (nfoContent.count("<episodedetails") > 1) {
+        episodeIndex = episodeDetailsIndex(nfoContentWithRoot, episode->season(), episode->episode());
+        if (episodeIndex == -1)
+            return false;
+    }
+
+    QXmlStreamReader xml(nfoContentWithRoot);
+    if (!xml.readNextStartElement())
         return false;
 
-    QDomElement episodeDetails;
-    if (episodeDetailsList.count() > 1) {
-        bool found = false;
-        for (int i=0, n=episodeDetailsList.count() ; i<n ; ++i) {
-            episodeDetails = episodeDetailsList.at(i).toElement();
-            if (!episodeDetails.elementsByTagName("season").isEmpty() &&
-                    episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt() == episode->season() &&
-                    !episodeDetails.elementsByTagName("episode").isEmpty() &&
-                    episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt() == episode->episode()) {
-                found = true;
-                break;
-            }
+    for (int index=0 ; xml.readNextStartElement() ; ) {
+        if (xml.name() != "episodedetails" || index++ != episodeIndex) {
+            xml.skipCurrentElement();
+            continue;
         }
-        if (!found)
-            return false;
+        loadEpisodeDetails(episode, xml);
+        return true;
+    }
 
-    } else {
-        episodeDetails = episodeDetailsList.at(0).toElement();
-    }
-
-    if (!episodeDetails.elementsByTagName("imdbid").isEmpty())
-        episode->setImdbId(episodeDetails.elementsByTagName("imdbid").at(0).toElement().text());
-    if (!episodeDetails.elementsByTagName("title").isEmpty())
-        episode->setName(episodeDetails.elementsByTagName("title").at(0).toElement().text());
-    if (!episodeDetails.elementsByTagName("showtitle").isEmpty())
-        episode->setShowTitle(episodeDetails.elementsByTagName("showtitle").at(0).toElement().text());
-    if (!episodeDetails.elementsByTagName("season").isEmpty())
-        episode->setSeason(episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt());
-    if (!episodeDetails.elementsByTagName("episode").isEmpty())
-        episode->setEpisode(episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt());
-    if (!episodeDetails.elementsByTagName("displayseason").isEmpty())
-        episode->setDisplaySeason(episodeDetails.elementsByTagName("displayseason").at(0).toElement().text().toInt());
-    if (!episodeDetails.elementsByTagName("displayepisode").isEmpty())
-        episode->setDisplayEpisode(episodeDetails.elementsByTagName("displayepisode").at(0).toElement().text().toInt());
-    if (!episodeDetails.elementsByTagName("rating").isEmpty())
-        episode->setRating(episodeDetails.elementsByTagName("rating").at(0).toElement().text().replace(",", ".").toFloat());
-    if (!domDoc.elementsByTagName("votes").isEmpty())
-        episode->setVotes(domDoc.elementsByTagName("votes").at(0).toElement().text().replace(",", "").replace(".", "").toInt());
-    if (!domDoc.elementsByTagName("top250").isEmpty())
-        episode->setTop250(domDoc.elementsByTagName("top250").at(0).toElement().text().toInt());
-    if (!episodeDetails.elementsByTagName("plot").isEmpty())
-        episode->setOverview(episodeDetails.elementsByTagName("plot").at(0).toElement().text());
-    if (!episodeDetails.elementsByTagName("mpaa").isEmpty())
-        episode->setCertification(episodeDetails.elementsByTagName("mpaa").at(0).toElement().text());
-    if (!episodeDetails.elementsByTagName("aired").isEmpty())
-        episode->setFirstAired(QDate::fromString(episodeDetails.elementsByTagName("aired").at(0).toElement().text(), "yyyy-MM-dd"));
-    if (!episodeDetails.elementsByTagName("playcount").isEmpty())
-        episode->setPlayCount(episodeDetails.elementsByTagName("playcount").at(0).toElement().text().toInt());
-    if (!episodeDetails.elementsByTagName("epbookmark").isEmpty())
-        episode->setEpBookmark(QTime(0, 0, 0).addSecs(episodeDetails.elementsByTagName("epbookmark").at(0).toElement().text().toInt()));
-    if (!episodeDetails.elementsByTagName("lastplayed").isEmpty())
-        episode->setLastPlayed(QDateTime::fromString(episodeDetails.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss"));
-    if (!episodeDetails.elementsByTagName("studio").isEmpty())
-        episode->setNetwork(episodeDetails.elementsByTagName("studio").at(0).toElement().text());
-    if (!episodeDetails.elementsByTagName("thumb").isEmpty())
-        episode->setThumbnail(QUrl(episodeDetails.elementsByTagName("thumb").at(0).toElement().text()));
-    for (int i=0, n=episodeDetails.elementsByTagName("credits").size() ; i<n ; i++)
-        episode->addWriter(episodeDetails.elementsByTagName("credits").at(i).toElement().text());
-    for (int i=0, n=episodeDetails.elementsByTagName("director").size() ; i<n ; i++)
-        episode->addDirector(episodeDetails.elementsByTagName("director").at(i).toElement().text());
-    for (int i=0, n=domDoc.elementsByTagName("actor").size() ; i<n ; i++) {
-        Actor a;
-        a.imageHasChanged = false;
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("name").isEmpty())
-            a.name = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("name").at(0).toElement().text();
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("role").isEmpty())
-            a.role = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("role").at(0).toElement().text();
-        if (!domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("thumb").isEmpty())
-            a.thumb = domDoc.elementsByTagName("actor").at(i).toElement().elementsByTagName("thumb").at(0).toElement().text();
-        episode->addActor(a);
-    }
-
-    if (episodeDetails.elementsByTagName("streamdetails").count() > 0) {
-        loadStreamDetails(episode->streamDetails(), episodeDetails.elementsByTagName("streamdetails").at(0).toElement());
-        episode->setStreamDetailsLoaded(true);
-    } else {
-        episode->setStreamDetailsLoaded(false);
+    return false;
+}
+
+/**
+ * @brief Finds the episodedetails element of an episode in a multi episode nfo
+ * @param nfoContent Nfo content with all episodedetails elements below one root element
+ * @param season Season number
+ * @param episode Episode number
+ * @return Index of the episodedetails element or -1 if no element matches
+ */
+int XbmcXml::episodeDetailsIndex(const QString &nfoContent, int season, int episode)
+{
+    QXmlStreamReader xml(nfoContent);
+    if (!xml.readNextStartElement())
+        return -1;
+
+    int index = 0;
+    while (xml.readNextStartElement()) {
+        if (xml.name() != "episodedetails") {
+            xml.skipCurrentElement();
+            continue;
+        }
+        int detailsSeason = -2;
+        int detailsEpisode = -2;
+        while (xml.readNextStartElement()) {
+            if (xml.name() == "season")
+                detailsSeason = readNfoText(xml).toInt();
+            else if (xml.name() == "episode")
+                detailsEpisode = readNfoText(xml).toInt();
+            else
+                xml.skipCurrentElement();
+        }
+        if (detailsSeason == season && detailsEpisode == episode)
+            return index;
+        index++;
     }
+    return -1;
+}
 
-    return true;
+/**
+ * @brief Loads the infos of an episode from an episodedetails element
+ * @param episode Episode to load infos for
+ * @param xml Stream reader positioned at the start of the episodedetails element
+ */
+void XbmcXml::loadEpisodeDetails(TvShowEpisode *episode, QXmlStreamReader &xml)
+{
+    bool thumbnailLoaded = false;
+    bool streamDetailsLoaded = false;
+    while (xml.readNextStartElement()) {
+        const QStringRef name = xml.name();
+        if (name == "imdbid") {
+            episode->setImdbId(readNfoText(xml));
+        } else if (name == "title") {
+            episode->setName(readNfoText(xml));
+        } else if (name == "showtitle") {
+            episode->setShowTitle(readNfoText(xml));
+        } else if (name == "season") {
+            episode->setSeason(readNfoText(xml).toInt());
+        } else if (name == "episode") {
+            episode->setEpisode(readNfoText(xml).toInt());
+        } else if (name == "displayseason") {
+            episode->setDisplaySeason(readNfoText(xml).toInt());
+        } else if (name == "displayepisode") {
+            episode->setDisplayEpisode(readNfoText(xml).toInt());
+        } else if (name == "rating") {
+            episode->setRating(readNfoText(xml).replace(",", ".").toFloat());
+        } else if (name == "votes") {
+            episode->setVotes(readNfoText(xml).replace(",", "").replace(".", "").toInt());
+        } else if (name == "top250") {
+            episode->setTop250(readNfoText(xml).toInt());
+        } else if (name == "plot") {
+            episode->setOverview(readNfoText(xml));
+        } else if (name == "mpaa") {
+            episode->setCertification(readNfoText(xml));
+        } else if (name == "aired") {
+            episode->setFirstAired(QDate::fromString(readNfoText(xml), "yyyy-MM-dd"));
+        } else if (name == "playcount") {
+            episode->setPlayCount(readNfoText(xml).toInt());
+        } else if (name == "epbookmark") {
+            episode->setEpBookmark(QTime(0, 0, 0).addSecs(readNfoText(xml).toInt()));
+        } else if (name == "lastplayed") {
+            episode->setLastPlayed(QDateTime::fromString(readNfoText(xml), "yyyy-MM-dd HH:mm:ss"));
+        } else if (name == "studio") {
+            episode->setNetwork(readNfoText(xml));
+        } else if (name == "thumb" && !thumbnailLoaded) {
+            episode->setThumbnail(QUrl(readNfoText(xml)));
+            thumbnailLoaded = true;
+        } else if (name == "credits") {
+            episode->addWriter(readNfoText(xml));
+        } else if (name == "director") {
+            episode->addDirector(readNfoText(xml));
+        } else if (name == "actor") {
+            episode->addActor(readActor(xml));
+        } else if (name == "fileinfo") {
+            streamDetailsLoaded = loadFileInfo(episode->streamDetails(), xml) || streamDetailsLoaded;
+        } else {
+            xml.skipCurrentElement();
+        }
+    }
+    episode->setStreamDetailsLoaded(streamDetailsLoaded);
 }
 
 /**
@@ -2013,63 +2100,69 @@ bool XbmcXml::loadArtist(Artist *artist, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-    if (!domDoc.elementsByTagName("musicBrainzArtistID").isEmpty())
-        artist->setMbId(domDoc.elementsByTagName("musicBrainzArtistID").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("allmusicid").isEmpty())
-        artist->setAllMusicId(domDoc.elementsByTagName("allmusicid").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("name").isEmpty())
-        artist->setName(domDoc.elementsByTagName("name").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("genre").isEmpty())
-        artist->setGenres(domDoc.elementsByTagName("genre").at(0).toElement().text().split(" / ", QString::SkipEmptyParts));
-    for (int i=0, n=domDoc.elementsByTagName("style").size() ; i<n ; i++)
-        artist->addStyle(domDoc.elementsByTagName("style").at(i).toElement().text());
-    for (int i=0, n=domDoc.elementsByTagName("mood").size() ; i<n ; i++)
-        artist->addMood(domDoc.elementsByTagName("mood").at(i).toElement().text());
-    if (!domDoc.elementsByTagName("yearsactive").isEmpty())
-        artist->setYearsActive(domDoc.elementsByTagName("yearsactive").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("formed").isEmpty())
-        artist->setFormed(domDoc.elementsByTagName("formed").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("biography").isEmpty())
-        artist->setBiography(domDoc.elementsByTagName("biography").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("born").isEmpty())
-        artist->setBorn(domDoc.elementsByTagName("born").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("died").isEmpty())
-        artist->setDied(domDoc.elementsByTagName("died").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("disbanded").isEmpty())
-        artist->setDisbanded(domDoc.elementsByTagName("disbanded").at(0).toElement().text());
-
-    for (int i=0, n=domDoc.elementsByTagName("thumb").size() ; i<n ; i++) {
-        QString parentTag = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().tagName();
-        if (parentTag == "artist") {
-            Poster p;
-            p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-            if (!domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview").isEmpty())
-                p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-            else
-                p.thumbUrl = p.originalUrl;
-            artist->addImage(ImageType::ArtistThumb, p);
-        } else if (parentTag == "fanart") {
-            Poster p;
-            p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-            if (!domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview").isEmpty())
-                p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-            else
-                p.thumbUrl = p.originalUrl;
-            artist->addImage(ImageType::ArtistFanart, p);
+    bool genresLoaded = false;
+    QXmlStreamReader xml(nfoContent);
+    if (xml.readNextStartElement()) {
+        while (xml.readNextStartElement()) {
+            const QStringRef name = xml.name();
+            if (name == "musicBrainzArtistID") {
+                artist->setMbId(readNfoText(xml));
+            } else if (name == "allmusicid") {
+                artist->setAllMusicId(readNfoText(xml));
+            } else if (name == "name") {
+                artist->setName(readNfoText(xml));
+            } else if (name == "genre" && !genresLoaded) {
+                artist->setGenres(readNfoText(xml).split(" / ", QString::SkipEmptyParts));
+                genresLoaded = true;
+            } else if (name == "style") {
+                artist->addStyle(readNfoText(xml));
+            } else if (name == "mood") {
+                artist->addMood(readNfoText(xml));
+            } else if (name == "yearsactive") {
+                artist->setYearsActive(readNfoText(xml));
+            } else if (name == "formed") {
+                artist->setFormed(readNfoText(xml));
+            } else if (name == "biography") {
+                artist->setBiography(readNfoText(xml));
+            } else if (name == "born") {
+                artist->setBorn(readNfoText(xml));
+            } else if (name == "died") {
+                artist->setDied(readNfoText(xml));
+            } else if (name == "disbanded") {
+                artist->setDisbanded(readNfoText(xml));
+            } else if (name == "thumb") {
+                Poster p = readPoster(xml);
+                if (p.thumbUrl.isEmpty())
+                    p.thumbUrl = p.originalUrl;
+                artist->addImage(ImageType::ArtistThumb, p);
+            } else if (name == "fanart") {
+                while (xml.readNextStartElement()) {
+                    if (xml.name() == "thumb") {
+                        Poster p = readPoster(xml);
+                        if (p.thumbUrl.isEmpty())
+                            p.thumbUrl = p.originalUrl;
+                        artist->addImage(ImageType::ArtistFanart, p);
+                    } else {
+                        xml.skipCurrentElement();
+                    }
+                }
+            } else if (name == "album") {
+                DiscographyAlbum a;
+                while (xml.readNextStartElement()) {
+                    if (xml.name() == "title")
+                        a.title = readNfoText(xml);
+                    else if (xml.name() == "year")
+                        a.year = readNfoText(xml);
+                    else
+                        xml.skipCurrentElement();
+                }
+                artist->addDiscographyAlbum(a);
+            } else {
+                xml.skipCurrentElement();
+            }
         }
     }
 
-    for (int i=0, n=domDoc.elementsByTagName("album").size() ; i<n ; i++) {
-        DiscographyAlbum a;
-        if (!domDoc.elementsByTagName("album").at(i).toElement().elementsByTagName("title").isEmpty())
-            a.title = domDoc.elementsByTagName("album").at(i).toElement().elementsByTagName("title").at(0).toElement().text();
-        if (!domDoc.elementsByTagName("album").at(i).toElement().elementsByTagName("year").isEmpty())
-            a.year = domDoc.elementsByTagName("album").at(i).toElement().elementsByTagName("year").at(0).toElement().text();
-        artist->addDiscographyAlbum(a);
-    }
-
     artist->setHasChanged(false);
 
     return true;
@@ -2100,43 +2193,47 @@ bool XbmcXml::loadAlbum(Album *album, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
-    if (!domDoc.elementsByTagName("musicBrainzReleaseGroupID").isEmpty())
-        album->setMbReleaseGroupId(domDoc.elementsByTagName("musicBrainzReleaseGroupID").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("musicBrainzAlbumID").isEmpty())
-        album->setMbAlbumId(domDoc.elementsByTagName("musicBrainzAlbumID").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("allmusicid").isEmpty())
-        album->setAllMusicId(domDoc.elementsByTagName("allmusicid").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("title").isEmpty())
-        album->setTitle(domDoc.elementsByTagName("title").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("artist").isEmpty())
-        album->setArtist(domDoc.elementsByTagName("artist").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("genre").isEmpty())
-        album->setGenres(domDoc.elementsByTagName("genre").at(0).toElement().text().split(" / ", QString::SkipEmptyParts));
-    for (int i=0, n=domDoc.elementsByTagName("style").size() ; i<n ; i++)
-        album->addStyle(domDoc.elementsByTagName("style").at(i).toElement().text());
-    for (int i=0, n=domDoc.elementsByTagName("mood").size() ; i<n ; i++)
-        album->addMood(domDoc.elementsByTagName("mood").at(i).toElement().text());
-    if (!domDoc.elementsByTagName("review").isEmpty())
-        album->setReview(domDoc.elementsByTagName("review").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("label").isEmpty())
-        album->setLabel(domDoc.elementsByTagName("label").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("releasedate").isEmpty())
-        album->setReleaseDate(domDoc.elementsByTagName("releasedate").at(0).toElement().text());
-    if (!domDoc.elementsByTagName("year").isEmpty())
-        album->setYear(domDoc.elementsByTagName("year").at(0).toElement().text().toInt());
-    if (!domDoc.elementsByTagName("rating").isEmpty())
-        album->setRating(domDoc.elementsByTagName("rating").at(0).toElement().text().replace(",", ".").toFloat());
-    for (int i=0, n=domDoc.elementsByTagName("thumb").size() ; i<n ; i++) {
-        Poster p;
-        p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-        if (!domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview").isEmpty())
-            p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-        else
-            p.thumbUrl = p.originalUrl;
-        album->addImage(ImageType::AlbumThumb, p);
+    bool genresLoaded = false;
+    QXmlStreamReader xml(nfoContent);
+    if (xml.readNextStartElement()) {
+        while (xml.readNextStartElement()) {
+            const QStringRef name = xml.name();
+            if (name == "musicBrainzReleaseGroupID") {
+                album->setMbReleaseGroupId(readNfoText(xml));
+            } else if (name == "musicBrainzAlbumID") {
+                album->setMbAlbumId(readNfoText(xml));
+            } else if (name == "allmusicid") {
+                album->setAllMusicId(readNfoText(xml));
+            } else if (name == "title") {
+                album->setTitle(readNfoText(xml));
+            } else if (name == "artist") {
+                album->setArtist(readNfoText(xml));
+            } else if (name == "genre" && !genresLoaded) {
+                album->setGenres(readNfoText(xml).split(" / ", QString::SkipEmptyParts));
+                genresLoaded = true;
+            } else if (name == "style") {
+                album->addStyle(readNfoText(xml));
+            } else if (name == "mood") {
+                album->addMood(readNfoText(xml));
+            } else if (name == "review") {
+                album->setReview(readNfoText(xml));
+            } else if (name == "label") {
+                album->setLabel(readNfoText(xml));
+            } else if (name == "releasedate") {
+                album->setReleaseDate(readNfoText(xml));
+            } else if (name == "year") {
+                album->setYear(readNfoText(xml).toInt());
+            } else if (name == "rating") {
+                album->setRating(readNfoText(xml).replace(",", ".").toFloat());
+            } else if (name == "thumb") {
+                Poster p = readPoster(xml);
+                if (p.thumbUrl.isEmpty())
+                    p.thumbUrl = p.originalUrl;
+                album->addImage(ImageType::AlbumThumb, p);
+            } else {
+                xml.skipCurrentElement();
+            }
+        }
     }
 
     album->setHasChanged(false);
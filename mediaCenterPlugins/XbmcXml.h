@@ -3,6 +3,7 @@
 
 #include <QDomDocument>
 #include <QObject>
+#include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
 #include "data/Concert.h"
@@ -76,8 +77,13 @@ private:
     QByteArray getTvShowXml(TvShow *show);
     QByteArray getArtistXml(Artist *artist);
     QByteArray getAlbumXml(Album *album);
-    bool loadStreamDetails(StreamDetails *streamDetails, QDomDocument domDoc);
-    void loadStreamDetails(StreamDetails *streamDetails, QDomElement elem);
+    QString readNfoText(QXmlStreamReader &xml);
+    Actor readActor(QXmlStreamReader &xml);
+    Poster readPoster(QXmlStreamReader &xml, const QString &baseUrl = QString());
+    bool loadFileInfo(StreamDetails *streamDetails, QXmlStreamReader &xml);
+    void loadStreamDetails(StreamDetails *streamDetails, QXmlStreamReader &xml);
+    int episodeDetailsIndex(const QString &nfoContent, int season, int episode);
+    void loadEpisodeDetails(TvShowEpisode *episode, QXmlStreamReader &xml);
     bool saveFile(QString filename, QByteArray data);
     QString getPath(Movie *movie);
     QString getPath(Concert *concert);
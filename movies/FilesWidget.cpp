@@ -7,12 +7,12 @@
 #include <QScrollBar>
 #include <QTableWidget>
 #include <QTimer>
+#include "data/ImageCache.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
 #include "globals/LocaleStringCompare.h"
 #include "globals/Manager.h"
 #include "movies/MovieMultiScrapeDialog.h"
-#include "smallWidgets/LoadingStreamDetails.h"
 
 FilesWidget *FilesWidget::m_instance;
 
@@ -87,6 +87,7 @@ FilesWidget::FilesWidget(QWidget *parent) :
     QAction *actionMarkAsWatched = new QAction(tr("Mark as watched"), this);
     QAction *actionMarkAsUnwatched = new QAction(tr("Mark as unwatched"), this);
     QAction *actionLoadStreamDetails = new QAction(tr("Load Stream Details"), this);
+    m_actionStopStreamDetails = new QAction(tr("Stop Loading Stream Details"), this);
     QAction *actionMarkForSync = new QAction(tr("Add to Synchronization Queue"), this);
     QAction *actionUnmarkForSync = new QAction(tr("Remove from Synchronization Queue"), this);
     QAction *actionOpenFolder = new QAction(tr("Open Movie Folder"), this);
@@ -98,6 +99,7 @@ FilesWidget::FilesWidget(QWidget *parent) :
     m_contextMenu->addAction(actionMarkAsUnwatched);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionLoadStreamDetails);
+    m_contextMenu->addAction(m_actionStopStreamDetails);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionMarkForSync);
     m_contextMenu->addAction(actionUnmarkForSync);
@@ -116,6 +118,8 @@ FilesWidget::FilesWidget(QWidget *parent) :
     connect(actionUnmarkForSync, SIGNAL(triggered()), this, SLOT(unmarkForSync()));
     connect(actionOpenFolder, SIGNAL(triggered()), this, SLOT(openFolder()));
     connect(actionOpenNfo, SIGNAL(triggered()), this, SLOT(openNfoFile()));
+    connect(m_actionStopStreamDetails, SIGNAL(triggered()), Manager::instance()->streamDetailsLoader(), SLOT(abort()));
+    connect(Manager::instance()->streamDetailsLoader(), SIGNAL(sigLoaded(Movie*)), this, SLOT(onStreamDetailsLoaded(Movie*)));
 
     connect(ui->files, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(showContextMenu(QPoint)));
     connect(ui->files->selectionModel(), SIGNAL(currentChanged(QModelIndex,QModelIndex)), this, SLOT(itemActivated(QModelIndex, QModelIndex)));
@@ -165,6 +169,7 @@ void FilesWidget::resizeEvent(QResizeEvent *event)
 
 void FilesWidget::showContextMenu(QPoint point)
 {
+    m_actionStopStreamDetails->setEnabled(Manager::instance()->streamDetailsLoader()->isRunning());
     m_contextMenu->exec(ui->files->mapToGlobal(point));
 }
 
@@ -235,9 +240,7 @@ void FilesWidget::loadStreamDetails()
         movies.at(0)->controller()->loadStreamDetailsFromFile();
         movies.at(0)->setChanged(true);
     } else {
-        LoadingStreamDetails *loader = new LoadingStreamDetails(this);
-        loader->loadMovies(movies);
-        delete loader;
+        Manager::instance()->streamDetailsLoader()->load(movies);
     }
     movieSelectedEmitter();
     m_movieProxyModel->setSourceModel(Manager::instance()->movieModel());
@@ -316,6 +319,37 @@ void FilesWidget::itemActivated(QModelIndex index, QModelIndex previous)
     int row = index.model()->data(index, Qt::UserRole).toInt();
     m_lastMovie = Manager::instance()->movieModel()->movie(row);
     QTimer::singleShot(0, this, SLOT(movieSelectedEmitter()));
+    prefetchImages(index);
+}
+
+/**
+ * @brief Prefetches the poster and backdrop of the movies next to the selected one
+ * @param index Index of the selected movie
+ */
+void FilesWidget::prefetchImages(const QModelIndex &index)
+{
+    QMap<int, QStringList> images;
+    for (int i=-2 ; i<=2 ; ++i) {
+        QModelIndex sibling = index.sibling(index.row()+i, 0);
+        if (i == 0 || !sibling.isValid())
+            continue;
+        Movie *movie = Manager::instance()->movieModel()->movie(sibling.model()->data(sibling, Qt::UserRole).toInt());
+        foreach (const int &imageType, QList<int>() << ImageType::MoviePoster << ImageType::MovieBackdrop) {
+            if (movie->hasImage(imageType))
+                images[imageType] << Manager::instance()->mediaCenterInterface()->imageFileName(movie, imageType);
+        }
+    }
+    ImageCache::instance()->prefetchImages(images);
+}
+
+/**
+ * @brief Updates the movie widget when the stream details of the current movie were loaded in the background
+ * @param movie Movie whose stream details were loaded
+ */
+void FilesWidget::onStreamDetailsLoaded(Movie *movie)
+{
+    if (movie == m_lastMovie)
+        movieSelectedEmitter();
 }
 
 /**
@@ -1,6 +1,7 @@
 #ifndef FILESWIDGET_H
 #define FILESWIDGET_H
 
+#include <QAction>
 #include <QEvent>
 #include <QLabel>
 #include <QMenu>
@@ -55,6 +56,7 @@ protected:
 
 private slots:
     void itemActivated(QModelIndex index, QModelIndex previous);
+    void onStreamDetailsLoaded(Movie *movie);
     void onSortByName();
     void onSortByAdded();
     void onSortByYear();
@@ -80,12 +82,14 @@ private:
     MovieProxyModel *m_movieProxyModel;
     Movie *m_lastMovie;
     QModelIndex m_lastModelIndex;
+    QAction *m_actionStopStreamDetails;
     static FilesWidget *m_instance;
     QString m_baseLabelCss;
     QString m_activeLabelCss;
     QMenu *m_contextMenu;
     AlphabeticalList *m_alphaList;
     bool m_mouseIsIn;
+    void prefetchImages(const QModelIndex &index);
 };
 
 #endif // FILESWIDGET_H
@@ -27,6 +27,7 @@ Movie::Movie(QStringList files, QObject *parent) :
     m_watched = false;
     m_hasChanged = false;
     m_hasExtraFanarts = false;
+    m_hasActors = false;
     m_inSeparateFolder = false;
     m_syncNeeded = false;
     static int m_idCounter = 0;
@@ -99,14 +100,40 @@ void Movie::clear()
     m_nfoContent.clear();
 }
 
+/**
+ * @brief Drops the infos which are only needed when the movie is shown, saved or exported.
+ * The infos used by the movie list, filters and sorting are kept.
+ * @see MovieController::unloadDetails
+ */
+void Movie::clearDetails()
+{
+    bool hasActors = this->hasActors();
+    m_overview.clear();
+    m_outline.clear();
+    m_tagline.clear();
+    m_writer.clear();
+    m_actors.clear();
+    m_posters.clear();
+    m_backdrops.clear();
+    m_discArts.clear();
+    m_clearArts.clear();
+    m_logos.clear();
+    m_nfoContent.clear();
+    m_hasActors = hasActors;
+    clearImages();
+    clearExtraFanartData();
+}
+
 /**
  * @brief Clears contents of the movie based on a list
  * @param infos List of infos which should be cleared
  */
 void Movie::clear(QList<int> infos)
 {
-    if (infos.contains(MovieScraperInfos::Actors))
+    if (infos.contains(MovieScraperInfos::Actors)) {
         m_actors.clear();
+        m_hasActors = false;
+    }
     if (infos.contains(MovieScraperInfos::Backdrop)) {
         m_backdrops.clear();
         m_images.insert(ImageType::MovieBackdrop, QByteArray());
@@ -879,6 +906,7 @@ void Movie::setTrailer(QUrl trailer)
 void Movie::setActors(QList<Actor> actors)
 {
     m_actors = actors;
+    m_hasActors = false;
     setChanged(true);
 }
 
@@ -1356,6 +1384,27 @@ bool Movie::hasExtraFanarts() const
     return m_hasExtraFanarts;
 }
 
+/**
+ * @brief Holds if the movie has actors
+ * As long as the actors were not loaded (movie filled from the database cache) the cached state is returned.
+ * @return True if the movie has actors
+ * @see Movie::setHasActors
+ */
+bool Movie::hasActors() const
+{
+    return !m_actors.isEmpty() || m_hasActors;
+}
+
+/**
+ * @brief Sets if the movie has actors without loading them
+ * @param has Movie has actors
+ * @see Movie::hasActors
+ */
+void Movie::setHasActors(bool has)
+{
+    m_hasActors = has;
+}
+
 QList<int> Movie::imagesToRemove() const
 {
     return m_imagesToRemove;
@@ -1438,6 +1487,7 @@ void Movie::onSubtitleChanged()
 void Movie::setLabel(int label)
 {
     m_label = label;
+    emit sigChanged(this);
 }
 
 int Movie::label()
@@ -36,6 +36,7 @@ public:
 
     void clear();
     void clear(QList<int> infos);
+    void clearDetails();
 
     virtual QString name() const;
     virtual QString sortTitle() const;
@@ -165,6 +166,8 @@ public:
     // Images
     bool hasExtraFanarts() const;
     void setHasExtraFanarts(bool has);
+    bool hasActors() const;
+    void setHasActors(bool has);
     QByteArray image(int imageType);
     bool imageHasChanged(int imageType);
     void setHasImage(int imageType, bool has);
@@ -234,6 +237,7 @@ private:
     int m_mediaCenterId;
     int m_numPrimaryLangPosters;
     bool m_hasExtraFanarts;
+    bool m_hasActors;
     bool m_syncNeeded;
     bool m_streamDetailsLoaded;
     StreamDetails *m_streamDetails;
@@ -17,6 +17,7 @@ MovieController::MovieController(Movie *parent) :
     m_movie = parent;
     m_infoLoaded = false;
     m_infoFromNfoLoaded = false;
+    m_infoFromCache = false;
     m_downloadManager = new DownloadManager(this);
     m_downloadsInProgress = false;
     m_downloadsSize = 0;
@@ -39,6 +40,7 @@ bool MovieController::saveData(MediaCenterInterface *mediaCenterInterface)
 {
     qDebug() << "Entered";
 
+    completeFromNfo(mediaCenterInterface);
     if (!m_movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails())
         loadStreamDetailsFromFile();
     bool saved = mediaCenterInterface->saveMovie(m_movie);
@@ -62,6 +64,10 @@ bool MovieController::saveData(MediaCenterInterface *mediaCenterInterface)
  */
 bool MovieController::loadData(MediaCenterInterface *mediaCenterInterface, bool force, bool reloadFromNfo)
 {
+    // Infos restored from the database cache are sufficient unless the nfo is explicitly requested (e.g. when the movie is opened)
+    if (m_infoFromCache && !force && !reloadFromNfo)
+        return m_infoLoaded;
+
     if ((m_infoLoaded || m_movie->hasChanged()) && !force && (m_infoFromNfoLoaded || (m_movie->hasChanged() && !m_infoFromNfoLoaded) ))
         return m_infoLoaded;
 
@@ -114,11 +120,88 @@ bool MovieController::loadData(MediaCenterInterface *mediaCenterInterface, bool
     }
     m_infoLoaded = infoLoaded;
     m_infoFromNfoLoaded = infoLoaded && reloadFromNfo;
-    m_movie->setChanged(false);
+    m_infoFromCache = false;
     m_movie->blockSignals(false);
+    m_movie->setChanged(false);
     return infoLoaded;
 }
 
+/**
+ * @brief Marks the movie as filled from the database cache, the nfo file is parsed when the movie is loaded with reloadFromNfo
+ * @param infoLoaded Infos were loaded from an nfo file when the cache was written
+ */
+void MovieController::setInfoFromCache(bool infoLoaded)
+{
+    m_infoLoaded = infoLoaded;
+    m_infoFromNfoLoaded = false;
+    m_infoFromCache = true;
+}
+
+/**
+ * @brief Adds the infos which are not part of the database cache (plot, actors, thumbs...) from the nfo file.
+ *        Infos restored from the cache and changes made since are kept.
+ * @param mediaCenterInterface MediaCenterInterface to use for loading
+ */
+void MovieController::completeFromNfo(MediaCenterInterface *mediaCenterInterface)
+{
+    if (!m_infoFromCache)
+        return;
+    m_infoFromCache = false;
+    if (!m_infoLoaded)
+        return;
+
+    Movie nfoMovie(m_movie->files());
+    nfoMovie.setInSeparateFolder(m_movie->inSeparateFolder());
+    nfoMovie.setDiscType(m_movie->discType());
+    if (!mediaCenterInterface->loadMovie(&nfoMovie))
+        return;
+
+    bool changed = m_movie->hasChanged();
+    m_movie->blockSignals(true);
+    m_movie->setNfoContent(nfoMovie.nfoContent());
+    m_movie->setOverview(nfoMovie.overview());
+    m_movie->setOutline(nfoMovie.outline());
+    m_movie->setTagline(nfoMovie.tagline());
+    m_movie->setWriter(nfoMovie.writer());
+    if (m_movie->actors().isEmpty())
+        m_movie->setActors(nfoMovie.actors());
+    if (m_movie->posters().isEmpty()) {
+        foreach (const Poster &poster, nfoMovie.posters())
+            m_movie->addPoster(poster);
+    }
+    if (m_movie->backdrops().isEmpty()) {
+        foreach (const Poster &backdrop, nfoMovie.backdrops())
+            m_movie->addBackdrop(backdrop);
+    }
+    m_movie->setChanged(changed);
+    m_movie->blockSignals(false);
+}
+
+/**
+ * @brief Drops the details (plot, actors, thumbs...) of an unchanged movie.
+ *        Afterwards the movie is treated like one restored from the database cache,
+ *        the details are read from the nfo file again when they're needed.
+ * @return True if the details were dropped
+ * @see MovieModel::touchDetails
+ */
+bool MovieController::unloadDetails()
+{
+    if (m_infoFromCache || m_movie->hasChanged() || m_downloadsInProgress || !m_loadsLeft.isEmpty())
+        return false;
+    m_movie->clearDetails();
+    setInfoFromCache(m_infoLoaded);
+    return true;
+}
+
+/**
+ * @brief Holds if the movies infos were only restored from the database cache
+ * @return True if the nfo file was not parsed yet
+ */
+bool MovieController::infoFromCache() const
+{
+    return m_infoFromCache;
+}
+
 /**
  * @brief Loads the movies info from a scraper
  * @param id Id of the movie within the given ScraperInterface
@@ -127,6 +210,7 @@ bool MovieController::loadData(MediaCenterInterface *mediaCenterInterface, bool
  */
 void MovieController::loadData(QMap<ScraperInterface*, QString> ids, ScraperInterface *scraperInterface, QList<int> infos)
 {
+    completeFromNfo(Manager::instance()->mediaCenterInterface());
     m_infosToLoad = infos;
     if (scraperInterface->identifier() == "tmdb" && !ids.values().first().startsWith("tt"))
         m_movie->setTmdbId(ids.values().first());
@@ -276,6 +360,7 @@ void MovieController::onFanartLoadDone(Movie *movie, QMap<int, QList<Poster> > p
         d.imageType = it.key();
         d.url = it.value().at(0).originalUrl;
         d.movie = m_movie;
+        d.priority = true;
         downloads.append(d);
         if (!imageTypes.contains(it.key()))
             imageTypes.append(it.key());
@@ -331,6 +416,7 @@ void MovieController::loadImage(int type, QUrl url)
     d.movie = m_movie;
     d.imageType = type;
     d.url = url;
+    d.priority = true;
     emit sigLoadingImages(m_movie, QList<int>() << type);
     m_downloadManager->addDownload(d);
 }
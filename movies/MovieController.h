@@ -28,6 +28,10 @@ public:
     void scraperLoadDone(ScraperInterface *scraper);
     QList<int> infosToLoad();
     bool infoLoaded() const;
+    void setInfoFromCache(bool infoLoaded);
+    bool infoFromCache() const;
+    void completeFromNfo(MediaCenterInterface *mediaCenterInterface);
+    bool unloadDetails();
     bool downloadsInProgress() const;
     void loadImage(int type, QUrl url);
     void loadImages(int type, QList<QUrl> urls);
@@ -58,6 +62,7 @@ private:
     Movie *m_movie;
     bool m_infoLoaded;
     bool m_infoFromNfoLoaded;
+    bool m_infoFromCache;
     QList<int> m_infosToLoad;
     DownloadManager *m_downloadManager;
     bool m_downloadsInProgress;
@@ -2,7 +2,6 @@
 #include "ui_MovieMultiScrapeDialog.h"
 
 #include "globals/Manager.h"
-#include "scrapers/CustomMovieScraper.h"
 #include "smallWidgets/MyCheckBox.h"
 
 MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget *parent) :
@@ -26,7 +25,7 @@ MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget *parent) :
     ui->movieCounter->setFont(font);
 
     m_executed = false;
-    m_currentMovie = 0;
+    m_multiScraper = new MovieMultiScraper(this);
 
     ui->chkActors->setMyData(MovieScraperInfos::Actors);
     ui->chkBackdrop->setMyData(MovieScraperInfos::Backdrop);
@@ -62,6 +61,10 @@ MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget *parent) :
     connect(ui->chkUnCheckAll, SIGNAL(clicked()), this, SLOT(onChkAllToggled()));
     connect(ui->btnStartScraping, SIGNAL(clicked()), this, SLOT(onStartScraping()));
     connect(ui->comboScraper, SIGNAL(currentIndexChanged(int)), this, SLOT(setChkBoxesEnabled()));
+    connect(m_multiScraper, SIGNAL(sigMovieStarted(Movie*)), this, SLOT(onMovieStarted(Movie*)));
+    connect(m_multiScraper, SIGNAL(sigMovieDone(Movie*)), this, SLOT(onMovieDone(Movie*)));
+    connect(m_multiScraper, SIGNAL(sigDownloadProgress(Movie*,int,int)), this, SLOT(onProgress(Movie*,int,int)));
+    connect(m_multiScraper, SIGNAL(sigFinished()), this, SLOT(onScrapingFinished()));
 }
 
 MovieMultiScrapeDialog::~MovieMultiScrapeDialog()
@@ -79,7 +82,7 @@ MovieMultiScrapeDialog *MovieMultiScrapeDialog::instance(QWidget *parent)
 
 int MovieMultiScrapeDialog::exec()
 {
-    m_queue.clear();
+    m_downloads.clear();
     ui->movieCounter->setVisible(false);
     ui->comboScraper->setEnabled(true);
     ui->btnCancel->setVisible(true);
@@ -92,7 +95,6 @@ int MovieMultiScrapeDialog::exec()
     ui->progressMovie->setValue(0);
     ui->groupBox->setEnabled(true);
     ui->movie->clear();
-    m_currentMovie = 0;
     m_executed = true;
     setChkBoxesEnabled();
     adjustSize();
@@ -104,8 +106,6 @@ int MovieMultiScrapeDialog::exec()
 
 void MovieMultiScrapeDialog::accept()
 {
-    foreach (ScraperInterface *scraper, Manager::instance()->scrapers())
-        disconnect(scraper, SIGNAL(searchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchFinished(QList<ScraperSearchResult>)));
     m_executed = false;
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyImdb->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
@@ -115,13 +115,8 @@ void MovieMultiScrapeDialog::accept()
 
 void MovieMultiScrapeDialog::reject()
 {
-    foreach (ScraperInterface *scraper, Manager::instance()->scrapers())
-        disconnect(scraper, SIGNAL(searchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchFinished(QList<ScraperSearchResult>)));
     m_executed = false;
-    if (m_currentMovie) {
-        m_queue.clear();
-        m_currentMovie->controller()->abortDownloads();
-    }
+    m_multiScraper->abort();
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyImdb->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
     Settings::instance()->saveSettings();
@@ -135,9 +130,6 @@ void MovieMultiScrapeDialog::setMovies(QList<Movie *> movies)
 
 void MovieMultiScrapeDialog::onStartScraping()
 {
-    foreach (ScraperInterface *scraper, Manager::instance()->scrapers())
-        disconnect(scraper, SIGNAL(searchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchFinished(QList<ScraperSearchResult>)));
-
     ui->groupBox->setEnabled(false);
     ui->comboScraper->setEnabled(false);
     ui->btnStartScraping->setEnabled(false);
@@ -151,14 +143,15 @@ void MovieMultiScrapeDialog::onStartScraping()
     m_isTmdb = m_scraperInterface->identifier() == "tmdb";
     m_isImdb = m_scraperInterface->identifier() == "imdb";
 
-    connect(m_scraperInterface, SIGNAL(searchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchFinished(QList<ScraperSearchResult>)), Qt::UniqueConnection);
-
-    m_queue.append(m_movies);
-
-    ui->movieCounter->setText(QString("0/%1").arg(m_queue.count()));
+    ui->movieCounter->setText(QString("0/%1").arg(m_movies.count()));
     ui->movieCounter->setVisible(true);
     ui->progressAll->setMaximum(m_movies.count());
-    scrapeNext();
+
+    m_multiScraper->setScraper(m_scraperInterface);
+    m_multiScraper->setInfosToLoad(m_infosToLoad);
+    m_multiScraper->setOnlyWithId(ui->chkOnlyImdb->isChecked());
+    m_multiScraper->setSaveEach(ui->chkAutoSave->isChecked());
+    m_multiScraper->start(m_movies);
 }
 
 void MovieMultiScrapeDialog::onScrapingFinished()
@@ -179,107 +172,54 @@ void MovieMultiScrapeDialog::onScrapingFinished()
     ui->btnStartScraping->setVisible(false);
 }
 
-void MovieMultiScrapeDialog::scrapeNext()
+void MovieMultiScrapeDialog::onMovieStarted(Movie *movie)
 {
     if (!isExecuted())
         return;
-
-    if (m_currentMovie && ui->chkAutoSave->isChecked())
-        m_currentMovie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-
-    if (m_queue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
-
-    m_currentMovie = m_queue.dequeue();
-
-    ui->movie->setText(m_currentMovie->name());
-    ui->movieCounter->setText(QString("%1/%2").arg(m_movies.count()-m_queue.count()).arg(m_movies.count()));
-
-    ui->progressAll->setValue(ui->progressAll->maximum()-m_queue.size()-1);
-    ui->progressMovie->setValue(0);
-
-    if (ui->chkOnlyImdb->isChecked() && (
-            (m_currentMovie->id().isEmpty() && m_isImdb) ||
-            (m_currentMovie->tmdbId().isEmpty() && m_currentMovie->id().isEmpty() && m_isTmdb) ||
-            (m_currentMovie->id().isEmpty() && m_currentMovie->tmdbId().isEmpty() && m_scraperInterface->identifier() == "custom-movie")
-        )) {
-        scrapeNext();
-        return;
-    }
-
-    connect(m_currentMovie->controller(), SIGNAL(sigLoadDone(Movie*)), this, SLOT(scrapeNext()), Qt::UniqueConnection);
-    connect(m_currentMovie->controller(), SIGNAL(sigDownloadProgress(Movie*,int,int)), this, SLOT(onProgress(Movie*,int,int)), Qt::UniqueConnection);
-
-    m_currentIds.clear();
-
-    if (m_isImdb && !m_currentMovie->id().isEmpty()) {
-        loadMovieData(m_currentMovie, m_currentMovie->id());
-    } else if (m_isTmdb && !m_currentMovie->tmdbId().isEmpty()) {
-        loadMovieData(m_currentMovie, m_currentMovie->tmdbId());
-    } else if (m_isTmdb && !m_currentMovie->id().isEmpty()) {
-        loadMovieData(m_currentMovie, m_currentMovie->id());
-    } else if (m_scraperInterface->identifier() == "custom-movie") {
-        if ((CustomMovieScraper::instance()->titleScraper()->identifier() == "imdb" || CustomMovieScraper::instance()->titleScraper()->identifier() == "tmdb") &&
-                !m_currentMovie->id().isEmpty())
-            m_scraperInterface->search(m_currentMovie->id());
-        else if (CustomMovieScraper::instance()->titleScraper()->identifier() == "tmdb" && !m_currentMovie->tmdbId().isEmpty())
-            m_scraperInterface->search("id" + m_currentMovie->tmdbId());
-        else
-            m_scraperInterface->search(m_currentMovie->name());
-    } else {
-        m_scraperInterface->search(m_currentMovie->name());
-    }
+    m_downloads.insert(movie, qMakePair(0, 0));
+    updateStatus();
 }
 
-void MovieMultiScrapeDialog::loadMovieData(Movie *movie, QString id)
-{
-    QMap<ScraperInterface*, QString> ids;
-    ids.insert(0, id);
-    movie->controller()->loadData(ids, m_scraperInterface, m_infosToLoad);
-}
-
-void MovieMultiScrapeDialog::onSearchFinished(QList<ScraperSearchResult> results)
+void MovieMultiScrapeDialog::onMovieDone(Movie *movie)
 {
     if (!isExecuted())
         return;
-    if (results.isEmpty()) {
-        scrapeNext();
-        return;
-    }
-
-    if (m_scraperInterface->identifier() == "custom-movie") {
-        ScraperInterface *scraper = static_cast<ScraperInterface*>(QObject::sender());
-        m_currentIds.insert(scraper, results.first().id);
-        QList<ScraperInterface*> searchScrapers = CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, m_currentIds);
-        if (!searchScrapers.isEmpty()) {
-            connect(searchScrapers.first(), SIGNAL(searchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchFinished(QList<ScraperSearchResult>)), Qt::UniqueConnection);
-            if ((searchScrapers.first()->identifier() == "tmdb" || searchScrapers.first()->identifier() == "imdb") && !m_currentMovie->id().isEmpty())
-                searchScrapers.first()->search(m_currentMovie->id());
-            else if (searchScrapers.first()->identifier() == "tmdb" && !m_currentMovie->tmdbId().isEmpty() && !m_currentMovie->tmdbId().startsWith("tt"))
-                searchScrapers.first()->search("id" + m_currentMovie->tmdbId());
-            else if (searchScrapers.first()->identifier() == "tmdb" && !m_currentMovie->tmdbId().isEmpty())
-                searchScrapers.first()->search(m_currentMovie->tmdbId());
-            else
-                searchScrapers.first()->search(m_currentMovie->name());
-            return;
-        }
-    } else {
-        m_currentIds.insert(m_scraperInterface, results.first().id);
-    }
-
-    m_currentMovie->controller()->loadData(m_currentIds, m_scraperInterface, m_infosToLoad);
+    m_downloads.remove(movie);
+    updateStatus();
 }
 
 void MovieMultiScrapeDialog::onProgress(Movie *movie, int current, int maximum)
 {
-    Q_UNUSED(movie);
-
-    if (!isExecuted())
+    if (!isExecuted() || !m_downloads.contains(movie))
         return;
-    ui->progressMovie->setValue(maximum-current);
-    ui->progressMovie->setMaximum(maximum);
+    m_downloads.insert(movie, qMakePair(maximum-current, maximum));
+    updateStatus();
+}
+
+/**
+ * @brief Shows the movies in progress, the summed up image downloads of them and the throughput
+ */
+void MovieMultiScrapeDialog::updateStatus()
+{
+    QStringList names;
+    foreach (Movie *movie, m_multiScraper->activeMovies())
+        names << movie->name();
+    ui->movie->setText(names.join(", "));
+
+    int done = m_multiScraper->moviesDone();
+    ui->movieCounter->setText(tr("%1/%2 - %3 titles per minute").arg(done).arg(m_movies.count()).arg(m_multiScraper->titlesPerMinute(), 0, 'f', 1));
+    ui->progressAll->setValue(done);
+
+    int downloaded = 0;
+    int downloads = 0;
+    QHashIterator<Movie*, QPair<int, int> > it(m_downloads);
+    while (it.hasNext()) {
+        it.next();
+        downloaded += it.value().first;
+        downloads += it.value().second;
+    }
+    ui->progressMovie->setMaximum(qMax(1, downloads));
+    ui->progressMovie->setValue(downloaded);
 }
 
 bool MovieMultiScrapeDialog::isExecuted()
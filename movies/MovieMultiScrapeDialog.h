@@ -2,9 +2,10 @@
 #define MOVIEMULTISCRAPEDIALOG_H
 
 #include <QDialog>
-#include <QPointer>
-#include <QQueue>
+#include <QHash>
+#include <QPair>
 #include "movies/Movie.h"
+#include "movies/MovieMultiScraper.h"
 
 namespace Ui {
 class MovieMultiScrapeDialog;
@@ -28,8 +29,8 @@ public slots:
 private slots:
     void onStartScraping();
     void onScrapingFinished();
-    void onSearchFinished(QList<ScraperSearchResult> results);
-    void scrapeNext();
+    void onMovieStarted(Movie *movie);
+    void onMovieDone(Movie *movie);
     void onProgress(Movie *movie, int current, int maximum);
     void onChkToggled();
     void onChkAllToggled();
@@ -38,16 +39,15 @@ private slots:
 private:
     Ui::MovieMultiScrapeDialog *ui;
     QList<Movie*> m_movies;
-    QQueue<Movie*> m_queue;
-    QPointer<Movie> m_currentMovie;
+    MovieMultiScraper *m_multiScraper;
     ScraperInterface *m_scraperInterface;
-    QMap<ScraperInterface*, QString> m_currentIds;
+    QHash<Movie*, QPair<int, int> > m_downloads;
     bool m_isImdb;
     bool m_isTmdb;
     bool m_executed;
     QList<int> m_infosToLoad;
-    void loadMovieData(Movie *movie, QString id);
     bool isExecuted();
+    void updateStatus();
 };
 
 #endif // MOVIEMULTISCRAPEDIALOG_H
@@ -0,0 +1,317 @@
+#include "MovieMultiScraper.h"
+
+#include "globals/Manager.h"
+#include "scrapers/CustomMovieScraper.h"
+
+/**
+ * @brief MovieMultiScraper::MovieMultiScraper
+ * @param parent
+ */
+MovieMultiScraper::MovieMultiScraper(QObject *parent) :
+    QObject(parent),
+    m_scraper(0),
+    m_onlyWithId(false),
+    m_saveEach(false)
+{
+    m_runner = new MultiScrapeRunner(this);
+    connect(m_runner, SIGNAL(sigStartItem(QObject*)), this, SLOT(onStartItem(QObject*)));
+    connect(m_runner, SIGNAL(sigStartSearch(QObject*)), this, SLOT(onStartSearch(QObject*)));
+    connect(m_runner, SIGNAL(sigStartLoad(QObject*)), this, SLOT(onStartLoad(QObject*)));
+    connect(m_runner, SIGNAL(sigItemDone(QObject*)), this, SLOT(onItemDone(QObject*)));
+    connect(m_runner, SIGNAL(sigFinished()), this, SLOT(onFinished()));
+}
+
+void MovieMultiScraper::setScraper(ScraperInterface *scraper)
+{
+    m_scraper = scraper;
+}
+
+void MovieMultiScraper::setInfosToLoad(QList<int> infos)
+{
+    m_infosToLoad = infos;
+}
+
+/**
+ * @brief Sets if only movies with an IMDB or TMDb id should be scraped
+ * @param onlyWithId Skip movies without an id
+ */
+void MovieMultiScraper::setOnlyWithId(bool onlyWithId)
+{
+    m_onlyWithId = onlyWithId;
+}
+
+/**
+ * @brief Sets if each movie should be saved after it was scraped
+ * @param saveEach Save each movie
+ */
+void MovieMultiScraper::setSaveEach(bool saveEach)
+{
+    m_saveEach = saveEach;
+}
+
+/**
+ * @brief Starts scraping, the number of movies scraped at the same time is taken from the advanced settings
+ * @param movies Movies to scrape
+ */
+void MovieMultiScraper::start(QList<Movie*> movies)
+{
+    if (m_runner->isRunning() || !m_scraper)
+        return;
+
+    m_ids.clear();
+    m_searchScraperOf.clear();
+    QList<QObject*> items;
+    foreach (Movie *movie, movies)
+        items.append(movie);
+    m_runner->start(items);
+}
+
+/**
+ * @brief Aborts scraping, the downloads of the movies in progress are aborted
+ */
+void MovieMultiScraper::abort()
+{
+    if (!m_runner->isRunning())
+        return;
+
+    foreach (Movie *movie, activeMovies()) {
+        disconnect(movie->controller(), 0, this, 0);
+        movie->controller()->abortDownloads();
+    }
+    m_runner->abort();
+    disconnectScrapers();
+    m_ids.clear();
+    m_searchScraperOf.clear();
+}
+
+bool MovieMultiScraper::isRunning() const
+{
+    return m_runner->isRunning();
+}
+
+/**
+ * @brief Returns the movies which are currently searched, loaded or downloading their images
+ * @return List of movies
+ */
+QList<Movie*> MovieMultiScraper::activeMovies() const
+{
+    QList<Movie*> movies;
+    foreach (QObject *item, m_runner->activeItems())
+        movies.append(static_cast<Movie*>(item));
+    return movies;
+}
+
+/**
+ * @brief Returns the number of movies which were scraped or skipped
+ * @return Number of movies
+ */
+int MovieMultiScraper::moviesDone() const
+{
+    return m_runner->itemsDone();
+}
+
+/**
+ * @brief Returns the number of movies scraped per minute since scraping started
+ * @return Titles per minute
+ */
+double MovieMultiScraper::titlesPerMinute() const
+{
+    return m_runner->titlesPerMinute();
+}
+
+/**
+ * @brief Called when the runner starts a movie, movies with an id are loaded directly, all others are searched first
+ * @param item Movie
+ */
+void MovieMultiScraper::onStartItem(QObject *item)
+{
+    Movie *movie = static_cast<Movie*>(item);
+    if (m_onlyWithId && !hasId(movie)) {
+        m_runner->itemDone(movie, false);
+        return;
+    }
+
+    connect(movie->controller(), SIGNAL(sigLoadDone(Movie*)), this, SLOT(onLoadDone(Movie*)), Qt::UniqueConnection);
+    connect(movie->controller(), SIGNAL(sigDownloadProgress(Movie*,int,int)), this, SIGNAL(sigDownloadProgress(Movie*,int,int)), Qt::UniqueConnection);
+    QMap<ScraperInterface*, QString> ids;
+    QString id = directId(movie);
+    if (!id.isEmpty())
+        ids.insert(0, id);
+    m_ids.insert(movie, ids);
+    emit sigMovieStarted(movie);
+
+    if (id.isEmpty())
+        requestSearch(movie, m_scraper);
+    else
+        m_runner->requestLoad(movie, m_scraper->identifier());
+}
+
+/**
+ * @brief Queues a search of a movie with the given scraper
+ * @param movie Movie
+ * @param scraper Scraper to search with
+ */
+void MovieMultiScraper::requestSearch(Movie *movie, ScraperInterface *scraper)
+{
+    m_searchScraperOf.insert(movie, scraper);
+    m_runner->requestSearch(movie, scraper->identifier());
+}
+
+/**
+ * @brief Starts the search of a movie when the runner grants it
+ * @param item Movie
+ */
+void MovieMultiScraper::onStartSearch(QObject *item)
+{
+    Movie *movie = static_cast<Movie*>(item);
+    ScraperInterface *scraper = m_searchScraperOf.take(movie);
+    if (!scraper) {
+        m_runner->searchDone();
+        return;
+    }
+    if (!m_searchScrapers.contains(scraper)) {
+        connect(scraper, SIGNAL(searchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchDone(QList<ScraperSearchResult>)), Qt::UniqueConnection);
+        m_searchScrapers.append(scraper);
+    }
+    scraper->search(searchTerm(movie, scraper));
+}
+
+/**
+ * @brief Called when a scraper has finished searching
+ *        The custom movie scraper needs the ids of several scrapers, they are searched one after another.
+ * @param results Search results
+ */
+void MovieMultiScraper::onSearchDone(QList<ScraperSearchResult> results)
+{
+    Movie *movie = static_cast<Movie*>(m_runner->searchingItem());
+    if (!movie)
+        return;
+    m_runner->searchDone();
+
+    if (results.isEmpty()) {
+        disconnect(movie->controller(), 0, this, 0);
+        m_runner->itemDone(movie, false);
+        return;
+    }
+
+    if (m_scraper->identifier() == "custom-movie") {
+        ScraperInterface *scraper = static_cast<ScraperInterface*>(QObject::sender());
+        m_ids[movie].insert(scraper, results.first().id);
+        QList<ScraperInterface*> searchScrapers = CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, m_ids[movie]);
+        if (!searchScrapers.isEmpty()) {
+            requestSearch(movie, searchScrapers.first());
+            return;
+        }
+    } else {
+        m_ids[movie].insert(m_scraper, results.first().id);
+    }
+
+    m_runner->requestLoad(movie, m_scraper->identifier());
+}
+
+/**
+ * @brief Starts loading the infos and images of a movie when the runner grants it
+ * @param item Movie
+ */
+void MovieMultiScraper::onStartLoad(QObject *item)
+{
+    Movie *movie = static_cast<Movie*>(item);
+    movie->controller()->loadData(m_ids.value(movie), m_scraper, m_infosToLoad);
+}
+
+/**
+ * @brief Called when a movie has loaded its infos and images
+ * @param movie Movie
+ */
+void MovieMultiScraper::onLoadDone(Movie *movie)
+{
+    if (!m_runner->activeItems().contains(movie))
+        return;
+    disconnect(movie->controller(), 0, this, 0);
+    if (m_saveEach)
+        movie->controller()->saveData(Manager::instance()->mediaCenterInterface());
+    m_runner->itemDone(movie, true);
+}
+
+/**
+ * @brief Called when a movie was scraped or skipped
+ * @param item Movie
+ */
+void MovieMultiScraper::onItemDone(QObject *item)
+{
+    Movie *movie = static_cast<Movie*>(item);
+    m_ids.remove(movie);
+    m_searchScraperOf.remove(movie);
+    emit sigMovieDone(movie);
+}
+
+void MovieMultiScraper::onFinished()
+{
+    disconnectScrapers();
+    emit sigFinished();
+}
+
+void MovieMultiScraper::disconnectScrapers()
+{
+    foreach (ScraperInterface *scraper, m_searchScrapers)
+        disconnect(scraper, SIGNAL(searchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchDone(QList<ScraperSearchResult>)));
+    m_searchScrapers.clear();
+}
+
+/**
+ * @brief Checks if a movie has an id the scraper can load it with
+ * @param movie Movie
+ * @return True if the movie has an id
+ */
+bool MovieMultiScraper::hasId(Movie *movie) const
+{
+    if (m_scraper->identifier() == "imdb")
+        return !movie->id().isEmpty();
+    if (m_scraper->identifier() == "tmdb" || m_scraper->identifier() == "custom-movie")
+        return !movie->id().isEmpty() || !movie->tmdbId().isEmpty();
+    return true;
+}
+
+/**
+ * @brief Returns the id a movie can be loaded with without searching it first
+ * @param movie Movie
+ * @return Id, empty if the movie has to be searched
+ */
+QString MovieMultiScraper::directId(Movie *movie) const
+{
+    if (m_scraper->identifier() == "imdb" && !movie->id().isEmpty())
+        return movie->id();
+    if (m_scraper->identifier() == "tmdb" && !movie->tmdbId().isEmpty())
+        return movie->tmdbId();
+    if (m_scraper->identifier() == "tmdb" && !movie->id().isEmpty())
+        return movie->id();
+    return QString();
+}
+
+/**
+ * @brief Returns the search term for a movie, ids are used if the scraper supports them
+ * @param movie Movie
+ * @param scraper Scraper which searches
+ * @return Search term
+ */
+QString MovieMultiScraper::searchTerm(Movie *movie, ScraperInterface *scraper) const
+{
+    if (scraper == m_scraper) {
+        if (scraper->identifier() != "custom-movie")
+            return movie->name();
+        ScraperInterface *titleScraper = CustomMovieScraper::instance()->titleScraper();
+        if ((titleScraper->identifier() == "imdb" || titleScraper->identifier() == "tmdb") && !movie->id().isEmpty())
+            return movie->id();
+        if (titleScraper->identifier() == "tmdb" && !movie->tmdbId().isEmpty())
+            return "id" + movie->tmdbId();
+        return movie->name();
+    }
+
+    if ((scraper->identifier() == "tmdb" || scraper->identifier() == "imdb") && !movie->id().isEmpty())
+        return movie->id();
+    if (scraper->identifier() == "tmdb" && !movie->tmdbId().isEmpty() && !movie->tmdbId().startsWith("tt"))
+        return "id" + movie->tmdbId();
+    if (scraper->identifier() == "tmdb" && !movie->tmdbId().isEmpty())
+        return movie->tmdbId();
+    return movie->name();
+}
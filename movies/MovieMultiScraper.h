@@ -0,0 +1,64 @@
+#ifndef MOVIEMULTISCRAPER_H
+#define MOVIEMULTISCRAPER_H
+
+#include <QHash>
+#include <QObject>
+#include "data/ScraperInterface.h"
+#include "globals/MultiScrapeRunner.h"
+#include "movies/Movie.h"
+
+/**
+ * @brief The MovieMultiScraper class
+ * Scrapes a list of movies with the MultiScrapeRunner: several movies are searched, loaded and
+ * download their images at the same time. This class only does the movie specific parts,
+ * like choosing the scrapers to search with and loading the movies with the found ids.
+ */
+class MovieMultiScraper : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MovieMultiScraper(QObject *parent = 0);
+    void setScraper(ScraperInterface *scraper);
+    void setInfosToLoad(QList<int> infos);
+    void setOnlyWithId(bool onlyWithId);
+    void setSaveEach(bool saveEach);
+    void start(QList<Movie*> movies);
+    void abort();
+    bool isRunning() const;
+    QList<Movie*> activeMovies() const;
+    int moviesDone() const;
+    double titlesPerMinute() const;
+
+signals:
+    void sigMovieStarted(Movie*);
+    void sigMovieDone(Movie*);
+    void sigDownloadProgress(Movie*, int, int);
+    void sigFinished();
+
+private slots:
+    void onStartItem(QObject *item);
+    void onStartSearch(QObject *item);
+    void onStartLoad(QObject *item);
+    void onItemDone(QObject *item);
+    void onFinished();
+    void onSearchDone(QList<ScraperSearchResult> results);
+    void onLoadDone(Movie *movie);
+
+private:
+    ScraperInterface *m_scraper;
+    QList<int> m_infosToLoad;
+    bool m_onlyWithId;
+    bool m_saveEach;
+    MultiScrapeRunner *m_runner;
+    QHash<Movie*, QMap<ScraperInterface*, QString> > m_ids;
+    QHash<Movie*, ScraperInterface*> m_searchScraperOf;
+    QList<ScraperInterface*> m_searchScrapers;
+
+    bool hasId(Movie *movie) const;
+    QString directId(Movie *movie) const;
+    QString searchTerm(Movie *movie, ScraperInterface *scraper) const;
+    void requestSearch(Movie *movie, ScraperInterface *scraper);
+    void disconnectScrapers();
+};
+
+#endif // MOVIEMULTISCRAPER_H
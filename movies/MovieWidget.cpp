@@ -409,7 +409,9 @@ void MovieWidget::setDisabledTrue()
 void MovieWidget::setMovie(Movie *movie)
 {
     qDebug() << "Entered, movie=" << movie->name();
+    // Movies restored from the database cache only hold the list infos, the full nfo is parsed here
     movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
+    Manager::instance()->movieModel()->touchDetails(movie);
     if (!movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
         movie->controller()->loadStreamDetailsFromFile();
         if (movie->streamDetailsLoaded() && movie->streamDetails()->videoDetails().value("durationinseconds").toInt() != 0)
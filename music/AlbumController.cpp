@@ -85,6 +85,7 @@ void AlbumController::loadImage(int type, QUrl url)
     d.album = m_album;
     d.imageType = type;
     d.url = url;
+    d.priority = true;
     emit sigLoadingImages(m_album, QList<int>() << type);
     m_downloadManager->addDownload(d);
 }
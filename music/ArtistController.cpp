@@ -86,6 +86,7 @@ void ArtistController::loadImage(int type, QUrl url)
     d.artist = m_artist;
     d.imageType = type;
     d.url = url;
+    d.priority = true;
     emit sigLoadingImages(m_artist, QList<int>() << type);
     m_downloadManager->addDownload(d);
 }
@@ -1,6 +1,7 @@
 #include "MusicFileSearcher.h"
 
 #include <QtConcurrent>
+#include <QApplication>
 #include <QDebug>
 #include <QDirIterator>
 #include <QFileInfo>
@@ -9,6 +10,7 @@
 MusicFileSearcher::MusicFileSearcher(QObject *parent) : QObject(parent)
 {
     m_progressMessageId = Constants::MusicFileSearcherProgressMessageId;
+    m_batchSize = 50;
 }
 
 MusicFileSearcher::~MusicFileSearcher()
@@ -98,6 +100,25 @@ void MusicFileSearcher::reload(bool force)
     int current = 0;
     int max = artists.length() + albums.length() + artistsFromDb.length() + albumsFromDb.length();
 
+    // Artists from the database are loaded first, artists are added to the model together with their albums in batches
+    QList<Artist*> loadedArtists;
+    for (int i=0, n=artistsFromDb.count() ; i<n ; i += m_batchSize) {
+        if (m_aborted)
+            return;
+        QList<Artist*> batch = artistsFromDb.mid(i, m_batchSize);
+        QList<Album*> batchAlbums;
+        foreach (Artist *artist, batch)
+            batchAlbums.append(artist->albums());
+        QtConcurrent::blockingMapped(batch, MusicFileSearcher::loadArtistData);
+        QtConcurrent::blockingMapped(batchAlbums, MusicFileSearcher::loadAlbumData);
+        current += batch.count() + batchAlbums.count();
+        emit currentDir(batch.last()->name());
+        emit progress(current, max, m_progressMessageId);
+        loadedArtists.append(batch);
+        addArtistsToModel(loadedArtists, false);
+    }
+    addArtistsToModel(loadedArtists, true);
+
     Manager::instance()->database()->transaction();
     foreach (Artist *artist, artists) {
         if (m_aborted) {
@@ -109,44 +130,43 @@ void MusicFileSearcher::reload(bool force)
             emit currentDir(artist->name());
         emit progress(++current, max, m_progressMessageId);
         Manager::instance()->database()->add(artist, artistPaths.value(artist));
-    }
-    foreach (Album *album, albums) {
-        if (m_aborted) {
-            Manager::instance()->database()->commit();
-            return;
-        }
-        album->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
-        if (current%20 == 0)
-            emit currentDir(album->artist() + "/" + album->title());
-        emit progress(++current, max, m_progressMessageId);
-        Manager::instance()->database()->add(album, albumPaths.value(album));
-    }
-    Manager::instance()->database()->commit();
-
-    QtConcurrent::blockingMapped(artistsFromDb, MusicFileSearcher::loadArtistData);
-    QtConcurrent::blockingMapped(albumsFromDb, MusicFileSearcher::loadAlbumData);
-
-    artists.append(artistsFromDb);
-    albums.append(albumsFromDb);
 
-    QMap<Artist*, MusicModelItem*> artistModelItems;
-    foreach (Artist *artist, artists) {
-        MusicModelItem *artistItem = Manager::instance()->musicModel()->appendChild(artist);
-        artistModelItems.insert(artist, artistItem);
-    }
-    foreach (Album *album, albums) {
-        MusicModelItem *artistItem = artistModelItems.value(album->artistObj(), 0);
-        if (artistItem == 0) {
-            qWarning() << "Artist item was not found for album" << album->path();
-            continue;
+        foreach (Album *album, artist->albums()) {
+            if (m_aborted) {
+                Manager::instance()->database()->commit();
+                return;
+            }
+            album->controller()->loadData(Manager::instance()->mediaCenterInterface(), true);
+            if (current%20 == 0)
+                emit currentDir(album->artist() + "/" + album->title());
+            emit progress(++current, max, m_progressMessageId);
+            Manager::instance()->database()->add(album, albumPaths.value(album));
         }
-        artistItem->appendChild(album);
+
+        loadedArtists.append(artist);
+        addArtistsToModel(loadedArtists, false);
     }
+    Manager::instance()->database()->commit();
+    addArtistsToModel(loadedArtists, true);
 
     if (!m_aborted)
         emit musicLoaded(m_progressMessageId);
 }
 
+/**
+ * @brief Adds loaded artists and their albums to the model once a batch is complete
+ * @param artists Loaded artists which are not in the model yet, cleared after adding
+ * @param flush Add the artists even if the batch is not complete
+ */
+void MusicFileSearcher::addArtistsToModel(QList<Artist*> &artists, bool flush)
+{
+    if (artists.isEmpty() || (!flush && artists.count() < m_batchSize))
+        return;
+    Manager::instance()->musicModel()->appendChildren(artists);
+    artists.clear();
+    qApp->processEvents();
+}
+
 void MusicFileSearcher::abort()
 {
     m_aborted = true;
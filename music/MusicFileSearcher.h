@@ -30,7 +30,10 @@ signals:
 private:
     QList<SettingsDir> m_directories;
     int m_progressMessageId;
+    int m_batchSize;
     bool m_aborted;
+
+    void addArtistsToModel(QList<Artist*> &artists, bool flush);
 };
 
 #endif // MUSICFILESEARCHER_H
@@ -100,11 +100,39 @@ MusicModelItem *MusicModel::appendChild(Artist *artist)
     beginInsertRows(QModelIndex(), parentItem->childCount(), parentItem->childCount());
     MusicModelItem *item = parentItem->appendChild(artist);
     endInsertRows();
+    connectArtistItem(item, artist);
+    return item;
+}
+
+/**
+ * @brief Adds several artists together with their albums to the model with a single row insertion
+ * @param artists Artists to add
+ */
+void MusicModel::appendChildren(QList<Artist*> artists)
+{
+    if (artists.isEmpty())
+        return;
+
+    QList<MusicModelItem*> items;
+    beginInsertRows(QModelIndex(), m_rootItem->childCount(), m_rootItem->childCount()+artists.count()-1);
+    foreach (Artist *artist, artists) {
+        MusicModelItem *item = m_rootItem->appendChild(artist);
+        foreach (Album *album, artist->albums())
+            item->appendChild(album);
+        items.append(item);
+    }
+    endInsertRows();
+
+    for (int i=0, n=artists.count() ; i<n ; ++i)
+        connectArtistItem(items.at(i), artists.at(i));
+}
+
+void MusicModel::connectArtistItem(MusicModelItem *item, Artist *artist)
+{
     connect(item, &MusicModelItem::sigChanged, this, &MusicModel::onSigChanged);
     connect(artist, &Artist::sigChanged, this, &MusicModel::onArtistChanged);
     connect(artist->controller(), &ArtistController::sigSaved, this, &MusicModel::onArtistChanged);
     connect(item, &MusicModelItem::sigIntChanged, this, &MusicModel::onSigChanged);
-    return item;
 }
 
 QModelIndex MusicModel::parent(const QModelIndex &index) const
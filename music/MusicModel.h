@@ -19,6 +19,7 @@ public:
     int columnCount(const QModelIndex &parent = QModelIndex()) const;
     bool removeRows(int position, int rows, const QModelIndex &parent = QModelIndex());
     MusicModelItem *appendChild(Artist *artist);
+    void appendChildren(QList<Artist*> artists);
     void clear();
     MusicModelItem *getItem(const QModelIndex &index) const;
     QList<Artist*> artists();
@@ -30,6 +31,7 @@ private slots:
     void onArtistChanged(Artist *artist);
 
 private:
+    void connectArtistItem(MusicModelItem *item, Artist *artist);
     MusicModelItem *m_rootItem;
     QIcon m_newIcon;
 };
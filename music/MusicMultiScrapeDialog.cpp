@@ -19,8 +19,6 @@ MusicMultiScrapeDialog::MusicMultiScrapeDialog(QWidget *parent) :
     ui->itemCounter->setFont(font);
 
     m_executed = false;
-    m_currentArtist = 0;
-    m_currentAlbum = 0;
 
     ui->chkName->setMyData(MusicScraperInfos::Name);
     ui->chkBorn->setMyData(MusicScraperInfos::Born);
@@ -53,6 +51,12 @@ MusicMultiScrapeDialog::MusicMultiScrapeDialog(QWidget *parent) :
     }
     connect(ui->chkUnCheckAll, SIGNAL(clicked(bool)), this, SLOT(onChkAllToggled(bool)));
     connect(ui->btnStartScraping, SIGNAL(clicked()), this, SLOT(onStartScraping()));
+
+    m_runner = new MultiScrapeRunner(this);
+    connect(m_runner, SIGNAL(sigStartItem(QObject*)), this, SLOT(onStartItem(QObject*)));
+    connect(m_runner, SIGNAL(sigStartSearch(QObject*)), this, SLOT(onStartSearch(QObject*)));
+    connect(m_runner, SIGNAL(sigStartLoad(QObject*)), this, SLOT(onStartLoad(QObject*)));
+    connect(m_runner, SIGNAL(sigFinished()), this, SLOT(onScrapingFinished()));
 }
 
 MusicMultiScrapeDialog::~MusicMultiScrapeDialog()
@@ -103,7 +107,9 @@ bool MusicMultiScrapeDialog::isExecuted()
 
 int MusicMultiScrapeDialog::exec()
 {
-    m_queue.clear();
+    m_items.clear();
+    m_ids.clear();
+    m_downloads.clear();
     ui->itemCounter->setVisible(false);
     ui->btnCancel->setVisible(true);
     ui->btnClose->setVisible(false);
@@ -115,8 +121,6 @@ int MusicMultiScrapeDialog::exec()
     ui->progressItem->setValue(0);
     ui->groupBox->setEnabled(true);
     ui->itemName->clear();
-    m_currentArtist = 0;
-    m_currentAlbum = 0;
     m_executed = true;
     onChkToggled();
     adjustSize();
@@ -135,11 +139,16 @@ void MusicMultiScrapeDialog::reject()
 {
     disconnectScrapers();
     m_executed = false;
-    if (m_currentAlbum)
-        m_currentAlbum->controller()->abortDownloads();
-    if (m_currentArtist)
-        m_currentArtist->controller()->abortDownloads();
-    m_queue.clear();
+    foreach (QObject *item, m_runner->activeItems()) {
+        if (Album *album = qobject_cast<Album*>(item)) {
+            disconnect(album->controller(), 0, this, 0);
+            album->controller()->abortDownloads();
+        } else if (Artist *artist = qobject_cast<Artist*>(item)) {
+            disconnect(artist->controller(), 0, this, 0);
+            artist->controller()->abortDownloads();
+        }
+    }
+    m_runner->abort();
     QDialog::reject();
 }
 
@@ -163,16 +172,10 @@ void MusicMultiScrapeDialog::onStartScraping()
 
     QList<Album*> queueAlbums;
     foreach (Artist *artist, m_artists) {
-        QueueItem item1;
-        item1.album = 0;
-        item1.artist = artist;
-        m_queue.append(item1);
+        m_items.append(artist);
         if (ui->chkScrapeAllAlbums->isChecked()) {
             foreach (Album *album, artist->albums()) {
-                QueueItem item2;
-                item2.album = album;
-                item2.artist = 0;
-                m_queue.append(item2);
+                m_items.append(album);
                 queueAlbums.append(album);
             }
         }
@@ -180,18 +183,15 @@ void MusicMultiScrapeDialog::onStartScraping()
 
     foreach (Album *album, m_albums) {
         if (!queueAlbums.contains(album)) {
-            QueueItem item;
-            item.album = album;
-            item.artist = 0;
-            m_queue.append(item);
+            m_items.append(album);
             queueAlbums.append(album);
         }
     }
 
-    ui->itemCounter->setText(QString("0/%1").arg(m_queue.count()));
+    ui->itemCounter->setText(QString("0/%1").arg(m_items.count()));
     ui->itemCounter->setVisible(true);
-    ui->progressAll->setMaximum(m_queue.count());
-    scrapeNext();
+    ui->progressAll->setMaximum(m_items.count());
+    m_runner->start(m_items);
 }
 
 void MusicMultiScrapeDialog::onScrapingFinished()
@@ -205,85 +205,161 @@ void MusicMultiScrapeDialog::onScrapingFinished()
     ui->btnStartScraping->setVisible(false);
 }
 
-void MusicMultiScrapeDialog::scrapeNext()
+/**
+ * @brief Called when an item gets a slot in the runner, requests its search or load
+ * @param item Artist or album
+ */
+void MusicMultiScrapeDialog::onStartItem(QObject *item)
 {
     if (!isExecuted())
         return;
 
-    if (m_currentAlbum && ui->chkAutoSave->isChecked())
-        m_currentAlbum->controller()->saveData(Manager::instance()->mediaCenterInterface());
-
-    if (m_currentArtist && ui->chkAutoSave->isChecked())
-        m_currentArtist->controller()->saveData(Manager::instance()->mediaCenterInterface());
-
-    if (m_queue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
-
-    QueueItem item = m_queue.dequeue();
-    m_currentAlbum = item.album;
-    m_currentArtist = item.artist;
-    if (m_currentAlbum) {
-        ui->itemName->setText(m_currentAlbum->title());
-    } else if (m_currentArtist) {
-        ui->itemName->setText(m_currentArtist->name());
-    }
-    ui->itemCounter->setText(QString("%1/%2").arg(ui->progressAll->maximum()-m_queue.count()).arg(ui->progressAll->maximum()));
-    ui->progressAll->setValue(ui->progressAll->maximum()-m_queue.size()-1);
-    ui->progressItem->setValue(0);
-
-    if (m_currentAlbum) {
-        connect(m_currentAlbum->controller(), SIGNAL(sigLoadDone(Album*)), this, SLOT(scrapeNext()), Qt::UniqueConnection);
-        connect(m_currentAlbum->controller(), SIGNAL(sigDownloadProgress(Album*,int,int)), this, SLOT(onProgress(Album*,int,int)), Qt::UniqueConnection);
-        if (!m_currentAlbum->mbAlbumId().isEmpty()) {
-            m_currentAlbum->controller()->loadData(m_currentAlbum->mbAlbumId(), m_currentAlbum->mbReleaseGroupId(), m_scraperInterface, m_albumInfosToLoad);
+    if (Album *album = qobject_cast<Album*>(item)) {
+        connect(album->controller(), SIGNAL(sigLoadDone(Album*)), this, SLOT(onLoadDone(Album*)), Qt::UniqueConnection);
+        connect(album->controller(), SIGNAL(sigDownloadProgress(Album*,int,int)), this, SLOT(onProgress(Album*,int,int)), Qt::UniqueConnection);
+        if (!album->mbAlbumId().isEmpty()) {
+            m_ids.insert(album, qMakePair(album->mbAlbumId(), album->mbReleaseGroupId()));
+            m_runner->requestLoad(album, m_scraperInterface->identifier());
         } else {
-            m_scraperInterface->searchAlbum((m_currentAlbum->artist().isEmpty() && m_currentAlbum->artistObj()) ? m_currentAlbum->artistObj()->name() : m_currentAlbum->artist(),
-                                            m_currentAlbum->title());
+            m_runner->requestSearch(album, m_scraperInterface->identifier());
         }
-    } else if (m_currentArtist) {
-        connect(m_currentArtist->controller(), SIGNAL(sigLoadDone(Artist*)), this, SLOT(scrapeNext()), Qt::UniqueConnection);
-        connect(m_currentArtist->controller(), SIGNAL(sigDownloadProgress(Artist*,int,int)), this, SLOT(onProgress(Artist*,int,int)), Qt::UniqueConnection);
-        if (!m_currentArtist->mbId().isEmpty()) {
-            m_currentArtist->controller()->loadData(m_currentArtist->mbId(), m_scraperInterface, m_artistInfosToLoad);
+    } else if (Artist *artist = qobject_cast<Artist*>(item)) {
+        connect(artist->controller(), SIGNAL(sigLoadDone(Artist*)), this, SLOT(onLoadDone(Artist*)), Qt::UniqueConnection);
+        connect(artist->controller(), SIGNAL(sigDownloadProgress(Artist*,int,int)), this, SLOT(onProgress(Artist*,int,int)), Qt::UniqueConnection);
+        if (!artist->mbId().isEmpty()) {
+            m_ids.insert(artist, qMakePair(artist->mbId(), QString()));
+            m_runner->requestLoad(artist, m_scraperInterface->identifier());
         } else {
-            m_scraperInterface->searchArtist(m_currentArtist->name());
+            m_runner->requestSearch(artist, m_scraperInterface->identifier());
         }
     }
+    m_downloads.insert(item, qMakePair(0, 0));
+    updateStatus();
+}
+
+void MusicMultiScrapeDialog::onStartSearch(QObject *item)
+{
+    if (!isExecuted())
+        return;
+
+    if (Album *album = qobject_cast<Album*>(item)) {
+        m_scraperInterface->searchAlbum((album->artist().isEmpty() && album->artistObj()) ? album->artistObj()->name() : album->artist(),
+                                        album->title());
+    } else if (Artist *artist = qobject_cast<Artist*>(item)) {
+        m_scraperInterface->searchArtist(artist->name());
+    }
 }
 
 void MusicMultiScrapeDialog::onSearchFinished(QList<ScraperSearchResult> results)
 {
     if (!isExecuted())
         return;
+
+    QObject *item = m_runner->searchingItem();
+    if (!item)
+        return;
+    m_runner->searchDone();
+
     if (results.isEmpty()) {
-        scrapeNext();
+        finishItem(item, false);
         return;
     }
 
-    if (m_currentArtist)
-        m_currentArtist->controller()->loadData(results.first().id, m_scraperInterface, m_artistInfosToLoad);
-    else if (m_currentAlbum)
-        m_currentAlbum->controller()->loadData(results.first().id, results.first().id2, m_scraperInterface, m_albumInfosToLoad);
+    m_ids.insert(item, qMakePair(results.first().id, results.first().id2));
+    m_runner->requestLoad(item, m_scraperInterface->identifier());
 }
 
-void MusicMultiScrapeDialog::onProgress(Artist *artist, int current, int maximum)
+void MusicMultiScrapeDialog::onStartLoad(QObject *item)
 {
-    Q_UNUSED(artist);
     if (!isExecuted())
         return;
-    ui->progressItem->setValue(maximum-current);
-    ui->progressItem->setMaximum(maximum);
+
+    QPair<QString, QString> ids = m_ids.value(item);
+    if (Album *album = qobject_cast<Album*>(item))
+        album->controller()->loadData(ids.first, ids.second, m_scraperInterface, m_albumInfosToLoad);
+    else if (Artist *artist = qobject_cast<Artist*>(item))
+        artist->controller()->loadData(ids.first, m_scraperInterface, m_artistInfosToLoad);
+}
+
+void MusicMultiScrapeDialog::onLoadDone(Artist *artist)
+{
+    finishItem(artist);
+}
+
+void MusicMultiScrapeDialog::onLoadDone(Album *album)
+{
+    finishItem(album);
+}
+
+/**
+ * @brief Saves an item if requested and frees its slot in the runner
+ * @param item Artist or album
+ * @param scraped False if the item was not found
+ */
+void MusicMultiScrapeDialog::finishItem(QObject *item, bool scraped)
+{
+    if (!isExecuted() || !m_runner->activeItems().contains(item))
+        return;
+
+    if (Album *album = qobject_cast<Album*>(item)) {
+        disconnect(album->controller(), 0, this, 0);
+        if (scraped && ui->chkAutoSave->isChecked())
+            album->controller()->saveData(Manager::instance()->mediaCenterInterface());
+    } else if (Artist *artist = qobject_cast<Artist*>(item)) {
+        disconnect(artist->controller(), 0, this, 0);
+        if (scraped && ui->chkAutoSave->isChecked())
+            artist->controller()->saveData(Manager::instance()->mediaCenterInterface());
+    }
+    m_ids.remove(item);
+    m_downloads.remove(item);
+    m_runner->itemDone(item, scraped);
+    updateStatus();
+}
+
+void MusicMultiScrapeDialog::onProgress(Artist *artist, int current, int maximum)
+{
+    if (!isExecuted() || !m_downloads.contains(artist))
+        return;
+    m_downloads.insert(artist, qMakePair(maximum-current, maximum));
+    updateStatus();
 }
 
 void MusicMultiScrapeDialog::onProgress(Album *album, int current, int maximum)
 {
-    Q_UNUSED(album);
-    if (!isExecuted())
+    if (!isExecuted() || !m_downloads.contains(album))
         return;
-    ui->progressItem->setValue(maximum-current);
-    ui->progressItem->setMaximum(maximum);
+    m_downloads.insert(album, qMakePair(maximum-current, maximum));
+    updateStatus();
+}
+
+/**
+ * @brief Shows the items in progress, their summed up downloads and the throughput
+ */
+void MusicMultiScrapeDialog::updateStatus()
+{
+    QStringList names;
+    foreach (QObject *item, m_runner->activeItems()) {
+        if (Album *album = qobject_cast<Album*>(item))
+            names << album->title();
+        else if (Artist *artist = qobject_cast<Artist*>(item))
+            names << artist->name();
+    }
+    ui->itemName->setText(names.join(", "));
+
+    int done = m_runner->itemsDone();
+    ui->itemCounter->setText(tr("%1/%2 - %3 titles per minute").arg(done).arg(m_items.count()).arg(m_runner->titlesPerMinute(), 0, 'f', 1));
+    ui->progressAll->setValue(done);
+
+    int downloaded = 0;
+    int downloads = 0;
+    QHashIterator<QObject*, QPair<int, int> > it(m_downloads);
+    while (it.hasNext()) {
+        it.next();
+        downloaded += it.value().first;
+        downloads += it.value().second;
+    }
+    ui->progressItem->setMaximum(qMax(1, downloads));
+    ui->progressItem->setValue(downloaded);
 }
 
 void MusicMultiScrapeDialog::setItems(QList<Artist *> artists, QList<Album *> albums)
@@ -2,8 +2,11 @@
 #define MUSICMULTISCRAPEDIALOG_H
 
 #include <QDialog>
+#include <QHash>
+#include <QPair>
 #include "Artist.h"
 #include "Album.h"
+#include "../globals/MultiScrapeRunner.h"
 
 namespace Ui {
 class MusicMultiScrapeDialog;
@@ -30,25 +33,27 @@ private slots:
     void onStartScraping();
     void onScrapingFinished();
     void onSearchFinished(QList<ScraperSearchResult> results);
-    void scrapeNext();
+    void onStartItem(QObject *item);
+    void onStartSearch(QObject *item);
+    void onStartLoad(QObject *item);
+    void onLoadDone(Artist *artist);
+    void onLoadDone(Album *album);
     void onProgress(Artist *artist, int current, int maximum);
     void onProgress(Album *album, int current, int maximum);
 
 private:
     Ui::MusicMultiScrapeDialog *ui;
 
-    struct QueueItem {
-        Artist *artist;
-        Album *album;
-    };
-
     void disconnectScrapers();
     bool isExecuted();
+    void finishItem(QObject *item, bool scraped = true);
+    void updateStatus();
 
-    QQueue<QueueItem> m_queue;
+    MultiScrapeRunner *m_runner;
+    QList<QObject*> m_items;
+    QHash<QObject*, QPair<QString, QString> > m_ids;
+    QHash<QObject*, QPair<int, int> > m_downloads;
     bool m_executed;
-    Artist *m_currentArtist;
-    Album *m_currentAlbum;
     QList<int> m_artistInfosToLoad;
     QList<int> m_albumInfosToLoad;
     QList<Artist*> m_artists;
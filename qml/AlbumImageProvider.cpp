@@ -1,5 +1,6 @@
 #include "AlbumImageProvider.h"
 
+#include "globals/Helper.h"
 #include "globals/Manager.h"
 #include <QDebug>
 
@@ -27,13 +28,8 @@ QImage AlbumImageProvider::requestImage(const QString &id, QSize *size, const QS
         Album *album = artist->albums().at(albumNum);
 
         int row = album->bookletModel()->rowById(imageId);
-        QImage img = QImage::fromData(album->bookletModel()->data(album->bookletModel()->index(row, 0), Qt::UserRole+4).toByteArray());
-
-        if (size)
-            *size = QSize(img.width(), img.height());
-        if (requestedSize.width() > 0 || requestedSize.height() > 0)
-            return img.scaled(requestedSize.width(), requestedSize.height(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        return img;
+        QByteArray data = album->bookletModel()->data(album->bookletModel()->index(row, 0), Qt::UserRole+4).toByteArray();
+        return Helper::instance()->getImage(data, qMax(0, requestedSize.width()), qMax(0, requestedSize.height()), size);
     }
 
     return QImage();
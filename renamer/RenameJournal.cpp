@@ -0,0 +1,94 @@
+#include "RenameJournal.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+/**
+ * @brief RenameJournal::RenameJournal
+ */
+RenameJournal::RenameJournal()
+{
+}
+
+/**
+ * @brief Forgets all recorded operations, called when an item has been renamed successfully
+ */
+void RenameJournal::clear()
+{
+    m_entries.clear();
+}
+
+/**
+ * @brief Checks if operations have been recorded
+ * @return True if there is nothing to revert
+ */
+bool RenameJournal::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+/**
+ * @brief Records a renamed or moved file or directory
+ * @param oldName Previous path
+ * @param newName Current path
+ */
+void RenameJournal::addRename(const QString &oldName, const QString &newName)
+{
+    Entry entry;
+    entry.createDir = false;
+    entry.oldName = oldName;
+    entry.newName = newName;
+    m_entries.append(entry);
+}
+
+/**
+ * @brief Records a created directory
+ * @param dir Path of the directory
+ */
+void RenameJournal::addCreateDir(const QString &dir)
+{
+    Entry entry;
+    entry.createDir = true;
+    entry.newName = dir;
+    m_entries.append(entry);
+}
+
+/**
+ * @brief Reverts all recorded operations in reverse order and clears the journal.
+ *        Created directories are only removed if they are empty.
+ * @return True if all operations have been reverted
+ */
+bool RenameJournal::rollback()
+{
+    bool success = true;
+    for (int i=m_entries.count()-1 ; i>=0 ; --i) {
+        const Entry &entry = m_entries.at(i);
+        if (entry.createDir) {
+            if (!QDir().rmdir(entry.newName))
+                success = false;
+        } else if (!move(entry.newName, entry.oldName)) {
+            success = false;
+        }
+    }
+    m_entries.clear();
+    return success;
+}
+
+/**
+ * @brief Moves a file or directory back, names which only differ in case are renamed in two steps
+ * @param oldName Current path
+ * @param newName Path to restore
+ * @return True on success
+ */
+bool RenameJournal::move(const QString &oldName, const QString &newName)
+{
+    QDir dir;
+    if (QString::compare(oldName, newName, Qt::CaseInsensitive) == 0) {
+        if (!dir.rename(oldName, oldName + ".tmp"))
+            return false;
+        return dir.rename(oldName + ".tmp", newName);
+    }
+    if (QFileInfo(newName).exists())
+        return false;
+    return dir.rename(oldName, newName);
+}
@@ -0,0 +1,33 @@
+#ifndef RENAMEJOURNAL_H
+#define RENAMEJOURNAL_H
+
+#include <QList>
+#include <QString>
+
+/**
+ * @brief The RenameJournal class
+ * Records the file operations done by the renamer for a single item (movie, episode, concert),
+ * so they can be reverted if a later operation of the same item fails or the renamer is cancelled.
+ */
+class RenameJournal
+{
+public:
+    RenameJournal();
+    void clear();
+    bool isEmpty() const;
+    void addRename(const QString &oldName, const QString &newName);
+    void addCreateDir(const QString &dir);
+    bool rollback();
+
+private:
+    struct Entry {
+        bool createDir;
+        QString oldName;
+        QString newName;
+    };
+    QList<Entry> m_entries;
+
+    bool move(const QString &oldName, const QString &newName);
+};
+
+#endif // RENAMEJOURNAL_H
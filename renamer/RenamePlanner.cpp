@@ -0,0 +1,539 @@
+#include "RenamePlanner.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include "globals/Helper.h"
+#include "renamer/Renamer.h"
+
+/**
+ * @brief RenamePlanner::RenamePlanner
+ * @param patterns Patterns and options of the renamer
+ */
+RenamePlanner::RenamePlanner(const Patterns &patterns) :
+    m_patterns(patterns)
+{
+}
+
+/**
+ * @brief Computes the operations of all items.
+ *        Items which are already named correctly are part of the plan, but have no steps.
+ * @param items Snapshots of the items
+ * @return Planned operations and conflicts
+ */
+RenamePlanner::Plan RenamePlanner::plan(const QList<Item> &items)
+{
+    m_plan = Plan();
+    m_plannedSources.clear();
+    m_plannedTargets.clear();
+
+    bool canRenameFiles = !m_patterns.renameFiles || !m_patterns.filePattern.isEmpty();
+    bool canRenameDirectories = !m_patterns.renameDirectories || !m_patterns.directoryPattern.isEmpty();
+
+    foreach (const Item &item, items) {
+        if (item.type != ItemShow && (item.files.isEmpty() || (item.files.count() > 1 && m_patterns.filePatternMulti.isEmpty())))
+            continue;
+
+        switch (item.type) {
+        case ItemMovie:
+            if (canRenameFiles && canRenameDirectories)
+                planMovie(item);
+            break;
+        case ItemConcert:
+            if (canRenameFiles && canRenameDirectories)
+                planConcert(item);
+            break;
+        case ItemEpisode:
+            if (canRenameFiles)
+                planEpisode(item);
+            break;
+        case ItemShow:
+            if (m_patterns.renameDirectories && !m_patterns.directoryPattern.isEmpty())
+                planShow(item);
+            break;
+        case ItemSeasonDir:
+            break;
+        }
+    }
+
+    return m_plan;
+}
+
+/**
+ * @brief Plans the renaming of the files, trailers, subtitles, nfo and images of a movie and its directory.
+ *        Movies which are not in a separate folder are moved to a new one.
+ * @param item Snapshot of the movie
+ */
+void RenamePlanner::planMovie(const Item &item)
+{
+    QFileInfo fi(item.files.first());
+    QString fiCanonicalPath = fi.canonicalPath();
+    QDir dir(fiCanonicalPath);
+    QDir chkDir(fiCanonicalPath);
+    chkDir.cdUp();
+
+    bool isBluRay = Helper::instance()->isBluRay(chkDir.path());
+    bool isDvd = Helper::instance()->isDvd(chkDir.path());
+
+    QString parentDirName;
+    if (isBluRay || isDvd) {
+        parentDirName = dir.dirName();
+        dir.cdUp();
+    }
+    QDir parentDir(dir.path());
+    parentDir.cdUp();
+
+    ItemPlan plan = itemPlan(item, parentDir.path(), 0);
+    QStringList filmFiles;
+    QStringList newMovieFiles;
+    foreach (const QString &file, item.files)
+        newMovieFiles << QFileInfo(file).fileName();
+
+    if (!isBluRay && !isDvd && m_patterns.renameFiles) {
+        newMovieFiles.clear();
+        QString newFileName;
+        int partNo = 0;
+        foreach (const QString &file, item.files) {
+            QFileInfo fi(file);
+            newFileName = (item.files.count() == 1) ? m_patterns.filePattern : m_patterns.filePatternMulti;
+            Renamer::replace(newFileName, "extension", fi.suffix());
+            Renamer::replace(newFileName, "partNo", QString::number(++partNo));
+            newFileName = fill(newFileName, item);
+            newMovieFiles << newFileName;
+            filmFiles << newFileName;
+            if (fi.fileName() == newFileName)
+                continue;
+
+            addRename(plan, file, fi.canonicalPath() + "/" + newFileName, fi.fileName(), newFileName, OperationRename);
+
+            QDir currentDir = fi.dir();
+            foreach (const QString &trailerFile, currentDir.entryList(QStringList() << fi.completeBaseName() + "-trailer.*", QDir::Files | QDir::NoDotAndDotDot)) {
+                QFileInfo trailer(fi.canonicalPath() + "/" + trailerFile);
+                QString newTrailerFileName = newFileName.left(newFileName.lastIndexOf(".")) + "-trailer." + trailer.suffix();
+                if (trailer.fileName() != newTrailerFileName)
+                    addRename(plan, trailer.filePath(), fi.canonicalPath() + "/" + newTrailerFileName, trailer.fileName(), newTrailerFileName, OperationRename);
+                filmFiles << newTrailerFileName;
+            }
+
+            // Subtitles belong to the movie, not to a part, they are named after the first one
+            if (partNo > 1)
+                continue;
+            for (int i=0, n=item.subtitles.count() ; i<n ; ++i) {
+                const SubtitleFiles &subtitle = item.subtitles.at(i);
+                QString subFileName = QFileInfo(newFileName).completeBaseName();
+                if (!subtitle.language.isEmpty())
+                    subFileName.append("." + subtitle.language);
+                if (subtitle.forced)
+                    subFileName.append(".forced");
+
+                QStringList newSubFiles;
+                foreach (const QString &subFile, subtitle.files) {
+                    QString newSubFileName = subFileName + "." + QFileInfo(subFile).suffix();
+                    if (subFile != newSubFileName)
+                        addRename(plan, fi.canonicalPath() + "/" + subFile, fi.canonicalPath() + "/" + newSubFileName, subFile, newSubFileName, OperationRename);
+                    newSubFiles << newSubFileName;
+                    filmFiles << newSubFileName;
+                }
+                plan.newSubtitleFiles.insert(i, newSubFiles);
+            }
+        }
+
+        foreach (const SideFile &sideFile, item.sideFiles) {
+            if (sideFile.path.isEmpty() || sideFile.dataFiles.isEmpty())
+                continue;
+            QString fileName = QFileInfo(sideFile.path).fileName();
+            DataFile dataFile = sideFile.dataFiles.first();
+            QString newSideFileName = dataFile.saveFileName(newFileName, -1, sideFile.stacked);
+            Helper::instance()->sanitizeFileName(newSideFileName);
+            if (newSideFileName != fileName)
+                addRename(plan, sideFile.path, fiCanonicalPath + "/" + newSideFileName, fileName, newSideFileName, OperationRename);
+            filmFiles << newSideFileName;
+        }
+    }
+
+    QString newMovieFolder = dir.path();
+    if (m_patterns.renameDirectories) {
+        QString newFolderName = m_patterns.directoryPattern;
+        Renamer::replace(newFolderName, "extension", fi.suffix());
+        Renamer::replaceCondition(newFolderName, "bluray", isBluRay);
+        Renamer::replaceCondition(newFolderName, "dvd", isDvd);
+        newFolderName = fill(newFolderName, item);
+
+        if (dir.dirName() != newFolderName && item.inSeparateFolder) {
+            newMovieFolder = parentDir.path() + "/" + newFolderName;
+            addRename(plan, dir.path(), newMovieFolder, dir.dirName(), newFolderName, OperationRename);
+        } else if (dir.dirName() != newFolderName) {
+            newFolderName = nextFreeDir(dir.path(), newFolderName);
+            newMovieFolder = dir.path() + "/" + newFolderName;
+            addCreateDir(plan, newMovieFolder, dir.dirName(), newFolderName);
+            foreach (const QString &fileName, filmFiles)
+                addRename(plan, dir.path() + "/" + fileName, newMovieFolder + "/" + fileName, fileName,
+                          dir.dirName() + "/" + newFolderName + "/" + fileName, OperationMove);
+        }
+    }
+
+    foreach (const QString &file, newMovieFiles) {
+        QString f = newMovieFolder;
+        if (isBluRay || isDvd)
+            f += "/" + parentDirName;
+        plan.newFiles << f + "/" + file;
+    }
+    m_plan.items.append(plan);
+}
+
+/**
+ * @brief Plans the renaming of the files, extra files, nfo and images of a concert and its directory
+ * @param item Snapshot of the concert
+ */
+void RenamePlanner::planConcert(const Item &item)
+{
+    QFileInfo fi(item.files.first());
+    QString fiCanonicalPath = fi.canonicalPath();
+    QDir dir(fiCanonicalPath);
+    QDir chkDir(fiCanonicalPath);
+    chkDir.cdUp();
+
+    bool isBluRay = Helper::instance()->isBluRay(chkDir.path());
+    bool isDvd = Helper::instance()->isDvd(chkDir.path());
+
+    QString parentDirName;
+    if (isBluRay || isDvd) {
+        parentDirName = dir.dirName();
+        dir.cdUp();
+    }
+    QDir parentDir(dir.path());
+    parentDir.cdUp();
+
+    ItemPlan plan = itemPlan(item, parentDir.path(), 0);
+    QStringList newConcertFiles;
+    foreach (const QString &file, item.files)
+        newConcertFiles << QFileInfo(file).fileName();
+
+    if (!isBluRay && !isDvd && m_patterns.renameFiles) {
+        newConcertFiles.clear();
+        QString newFileName;
+        int partNo = 0;
+        foreach (const QString &file, item.files) {
+            QFileInfo fi(file);
+            QString baseName = fi.completeBaseName();
+            QDir currentDir = fi.dir();
+            newFileName = (item.files.count() == 1) ? m_patterns.filePattern : m_patterns.filePatternMulti;
+            Renamer::replace(newFileName, "extension", fi.suffix());
+            Renamer::replace(newFileName, "partNo", QString::number(++partNo));
+            newFileName = fill(newFileName, item);
+            newConcertFiles << newFileName;
+            if (fi.fileName() == newFileName)
+                continue;
+
+            addRename(plan, file, fi.canonicalPath() + "/" + newFileName, fi.fileName(), newFileName, OperationRename);
+
+            QStringList filters;
+            foreach (const QString &extra, m_patterns.extraFiles)
+                filters << baseName + extra;
+            foreach (const QString &subFileName, currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
+                QString newSubName = newFileName.left(newFileName.lastIndexOf(".")) + subFileName.mid(baseName.length());
+                addRename(plan, currentDir.canonicalPath() + "/" + subFileName, currentDir.canonicalPath() + "/" + newSubName,
+                          subFileName, newSubName, OperationRename);
+            }
+        }
+
+        foreach (const SideFile &sideFile, item.sideFiles) {
+            if (sideFile.path.isEmpty() || sideFile.dataFiles.isEmpty())
+                continue;
+            QString fileName = QFileInfo(sideFile.path).fileName();
+            DataFile dataFile = sideFile.dataFiles.first();
+            QString newSideFileName = dataFile.saveFileName(newFileName, -1, sideFile.stacked);
+            Helper::instance()->sanitizeFileName(newSideFileName);
+            if (newSideFileName != fileName)
+                addRename(plan, sideFile.path, fiCanonicalPath + "/" + newSideFileName, fileName, newSideFileName, OperationRename);
+        }
+    }
+
+    QString newConcertFolder = dir.path();
+    if (m_patterns.renameDirectories && item.inSeparateFolder) {
+        QString newFolderName = m_patterns.directoryPattern;
+        Renamer::replaceCondition(newFolderName, "bluray", isBluRay);
+        Renamer::replaceCondition(newFolderName, "dvd", isDvd);
+        newFolderName = fill(newFolderName, item);
+        if (dir.dirName() != newFolderName) {
+            newConcertFolder = parentDir.path() + "/" + newFolderName;
+            addRename(plan, dir.path(), newConcertFolder, dir.dirName(), newFolderName, OperationRename);
+        }
+    }
+
+    foreach (const QString &file, newConcertFiles) {
+        QString f = newConcertFolder;
+        if (isBluRay || isDvd)
+            f += "/" + parentDirName;
+        plan.newFiles << f + "/" + file;
+    }
+    m_plan.items.append(plan);
+}
+
+/**
+ * @brief Plans the renaming of the files, extra files, nfo and thumbnail of an episode
+ *        and moves them to their season directory. Missing season directories are
+ *        planned as separate items, so they exist before any episode is moved.
+ * @param item Snapshot of the episode, multi episodes share one item
+ */
+void RenamePlanner::planEpisode(const Item &item)
+{
+    QString firstFile = item.files.first();
+    bool isBluRay = Helper::instance()->isBluRay(firstFile);
+    bool isDvd = Helper::instance()->isDvd(firstFile);
+    bool isDvdWithoutSub = Helper::instance()->isDvd(firstFile, true);
+    QFileInfo fi(firstFile);
+    QString fiCanonicalPath = fi.canonicalPath();
+
+    ItemPlan plan = itemPlan(item, item.dir, 1);
+    QStringList newEpisodeFiles;
+    QStringList sideFiles;
+    foreach (const QString &file, item.files)
+        newEpisodeFiles << QFileInfo(file).fileName();
+    foreach (const SideFile &sideFile, item.sideFiles) {
+        if (!sideFile.path.isEmpty())
+            sideFiles << QFileInfo(sideFile.path).fileName();
+    }
+
+    if (!isBluRay && !isDvd && !isDvdWithoutSub && m_patterns.renameFiles) {
+        newEpisodeFiles.clear();
+        sideFiles.clear();
+        QString newFileName;
+        int partNo = 0;
+        foreach (const QString &file, item.files) {
+            QFileInfo fi(file);
+            QString baseName = fi.completeBaseName();
+            QDir currentDir = fi.dir();
+            newFileName = (item.files.count() == 1) ? m_patterns.filePattern : m_patterns.filePatternMulti;
+            Renamer::replace(newFileName, "extension", fi.suffix());
+            Renamer::replace(newFileName, "partNo", QString::number(++partNo));
+            newFileName = fill(newFileName, item);
+            newEpisodeFiles << newFileName;
+            if (fi.fileName() == newFileName)
+                continue;
+
+            addRename(plan, file, fi.canonicalPath() + "/" + newFileName, fi.fileName(), newFileName, OperationRename);
+
+            QStringList filters;
+            foreach (const QString &extra, m_patterns.extraFiles)
+                filters << baseName + extra;
+            foreach (const QString &subFileName, currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
+                QString newSubName = newFileName.left(newFileName.lastIndexOf(".")) + subFileName.mid(baseName.length());
+                addRename(plan, currentDir.canonicalPath() + "/" + subFileName, currentDir.canonicalPath() + "/" + newSubName,
+                          subFileName, newSubName, OperationRename);
+            }
+        }
+
+        foreach (const SideFile &sideFile, item.sideFiles) {
+            if (sideFile.path.isEmpty())
+                continue;
+            QString fileName = QFileInfo(sideFile.path).fileName();
+            if (sideFile.dataFiles.isEmpty()) {
+                sideFiles << fileName;
+                continue;
+            }
+            DataFile dataFile = sideFile.dataFiles.first();
+            QString newSideFileName = dataFile.saveFileName(newFileName, -1, sideFile.stacked);
+            Helper::instance()->sanitizeFileName(newSideFileName);
+            if (newSideFileName != fileName)
+                addRename(plan, sideFile.path, fiCanonicalPath + "/" + newSideFileName, fileName, newSideFileName, OperationRename);
+            sideFiles << newSideFileName;
+        }
+    }
+
+    QStringList renamedFiles;
+    foreach (const QString &file, newEpisodeFiles)
+        renamedFiles << fi.path() + "/" + file;
+    plan.newFiles = renamedFiles;
+
+    if (m_patterns.useSeasonDirectories) {
+        QString seasonDirName = m_patterns.seasonPattern;
+        Renamer::replace(seasonDirName, "season", item.placeholders.value("season"));
+        Helper::instance()->sanitizeFileName(seasonDirName);
+        QString seasonDirPath = item.dir + "/" + seasonDirName;
+        QDir seasonDir(seasonDirPath);
+        if (!seasonDir.exists() && !m_plannedTargets.contains(seasonDirPath)) {
+            ItemPlan seasonPlan = itemPlan(item, item.dir, 0);
+            seasonPlan.type = ItemSeasonDir;
+            seasonPlan.objects.clear();
+            seasonPlan.label = tr("<b>Directory</b> \"%1\"").arg(seasonDirName);
+            addCreateDir(seasonPlan, seasonDirPath, seasonDirName, "");
+            m_plan.items.append(seasonPlan);
+        }
+
+        if (isBluRay || isDvd || isDvdWithoutSub) {
+            QDir dir = fi.dir();
+            if (isDvd || isBluRay)
+                dir.cdUp();
+            QDir parentDir = dir;
+            parentDir.cdUp();
+            if (parentDir != seasonDir) {
+                QString newDir = seasonDirPath + "/" + dir.dirName();
+                addRename(plan, dir.path(), newDir, dir.dirName(), seasonDirName, OperationMove);
+                plan.newFiles.clear();
+                foreach (const QString &file, renamedFiles)
+                    plan.newFiles << newDir + file.mid(dir.path().length());
+            }
+        } else if (fi.dir() != seasonDir) {
+            plan.newFiles.clear();
+            foreach (const QString &file, renamedFiles) {
+                QString fileName = QFileInfo(file).fileName();
+                addRename(plan, file, seasonDirPath + "/" + fileName, fileName, seasonDirName, OperationMove);
+                plan.newFiles << seasonDirPath + "/" + fileName;
+            }
+            foreach (const QString &fileName, sideFiles)
+                addRename(plan, fiCanonicalPath + "/" + fileName, seasonDirPath + "/" + fileName, fileName, seasonDirName, OperationMove);
+        }
+    }
+
+    m_plan.items.append(plan);
+}
+
+/**
+ * @brief Plans the renaming of the directory of a tv show
+ * @param item Snapshot of the tv show
+ */
+void RenamePlanner::planShow(const Item &item)
+{
+    QDir dir(item.dir);
+    QDir parentDir(dir.path());
+    parentDir.cdUp();
+
+    ItemPlan plan = itemPlan(item, parentDir.path(), 2);
+    QString newFolderName = fill(m_patterns.directoryPattern, item);
+    if (newFolderName != dir.dirName()) {
+        plan.newDir = parentDir.path() + "/" + newFolderName;
+        addRename(plan, dir.path(), plan.newDir, dir.dirName(), newFolderName, OperationRename);
+    }
+    m_plan.items.append(plan);
+}
+
+/**
+ * @brief Creates an empty plan for an item
+ * @param item Snapshot of the item
+ * @param dir Directory used to look up the mount of the item
+ * @param phase Phase of the item
+ * @return Plan without steps
+ */
+RenamePlanner::ItemPlan RenamePlanner::itemPlan(const Item &item, const QString &dir, int phase)
+{
+    ItemPlan plan;
+    plan.type = item.type;
+    plan.objects = item.objects;
+    plan.label = item.label;
+    plan.mount = mountOf(dir);
+    plan.phase = phase;
+    return plan;
+}
+
+/**
+ * @brief Replaces the placeholders and conditions of a pattern with the values of an item
+ * @param pattern Pattern, item independent placeholders like extension have to be replaced before
+ * @param item Snapshot of the item
+ * @return Sanitized file name
+ */
+QString RenamePlanner::fill(const QString &pattern, const Item &item)
+{
+    QString text = pattern;
+    QMapIterator<QString, QString> it(item.placeholders);
+    while (it.hasNext()) {
+        it.next();
+        Renamer::replace(text, it.key(), it.value());
+    }
+    QMapIterator<QString, QString> textIt(item.textConditions);
+    while (textIt.hasNext()) {
+        textIt.next();
+        Renamer::replaceCondition(text, textIt.key(), textIt.value());
+    }
+    QMapIterator<QString, bool> flagIt(item.flagConditions);
+    while (flagIt.hasNext()) {
+        flagIt.next();
+        Renamer::replaceCondition(text, flagIt.key(), flagIt.value());
+    }
+    Helper::instance()->sanitizeFileName(text);
+    return text;
+}
+
+/**
+ * @brief Appends a number to a directory name until neither an existing nor a planned file has that name
+ * @param parentDir Parent directory
+ * @param name Name of the new directory
+ * @return Free name
+ */
+QString RenamePlanner::nextFreeDir(const QString &parentDir, const QString &name)
+{
+    QString newName = name;
+    int i = 0;
+    while (QFileInfo(parentDir + "/" + newName).exists() || m_plannedTargets.contains(parentDir + "/" + newName))
+        newName = name + " " + QString::number(++i);
+    return newName;
+}
+
+/**
+ * @brief Adds a rename or move to the plan of an item and checks if it conflicts with an existing file
+ *        or another planned operation. Existing targets are fine if they only differ in case from the source
+ *        or are renamed themselves before, i.e. by the same item or an item of an earlier phase.
+ * @param plan Plan of the item
+ * @param source Current path
+ * @param target New path
+ * @param oldName Old name shown in the results
+ * @param newName New name shown in the results
+ * @param operation Rename or move
+ */
+void RenamePlanner::addRename(ItemPlan &plan, const QString &source, const QString &target, const QString &oldName, const QString &newName,
+                              Operation operation)
+{
+    bool sameFile = QString::compare(source, target, Qt::CaseInsensitive) == 0;
+    bool movedBefore = m_plannedSources.contains(target) && m_plannedSources.value(target) < plan.phase;
+    foreach (const Step &step, plan.steps) {
+        if (step.source == target)
+            movedBefore = true;
+    }
+
+    if (m_plannedTargets.contains(target))
+        m_plan.conflicts.append(target);
+    else if (!sameFile && !movedBefore && QFileInfo(target).exists())
+        m_plan.conflicts.append(target);
+    m_plannedSources.insert(source, plan.phase);
+    m_plannedTargets.insert(target);
+
+    Step step;
+    step.operation = operation;
+    step.source = source;
+    step.target = target;
+    step.oldName = oldName;
+    step.newName = newName;
+    step.row = -1;
+    plan.steps.append(step);
+}
+
+/**
+ * @brief Adds the creation of a directory to the plan of an item
+ * @param plan Plan of the item
+ * @param dir Path of the new directory
+ * @param oldName Name shown in the results
+ * @param newName Name shown in the results
+ */
+void RenamePlanner::addCreateDir(ItemPlan &plan, const QString &dir, const QString &oldName, const QString &newName)
+{
+    m_plannedTargets.insert(dir);
+
+    Step step;
+    step.operation = OperationCreateDir;
+    step.target = dir;
+    step.oldName = oldName;
+    step.newName = newName;
+    step.row = -1;
+    plan.steps.append(step);
+}
+
+/**
+ * @brief Looks up the mount of a directory, directories of many items share one lookup
+ * @param dir Directory
+ * @return Mount, empty if it's not known
+ */
+QString RenamePlanner::mountOf(const QString &dir)
+{
+    if (!m_mounts.contains(dir))
+        m_mounts.insert(dir, Helper::instance()->mountOf(dir));
+    return m_mounts.value(dir);
+}
@@ -0,0 +1,142 @@
+#ifndef RENAMEPLANNER_H
+#define RENAMEPLANNER_H
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+#include "settings/DataFile.h"
+
+/**
+ * @brief The RenamePlanner class
+ * Computes the file system operations of the renamer without touching any file.
+ * The planner only works on snapshots of the items, which are taken in the main thread,
+ * so it can run in a background thread. Targets which already exist or are written by
+ * more than one operation are reported as conflicts.
+ */
+class RenamePlanner
+{
+    Q_DECLARE_TR_FUNCTIONS(RenamePlanner)
+
+public:
+    enum Operation {
+        OperationCreateDir, OperationMove, OperationRename
+    };
+    enum ItemType {
+        ItemMovie, ItemConcert, ItemEpisode, ItemSeasonDir, ItemShow
+    };
+
+    /**
+     * @brief Nfo or image file of an item and the data file which names it
+     */
+    struct SideFile {
+        QString path;
+        QList<DataFile> dataFiles;
+        bool stacked;
+    };
+
+    /**
+     * @brief Subtitle of a movie, files are relative to the directory of the movie
+     */
+    struct SubtitleFiles {
+        QString language;
+        bool forced;
+        QStringList files;
+    };
+
+    /**
+     * @brief Everything the planner needs to know about an item, taken in the main thread
+     */
+    struct Item {
+        ItemType type;
+        QList<QObject*> objects;
+        QString label;
+        QStringList files;
+        QString dir;
+        bool inSeparateFolder;
+        QMap<QString, QString> placeholders;
+        QMap<QString, QString> textConditions;
+        QMap<QString, bool> flagConditions;
+        QList<SideFile> sideFiles;
+        QList<SubtitleFiles> subtitles;
+    };
+
+    /**
+     * @brief Patterns and options chosen in the renamer dialog
+     */
+    struct Patterns {
+        QString filePattern;
+        QString filePatternMulti;
+        QString directoryPattern;
+        QString seasonPattern;
+        bool renameFiles;
+        bool renameDirectories;
+        bool useSeasonDirectories;
+        QStringList extraFiles;
+    };
+
+    /**
+     * @brief A single planned operation, row is the row of the operation in the results table
+     */
+    struct Step {
+        Operation operation;
+        QString source;
+        QString target;
+        QString oldName;
+        QString newName;
+        int row;
+    };
+
+    /**
+     * @brief Operations of one item and its files after renaming.
+     *        Items of a lower phase are renamed before items of a higher one,
+     *        e.g. season directories before the episodes which are moved into them.
+     */
+    struct ItemPlan {
+        ItemType type;
+        QList<QObject*> objects;
+        QString label;
+        QString mount;
+        int phase;
+        QList<Step> steps;
+        QStringList newFiles;
+        QMap<int, QStringList> newSubtitleFiles;
+        QString newDir;
+    };
+
+    /**
+     * @brief Result of the planner
+     */
+    struct Plan {
+        QList<ItemPlan> items;
+        QStringList conflicts;
+    };
+
+    static const int PhaseCount = 3;
+
+    explicit RenamePlanner(const Patterns &patterns);
+    Plan plan(const QList<Item> &items);
+
+private:
+    Patterns m_patterns;
+    Plan m_plan;
+    QHash<QString, int> m_plannedSources;
+    QSet<QString> m_plannedTargets;
+    QHash<QString, QString> m_mounts;
+
+    void planMovie(const Item &item);
+    void planConcert(const Item &item);
+    void planEpisode(const Item &item);
+    void planShow(const Item &item);
+    ItemPlan itemPlan(const Item &item, const QString &dir, int phase);
+    QString fill(const QString &pattern, const Item &item);
+    QString nextFreeDir(const QString &parentDir, const QString &name);
+    void addRename(ItemPlan &plan, const QString &source, const QString &target, const QString &oldName, const QString &newName,
+                   Operation operation);
+    void addCreateDir(ItemPlan &plan, const QString &dir, const QString &oldName, const QString &newName);
+    QString mountOf(const QString &dir);
+};
+
+#endif // RENAMEPLANNER_H
@@ -2,16 +2,72 @@
 #include "ui_Renamer.h"
 
 #include <QDir>
-#include <QFile>
 #include <QFileInfo>
+#include <QMutexLocker>
+#include <QRunnable>
 #include "globals/Helper.h"
 #include "globals/Manager.h"
+#include "renamer/RenameJournal.h"
+
+/**
+ * @brief The RenamerPlanJob class
+ * Computes the plan of a Renamer in its planner thread
+ */
+class RenamerPlanJob : public QRunnable
+{
+public:
+    explicit RenamerPlanJob(Renamer *renamer) :
+        m_renamer(renamer)
+    {
+    }
+    void run()
+    {
+        m_renamer->runPlanner();
+    }
+
+private:
+    Renamer *m_renamer;
+};
+
+/**
+ * @brief The RenamerJob class
+ * Renames a single planned item in the job queue of a Renamer
+ */
+class RenamerJob : public QRunnable
+{
+public:
+    RenamerJob(Renamer *renamer, int index) :
+        m_renamer(renamer),
+        m_index(index)
+    {
+    }
+    void run()
+    {
+        m_renamer->run(m_index);
+    }
+
+private:
+    Renamer *m_renamer;
+    int m_index;
+};
+
+/**
+ * @brief Renames are cheap metadata operations, but a few of them per mount keep slow network shares busy
+ */
+static const int RenameJobsPerMount = 4;
 
 Renamer::Renamer(QWidget *parent) :
     QDialog(parent),
-    ui(new Ui::Renamer)
+    ui(new Ui::Renamer),
+    m_renaming(false),
+    m_renameAfterPlanning(false),
+    m_cancelRequested(false),
+    m_jobs(RenameJobsPerMount),
+    m_phase(-1),
+    m_jobsPending(0)
 {
     ui->setupUi(this);
+    m_planPool.setMaxThreadCount(1);
 
     ui->resultsTable->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
     ui->resultsTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
@@ -37,6 +93,11 @@ Renamer::Renamer(QWidget *parent) :
 
 Renamer::~Renamer()
 {
+    m_mutex.lock();
+    m_jobs.clear();
+    m_mutex.unlock();
+    m_jobs.waitForDone();
+    m_planPool.waitForDone();
     delete ui;
 }
 
@@ -94,6 +155,15 @@ int Renamer::exec()
 
 void Renamer::reject()
 {
+    if (m_renaming) {
+        m_cancelRequested = true;
+        QMutexLocker locker(&m_mutex);
+        m_jobsPending -= m_jobs.clear();
+        if (m_jobsPending == 0 && m_phase >= 0)
+            QMetaObject::invokeMethod(this, "onItemsRenamed", Qt::QueuedConnection);
+        return;
+    }
+
     m_movies.clear();
     m_concerts.clear();
     m_shows.clear();
@@ -160,1004 +230,481 @@ void Renamer::onChkUseSeasonDirectories()
 
 void Renamer::onRename()
 {
-    ui->tabWidget->setCurrentIndex(1);
-    ui->results->clear();
-    ui->resultsTable->setRowCount(0);
-    ui->btnRename->setEnabled(false);
-    ui->btnDryRun->setEnabled(false);
-    if (m_renameType == TypeMovies) {
-        renameMovies(m_movies, ui->fileNaming->text(), ui->fileNamingMulti->text(),
-                     ui->directoryNaming->text(), ui->chkFileNaming->isChecked(), ui->chkDirectoryNaming->isChecked());
-    } else if (m_renameType == TypeConcerts) {
-        renameConcerts(m_concerts, ui->fileNaming->text(), ui->fileNamingMulti->text(),
-                     ui->directoryNaming->text(), ui->chkFileNaming->isChecked(), ui->chkDirectoryNaming->isChecked());
-    } else if (m_renameType == TypeTvShows) {
-        renameEpisodes(m_episodes, ui->fileNaming->text(), ui->fileNamingMulti->text(), ui->seasonNaming->text(),
-                       ui->chkFileNaming->isChecked(), ui->chkSeasonDirectories->isChecked());
-        renameShows(m_shows, ui->directoryNaming->text(), ui->chkDirectoryNaming->isChecked());
-    }
-    m_filesRenamed = true;
-    ui->results->append("<span style=\"color:#01a800;\"><b>" + tr("Finished") + "</b></span>");
+    startPlanning(true);
 }
 
 void Renamer::onDryRun()
+{
+    startPlanning(false);
+}
+
+/**
+ * @brief Takes a snapshot of the items and computes the plan in the background
+ * @param rename Rename the items when the plan is ready and has no conflicts
+ */
+void Renamer::startPlanning(bool rename)
 {
     ui->tabWidget->setCurrentIndex(1);
+    ui->btnRename->setEnabled(false);
+    ui->btnDryRun->setEnabled(false);
     ui->results->clear();
     ui->resultsTable->setRowCount(0);
-    if (m_renameType == TypeMovies) {
-        renameMovies(m_movies, ui->fileNaming->text(), ui->fileNamingMulti->text(),
-                     ui->directoryNaming->text(), ui->chkFileNaming->isChecked(), ui->chkDirectoryNaming->isChecked(), true);
-    } else if (m_renameType == TypeConcerts) {
-        renameConcerts(m_concerts, ui->fileNaming->text(), ui->fileNamingMulti->text(),
-                       ui->directoryNaming->text(), ui->chkFileNaming->isChecked(), ui->chkDirectoryNaming->isChecked(), true);
-    } else if (m_renameType == TypeTvShows) {
-        renameEpisodes(m_episodes, ui->fileNaming->text(), ui->fileNamingMulti->text(), ui->seasonNaming->text(),
-                       ui->chkFileNaming->isChecked(), ui->chkSeasonDirectories->isChecked(), true);
-        renameShows(m_shows, ui->directoryNaming->text(), ui->chkDirectoryNaming->isChecked(), true);
-    }
-    ui->results->append("<span style=\"color:#01a800;\"><b>" + tr("Finished") + "</b></span>");
+    setRenaming(true);
+    m_renameAfterPlanning = rename;
+    takeSnapshot();
+    m_planPool.start(new RenamerPlanJob(this));
 }
 
-void Renamer::renameMovies(QList<Movie*> movies, const QString &filePattern, const QString &filePatternMulti,
-                           const QString &directoryPattern, const bool &renameFiles, const bool &renameDirectories, const bool &dryRun)
+/**
+ * @brief Copies the patterns and everything the planner needs to know about the items of the current type.
+ *        Items which have been edited but not saved are skipped.
+ */
+void Renamer::takeSnapshot()
 {
-    if ((renameFiles && filePattern.isEmpty()) || (renameDirectories && directoryPattern.isEmpty()))
-        return;
-
-    foreach (Movie *movie, movies) {
-        if (movie->files().isEmpty() || (movie->files().count() > 1 && filePatternMulti.isEmpty()))
-            continue;
-
-        if (movie->hasChanged()) {
-            ui->results->append(tr("<b>Movie</b> \"%1\" has been edited but is not saved").arg(movie->name()));
-            continue;
-        }
-
-        qApp->processEvents();
-        QFileInfo fi(movie->files().first());
-        QString fiCanonicalPath = fi.canonicalPath();
-        QDir dir(fi.canonicalPath());
-        QString newFolderName = directoryPattern;
-        QString newFileName;
-        QString nfo = Manager::instance()->mediaCenterInterface()->nfoFilePath(movie);
-        QString poster = Manager::instance()->mediaCenterInterface()->imageFileName(movie, ImageType::MoviePoster);
-        QString fanart = Manager::instance()->mediaCenterInterface()->imageFileName(movie, ImageType::MovieBackdrop);
-        QString banner = Manager::instance()->mediaCenterInterface()->imageFileName(movie, ImageType::MovieBanner);
-        QString thumb = Manager::instance()->mediaCenterInterface()->imageFileName(movie, ImageType::MovieThumb);
-        QString logo = Manager::instance()->mediaCenterInterface()->imageFileName(movie, ImageType::MovieLogo);
-        QString clearArt = Manager::instance()->mediaCenterInterface()->imageFileName(movie, ImageType::MovieClearArt);
-        QString cdArt = Manager::instance()->mediaCenterInterface()->imageFileName(movie, ImageType::MovieCdArt);
-        QStringList FilmFiles;
-        QStringList newMovieFiles;
-        QString parentDirName;
-        bool errorOccured = false;
-
-        foreach (const QString &file, movie->files()) {
-            QFileInfo fi(file);
-            newMovieFiles.append(fi.fileName());
-        }
-
-        QDir chkDir(fi.canonicalPath());
-        chkDir.cdUp();
-
-        bool isBluRay = Helper::instance()->isBluRay(chkDir.path());
-        bool isDvd = Helper::instance()->isDvd(chkDir.path());
-
-        if (isBluRay || isDvd) {
-            parentDirName = dir.dirName();
-            dir.cdUp();
-        }
-
-        if (!isBluRay && !isDvd && renameFiles) {
-            newMovieFiles.clear();
-            int partNo = 0;
-            foreach (const QString &file, movie->files()) {
-                newFileName = (movie->files().count() == 1) ? filePattern : filePatternMulti;
-                QFileInfo fi(file);
-                QString baseName = fi.completeBaseName();
-                QDir currentDir = fi.dir();
-                Renamer::replace(newFileName, "title", movie->name());
-                Renamer::replace(newFileName, "originalTitle", movie->originalName());
-                Renamer::replace(newFileName, "sortTitle", movie->sortTitle());
-                Renamer::replace(newFileName, "year", movie->released().toString("yyyy"));
-                Renamer::replace(newFileName, "extension", fi.suffix());
-                Renamer::replace(newFileName, "partNo", QString::number(++partNo));
-                Renamer::replace(newFileName, "videoCodec", movie->streamDetails()->videoCodec());
-                Renamer::replace(newFileName, "audioCodec", movie->streamDetails()->audioCodec());
-                Renamer::replace(newFileName, "channels", QString::number(movie->streamDetails()->audioChannels()));
-                Renamer::replace(newFileName, "resolution", Helper::instance()->matchResolution(movie->streamDetails()->videoDetails().value("width").toInt(),
-                                                                                                movie->streamDetails()->videoDetails().value("height").toInt(),
-                                                                                                movie->streamDetails()->videoDetails().value("scantype")));
-                Renamer::replaceCondition(newFileName, "imdbId", movie->id());
-                Renamer::replaceCondition(newFileName, "movieset", movie->set());
-                Renamer::replaceCondition(newFileName, "3D", movie->streamDetails()->videoDetails().value("stereomode") != "");
-                Helper::instance()->sanitizeFileName(newFileName);
-                if (fi.fileName() != newFileName) {
-                    int row = addResult(fi.fileName(), newFileName, OperationRename);
-                    if (!dryRun) {
-                        if (!rename(file, fi.canonicalPath() + "/" + newFileName)){
-                            setResultStatus(row, RenameFailed);
-                            errorOccured = true;
-                            continue;
-                        } else {
-                            FilmFiles.append(newFileName);
-                            newMovieFiles.append(newFileName);
-                        }
-                    } else {
-                        FilmFiles.append(newFileName);
-                    }
-
-                    foreach (const QString &trailerFile, currentDir.entryList(QStringList() << fi.completeBaseName() + "-trailer.*", QDir::Files | QDir::NoDotAndDotDot)) {
-                        QFileInfo trailer(fi.canonicalPath() + "/" + trailerFile);
-                        QString newTrailerFileName = newFileName;
-                        newTrailerFileName = newTrailerFileName.left(newTrailerFileName.lastIndexOf(".")) + "-trailer." + trailer.suffix();
-                        if (trailer.fileName() != newTrailerFileName) {
-                            int row = addResult(trailer.fileName(), newTrailerFileName, OperationRename);
-                            if (!dryRun) {
-                                if (!rename(fi.canonicalPath() + "/" + trailerFile, fi.canonicalPath() + "/" + newTrailerFileName))
-                                    setResultStatus(row, RenameFailed);
-                                else
-                                    FilmFiles.append(newTrailerFileName);
-                            }
-                            else
-                                FilmFiles.append(newTrailerFileName);
-                        }
-                        else
-                            FilmFiles.append(trailer.fileName());
-                    }
-
-                    /*
-                    QStringList filters;
-                    foreach (const QString &extra, m_extraFiles)
-                        filters << baseName + extra;
-                    foreach (const QString &subFileName, currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
-                        QString subSuffix = subFileName.mid(baseName.length());
-                        QString newBaseName = newFileName.left(newFileName.lastIndexOf("."));
-                        QString newSubName = newBaseName + subSuffix;
-                        ui->results->append(tr("<b>Rename File</b> \"%1\" to \"%2\"").arg(subFileName).arg(newSubName));
-                        if (!dryRun) {
-                            if (!rename(currentDir.canonicalPath() + "/" + subFileName, currentDir.canonicalPath() + "/" + newSubName))
-                                ui->results->append("&nbsp;&nbsp;<span style=\"color:#ff0000;\"><b>" + tr("Failed") + "</b></span>");
-                            else
-                                FilmFiles.append(newSubName);
-                        }
-                        else
-                            FilmFiles.append(newSubName);
-                    }
-                    */
-
-                    foreach (Subtitle *subtitle, movie->subtitles()) {
-                        QString subFileName = QFileInfo(newFileName).completeBaseName();
-                        if (!subtitle->language().isEmpty())
-                            subFileName.append("." + subtitle->language());
-                        if (subtitle->forced())
-                            subFileName.append(".forced");
-
-                        QStringList newSubFiles;
-                        foreach (const QString &subFile, subtitle->files()) {
-                            QFileInfo subFi(fi.canonicalPath() + "/" + subFile);
-                            QString newSubFileName = subFileName + "." + subFi.suffix();
-                            int row = addResult(subFile, newSubFileName, OperationRename);
-                            if (!dryRun) {
-                                if (!rename(fi.canonicalPath() + "/" + subFile, fi.canonicalPath() + "/" + newSubFileName)) {
-                                    newSubFiles << subFile;
-                                    setResultStatus(row, RenameFailed);
-                                } else {
-                                    newSubFiles << newSubFileName;
-                                    FilmFiles.append(newSubFileName);
-                                }
-                            } else {
-                                FilmFiles.append(newSubFileName);
-                            }
-                        }
-                        if (!dryRun)
-                            subtitle->setFiles(newSubFiles, false);
-                    }
-                } else {
-                    FilmFiles.append(fi.fileName());
-                    newMovieFiles.append(fi.fileName());
-                }
-
-            }
+    m_patterns.filePattern = ui->fileNaming->text();
+    m_patterns.filePatternMulti = ui->fileNamingMulti->text();
+    m_patterns.directoryPattern = ui->directoryNaming->text();
+    m_patterns.seasonPattern = ui->seasonNaming->text();
+    m_patterns.renameFiles = ui->chkFileNaming->isChecked();
+    m_patterns.renameDirectories = ui->chkDirectoryNaming->isChecked();
+    m_patterns.useSeasonDirectories = ui->chkSeasonDirectories->isChecked();
+    m_patterns.extraFiles = m_extraFiles;
+    m_snapshot.clear();
+
+    MediaCenterInterface *mediaCenter = Manager::instance()->mediaCenterInterface();
 
-            // Rename nfo
-            if (!nfo.isEmpty()) {
-                QString nfoFileName = QFileInfo(nfo).fileName();
-                QList<DataFile> nfoFiles = Settings::instance()->dataFiles(DataFileType::MovieNfo);
-                if (!nfoFiles.isEmpty()) {
-                    QString newNfoFileName = nfoFiles.first().saveFileName(newFileName, -1, movie->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newNfoFileName);
-                    if (newNfoFileName != nfoFileName) {
-                        int row = addResult(nfoFileName, newNfoFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(nfo, fiCanonicalPath + "/" + newNfoFileName))
-                                setResultStatus(row, RenameFailed);
-                            else
-                                FilmFiles.append(newNfoFileName);
-                        }
-                        else
-                            FilmFiles.append(newNfoFileName);
-                    }
-                    else
-                        FilmFiles.append(nfoFileName);
-                }
-            }
-
-            // Rename Poster
-            if (!poster.isEmpty()) {
-                QString posterFileName = QFileInfo(poster).fileName();
-                QList<DataFile> posterFiles = Settings::instance()->dataFiles(DataFileType::MoviePoster);
-                if (!posterFiles.isEmpty()) {
-                    QString newPosterFileName = posterFiles.first().saveFileName(newFileName, -1, movie->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newPosterFileName);
-                    if (newPosterFileName != posterFileName) {
-                        int row = addResult(posterFileName, newPosterFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(poster, fiCanonicalPath + "/" + newPosterFileName))
-                                setResultStatus(row, RenameFailed);
-                            else
-                                FilmFiles.append(newPosterFileName);
-                        }
-                        else
-                            FilmFiles.append(newPosterFileName);
-                    }
-                    else
-                        FilmFiles.append(posterFileName);
-                }
-            }
-
-            // Rename Fanart
-            if (!fanart.isEmpty()) {
-                QString fanartFileName = QFileInfo(fanart).fileName();
-                QList<DataFile> fanartFiles = Settings::instance()->dataFiles(DataFileType::MovieBackdrop);
-                if (!fanartFiles.isEmpty()) {
-                    QString newFanartFileName = fanartFiles.first().saveFileName(newFileName, -1, movie->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newFanartFileName);
-                    if (newFanartFileName != fanartFileName) {
-                        int row = addResult(fanartFileName, newFanartFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(fanart, fiCanonicalPath + "/" + newFanartFileName))
-                                setResultStatus(row, RenameFailed);
-                            else
-                                FilmFiles.append(newFanartFileName);
-                        }
-                        else
-                            FilmFiles.append(newFanartFileName);
-                    }
-                    else
-                        FilmFiles.append(fanartFileName);
-                }
-            }
-
-            // Rename Banner
-            if (!banner.isEmpty()) {
-                QString bannerFileName = QFileInfo(banner).fileName();
-                QList<DataFile> bannerFiles = Settings::instance()->dataFiles(DataFileType::MovieBanner);
-                if (!bannerFiles.isEmpty()) {
-                    QString newBannerFileName = bannerFiles.first().saveFileName(newFileName, -1, movie->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newBannerFileName);
-                    if (newBannerFileName != bannerFileName) {
-                        int row = addResult(bannerFileName, newBannerFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(banner, fiCanonicalPath + "/" + newBannerFileName))
-                                setResultStatus(row, RenameFailed);
-                            else
-                                FilmFiles.append(newBannerFileName);
-                        }
-                        else
-                            FilmFiles.append(newBannerFileName);
-                    }
-                    else
-                        FilmFiles.append(bannerFileName);
-                }
-            }
-
-            // Rename Thumb
-            if (!thumb.isEmpty()) {
-                QString thumbFileName = QFileInfo(thumb).fileName();
-                QList<DataFile> thumbFiles = Settings::instance()->dataFiles(DataFileType::MovieThumb);
-                if (!thumbFiles.isEmpty()) {
-                    QString newThumbFileName = thumbFiles.first().saveFileName(newFileName, -1, movie->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newThumbFileName);
-                    if (newThumbFileName != thumbFileName) {
-                        int row = addResult(thumbFileName, newThumbFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(thumb, fiCanonicalPath + "/" + newThumbFileName))
-                                setResultStatus(row, RenameFailed);
-                            else
-                                FilmFiles.append(newThumbFileName);
-                        }
-                        else
-                            FilmFiles.append(newThumbFileName);
-                    }
-                    else
-                        FilmFiles.append(thumbFileName);
-                }
-            }
-
-            // Rename Logo
-            if (!logo.isEmpty()) {
-                QString logoFileName = QFileInfo(logo).fileName();
-                QList<DataFile> logoFiles = Settings::instance()->dataFiles(DataFileType::MovieLogo);
-                if (!logoFiles.isEmpty()) {
-                    QString newLogoFileName = logoFiles.first().saveFileName(newFileName, -1, movie->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newLogoFileName);
-                    if (newLogoFileName != logoFileName) {
-                        int row = addResult(logoFileName, newLogoFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(logo, fiCanonicalPath + "/" + newLogoFileName))
-                                setResultStatus(row, RenameFailed);
-                            else
-                                FilmFiles.append(newLogoFileName);
-                        }
-                        else
-                            FilmFiles.append(newLogoFileName);
-                    }
-                    else
-                        FilmFiles.append(logoFileName);
-                }
-            }
-
-            // Rename ClearArt
-            if (!clearArt.isEmpty()) {
-                QString clearArtFileName = QFileInfo(clearArt).fileName();
-                QList<DataFile> clearArtFiles = Settings::instance()->dataFiles(DataFileType::MovieClearArt);
-                if (!clearArtFiles.isEmpty()) {
-                    QString newClearArtFileName = clearArtFiles.first().saveFileName(newFileName, -1, movie->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newClearArtFileName);
-                    if (newClearArtFileName != clearArtFileName) {
-                        int row = addResult(clearArtFileName, newClearArtFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(clearArt, fiCanonicalPath + "/" + newClearArtFileName))
-                                setResultStatus(row, RenameFailed);
-                            else
-                                FilmFiles.append(newClearArtFileName);
-                        }
-                        else
-                            FilmFiles.append(newClearArtFileName);
-                    }
-                    else
-                        FilmFiles.append(clearArtFileName);
-                }
+    if (m_renameType == TypeMovies) {
+        foreach (Movie *movie, m_movies) {
+            if (movie->files().isEmpty())
+                continue;
+            if (movie->hasChanged()) {
+                ui->results->append(tr("<b>Movie</b> \"%1\" has been edited but is not saved").arg(movie->name()));
+                continue;
             }
 
-            // Rename CdArt
-            if (!cdArt.isEmpty()) {
-                QString cdArtFileName = QFileInfo(cdArt).fileName();
-                QList<DataFile> cdArtFiles = Settings::instance()->dataFiles(DataFileType::MovieCdArt);
-                if (!cdArtFiles.isEmpty()) {
-                    QString newCdArtFileName = cdArtFiles.first().saveFileName(newFileName, -1, movie->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newCdArtFileName);
-                    if (newCdArtFileName != cdArtFileName) {
-                        int row = addResult(cdArtFileName, newCdArtFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(cdArt, fiCanonicalPath + "/" + newCdArtFileName))
-                                setResultStatus(row, RenameFailed);
-                            else
-                                FilmFiles.append(newCdArtFileName);
-                        }
-                        else
-                            FilmFiles.append(newCdArtFileName);
-                    }
-                    else
-                        FilmFiles.append(cdArtFileName);
-                }
+            RenamePlanner::Item item;
+            item.type = RenamePlanner::ItemMovie;
+            item.objects << movie;
+            item.label = tr("<b>Movie</b> \"%1\"").arg(movie->name());
+            item.files = movie->files();
+            item.inSeparateFolder = movie->inSeparateFolder();
+            item.placeholders.insert("title", movie->name());
+            item.placeholders.insert("originalTitle", movie->originalName());
+            item.placeholders.insert("sortTitle", movie->sortTitle());
+            item.placeholders.insert("year", movie->released().toString("yyyy"));
+            item.textConditions.insert("imdbId", movie->id());
+            item.textConditions.insert("movieset", movie->set());
+            addStreamDetails(item, movie->streamDetails());
+
+            bool stacked = movie->files().count() > 1;
+            item.sideFiles << sideFile(mediaCenter->nfoFilePath(movie), DataFileType::MovieNfo, stacked)
+                           << sideFile(mediaCenter->imageFileName(movie, ImageType::MoviePoster), DataFileType::MoviePoster, stacked)
+                           << sideFile(mediaCenter->imageFileName(movie, ImageType::MovieBackdrop), DataFileType::MovieBackdrop, stacked)
+                           << sideFile(mediaCenter->imageFileName(movie, ImageType::MovieBanner), DataFileType::MovieBanner, stacked)
+                           << sideFile(mediaCenter->imageFileName(movie, ImageType::MovieThumb), DataFileType::MovieThumb, stacked)
+                           << sideFile(mediaCenter->imageFileName(movie, ImageType::MovieLogo), DataFileType::MovieLogo, stacked)
+                           << sideFile(mediaCenter->imageFileName(movie, ImageType::MovieClearArt), DataFileType::MovieClearArt, stacked)
+                           << sideFile(mediaCenter->imageFileName(movie, ImageType::MovieCdArt), DataFileType::MovieCdArt, stacked);
+            foreach (Subtitle *subtitle, movie->subtitles()) {
+                RenamePlanner::SubtitleFiles subtitleFiles;
+                subtitleFiles.language = subtitle->language();
+                subtitleFiles.forced = subtitle->forced();
+                subtitleFiles.files = subtitle->files();
+                item.subtitles << subtitleFiles;
             }
+            m_snapshot << item;
         }
+    } else if (m_renameType == TypeConcerts) {
+        foreach (Concert *concert, m_concerts) {
+            if (concert->files().isEmpty())
+                continue;
+            if (concert->hasChanged()) {
+                ui->results->append(tr("<b>Concert</b> \"%1\" has been edited but is not saved").arg(concert->name()));
+                continue;
+            }
 
-        int renameRow = -1;
-        QString newMovieFolder = dir.path();
-        QString extension = (!movie->files().isEmpty()) ? QFileInfo(movie->files().first()).suffix() : "";
-        //rename dir for already existe films dir
-        if (renameDirectories && movie->inSeparateFolder()) {
-            Renamer::replace(newFolderName, "title", movie->name());
-            Renamer::replace(newFolderName, "extension", extension);
-            Renamer::replace(newFolderName, "originalTitle", movie->originalName());
-            Renamer::replace(newFolderName, "sortTitle", movie->sortTitle());
-            Renamer::replace(newFolderName, "year", movie->released().toString("yyyy"));
-            Renamer::replace(newFolderName, "videoCodec", movie->streamDetails()->videoCodec());
-            Renamer::replace(newFolderName, "audioCodec", movie->streamDetails()->audioCodec());
-            Renamer::replace(newFolderName, "channels", QString::number(movie->streamDetails()->audioChannels()));
-            Renamer::replace(newFolderName, "resolution", Helper::instance()->matchResolution(movie->streamDetails()->videoDetails().value("width").toInt(),
-                                                                                              movie->streamDetails()->videoDetails().value("height").toInt(),
-                                                                                              movie->streamDetails()->videoDetails().value("scantype")));
-            Renamer::replaceCondition(newFolderName, "bluray", isBluRay);
-            Renamer::replaceCondition(newFolderName, "dvd", isDvd);
-            Renamer::replaceCondition(newFolderName, "3D", movie->streamDetails()->videoDetails().value("stereomode") != "");
-            Renamer::replaceCondition(newFolderName, "movieset", movie->set());
-            Renamer::replaceCondition(newFolderName, "imdbId", movie->id());
-            Helper::instance()->sanitizeFileName(newFolderName);
-            if (dir.dirName() != newFolderName)
-                renameRow = addResult(dir.dirName(), newFolderName, OperationRename);
+            RenamePlanner::Item item;
+            item.type = RenamePlanner::ItemConcert;
+            item.objects << concert;
+            item.label = tr("<b>Concert</b> \"%1\"").arg(concert->name());
+            item.files = concert->files();
+            item.inSeparateFolder = concert->inSeparateFolder();
+            item.placeholders.insert("title", concert->name());
+            item.placeholders.insert("artist", concert->artist());
+            item.placeholders.insert("album", concert->album());
+            item.placeholders.insert("year", concert->released().toString("yyyy"));
+            addStreamDetails(item, concert->streamDetails());
+
+            bool stacked = concert->files().count() > 1;
+            item.sideFiles << sideFile(mediaCenter->nfoFilePath(concert), DataFileType::ConcertNfo, stacked)
+                           << sideFile(mediaCenter->imageFileName(concert, ImageType::ConcertPoster), DataFileType::ConcertPoster, stacked)
+                           << sideFile(mediaCenter->imageFileName(concert, ImageType::ConcertBackdrop), DataFileType::ConcertBackdrop, stacked);
+            m_snapshot << item;
         }
-        //create dir for new dir structure
-        else if (renameDirectories) {
-            Renamer::replace(newFolderName, "title", movie->name());
-            Renamer::replace(newFolderName, "extension", extension);
-            Renamer::replace(newFolderName, "originalTitle", movie->originalName());
-            Renamer::replace(newFolderName, "sortTitle", movie->sortTitle());
-            Renamer::replace(newFolderName, "year", movie->released().toString("yyyy"));
-            Renamer::replace(newFolderName, "videoCodec", movie->streamDetails()->videoCodec());
-            Renamer::replace(newFolderName, "audioCodec", movie->streamDetails()->audioCodec());
-            Renamer::replace(newFolderName, "channels", QString::number(movie->streamDetails()->audioChannels()));
-            Renamer::replace(newFolderName, "resolution", Helper::instance()->matchResolution(movie->streamDetails()->videoDetails().value("width").toInt(),
-                                                                                              movie->streamDetails()->videoDetails().value("height").toInt(),
-                                                                                              movie->streamDetails()->videoDetails().value("scantype")));
-            Renamer::replaceCondition(newFolderName, "bluray", isBluRay);
-            Renamer::replaceCondition(newFolderName, "dvd", isDvd);
-            Renamer::replaceCondition(newFolderName, "3D", movie->streamDetails()->videoDetails().value("stereomode") != "");
-            Renamer::replaceCondition(newFolderName, "movieset", movie->set());
-            Renamer::replaceCondition(newFolderName, "imdbId", movie->id());
-            Helper::instance()->sanitizeFileName(newFolderName);
-
-            if (dir.dirName() != newFolderName){ //check if movie is not already on good folder
-                int i = 0 ;
-                while (dir.exists(newFolderName)){
-                    newFolderName = newFolderName + " " + QString::number(++i);
-                }
-
-                int row = addResult(dir.dirName(), newFolderName, OperationCreateDir);
-
-                if (!dryRun) {
-                    if (!dir.mkdir(newFolderName)){
-                        setResultStatus(row, RenameFailed);
-                        errorOccured = true;
-                        continue;
-                    } else {
-                        newMovieFolder = dir.path() + "/" + newFolderName;
-                    }
-                }
-
-                foreach (const QString &fileName, FilmFiles) {
-                    QFileInfo fi(fileName);
-                    if (dir.dirName() != newFolderName) {
-                        int row = addResult(fi.fileName(), dir.dirName() + "/" + newFolderName + "/" + fi.fileName(), OperationMove);
-                        ui->results->append(tr("<b>Move File</b> \"%1\" to \"%2\"").arg(fi.fileName()).arg(dir.dirName() + "/" + newFolderName + "/" + fi.fileName()));
-                        if (!dryRun) {
-                            if (!rename(dir.absolutePath() + "/" +fileName, dir.absolutePath() + "/" + newFolderName + "/" + fi.fileName()))
-                                setResultStatus(row, RenameFailed);
-
-                        }
-                    }
-                }
-            }
+    } else if (m_renameType == TypeTvShows) {
+        // Group the episodes of the affected shows by their files once, episodes sharing files are renamed together
+        QSet<TvShow*> shows;
+        QHash<QString, QList<TvShowEpisode*> > episodesByFiles;
+        foreach (TvShowEpisode *episode, m_episodes) {
+            if (shows.contains(episode->tvShow()))
+                continue;
+            shows.insert(episode->tvShow());
+            foreach (TvShowEpisode *subEpisode, episode->tvShow()->episodes())
+                episodesByFiles[subEpisode->files().join("\n")].append(subEpisode);
         }
 
+        QSet<TvShowEpisode*> episodesRenamed;
+        foreach (TvShowEpisode *episode, m_episodes) {
+            if (episode->files().isEmpty() || episodesRenamed.contains(episode))
+                continue;
+            if (episode->hasChanged()) {
+                ui->results->append(tr("<b>Episode</b> \"%1\" has been edited but is not saved").arg(episode->name()));
+                continue;
+            }
 
-        if (!dryRun && dir.dirName() != newFolderName && renameDirectories && movie->inSeparateFolder()) {
-            QDir parentDir(dir.path());
-            parentDir.cdUp();
-            if (!rename(dir, parentDir.path() + "/" + newFolderName)) {
-                setResultStatus(renameRow, RenameFailed);
-                errorOccured = true;
-            } else {
-                newMovieFolder = parentDir.path() + "/" + newFolderName;
+            QList<TvShowEpisode*> multiEpisodes = episodesByFiles.value(episode->files().join("\n"));
+            QStringList episodeStrings;
+            RenamePlanner::Item item;
+            foreach (TvShowEpisode *subEpisode, multiEpisodes) {
+                episodesRenamed.insert(subEpisode);
+                episodeStrings.append(subEpisode->episodeString());
+                item.objects << subEpisode;
             }
+            qSort(episodeStrings);
+
+            item.type = RenamePlanner::ItemEpisode;
+            item.label = tr("<b>Episode</b> \"%1\"").arg(episode->name());
+            item.files = episode->files();
+            item.dir = episode->tvShow()->dir();
+            item.inSeparateFolder = false;
+            item.placeholders.insert("title", episode->name());
+            item.placeholders.insert("showTitle", episode->showTitle());
+            item.placeholders.insert("year", episode->firstAired().toString("yyyy"));
+            item.placeholders.insert("season", episode->seasonString());
+            item.placeholders.insert("episode", (multiEpisodes.count() > 1) ? episodeStrings.join("-") : episode->episodeString());
+            addStreamDetails(item, episode->streamDetails());
+            item.sideFiles << sideFile(mediaCenter->nfoFilePath(episode), DataFileType::TvShowEpisodeNfo, false)
+                           << sideFile(mediaCenter->imageFileName(episode, ImageType::TvShowEpisodeThumb), DataFileType::TvShowEpisodeThumb,
+                                       episode->files().count() > 1);
+            m_snapshot << item;
         }
 
-        if (errorOccured)
-            m_renameErrorOccured = true;
-
-        if (!errorOccured && !dryRun) {
-            QStringList files;
-            foreach (const QString &file, newMovieFiles) {
-                QString f = newMovieFolder;
-                if (isBluRay || isDvd)
-                    f += "/" + parentDirName;
-                f += "/" + file;
-                files << f;
+        foreach (TvShow *show, m_shows) {
+            if (show->hasChanged()) {
+                ui->results->append(tr("<b>TV Show</b> \"%1\" has been edited but is not saved").arg(show->name()));
+                continue;
             }
-            movie->setFiles(files);
-            Manager::instance()->database()->update(movie);
+
+            RenamePlanner::Item item;
+            item.type = RenamePlanner::ItemShow;
+            item.objects << show;
+            item.label = tr("<b>TV Show</b> \"%1\"").arg(show->name());
+            item.dir = show->dir();
+            item.inSeparateFolder = true;
+            item.placeholders.insert("title", show->name());
+            item.placeholders.insert("showTitle", show->name());
+            item.placeholders.insert("year", show->firstAired().toString("yyyy"));
+            m_snapshot << item;
         }
     }
 }
 
-void Renamer::renameEpisodes(QList<TvShowEpisode *> episodes, const QString &filePattern, const QString &filePatternMulti, const QString &seasonPattern,
-                             const bool &renameFiles, const bool &useSeasonDirectories, const bool &dryRun)
+/**
+ * @brief Adds the stream details placeholders of an item to its snapshot
+ * @param item Snapshot of the item
+ * @param streamDetails Stream details of the item
+ */
+void Renamer::addStreamDetails(RenamePlanner::Item &item, StreamDetails *streamDetails)
 {
-    if (renameFiles && filePattern.isEmpty())
-        return;
-
-    QList<TvShowEpisode*> episodesRenamed;
-
-    foreach (TvShowEpisode *episode, episodes) {
-        if (episode->files().isEmpty() || (episode->files().count() > 1 && filePatternMulti.isEmpty()) ||
-                episodesRenamed.contains(episode))
-            continue;
-
-        if (episode->hasChanged()) {
-            ui->results->append(tr("<b>Episode</b> \"%1\" has been edited but is not saved").arg(episode->name()));
-            continue;
-        }
-
-        QList<TvShowEpisode*> multiEpisodes;
-        foreach (TvShowEpisode *subEpisode, episode->tvShow()->episodes()) {
-            if (subEpisode->files() == episode->files()) {
-                multiEpisodes.append(subEpisode);
-                episodesRenamed.append(subEpisode);
-            }
-        }
-
-        bool isBluRay = Helper::instance()->isBluRay(episode->files().at(0));
-        bool isDvd = Helper::instance()->isDvd(episode->files().at(0));
-        bool isDvdWithoutSub = Helper::instance()->isDvd(episode->files().at(0), true);
-        QFileInfo fi(episode->files().first());
-        QString fiCanonicalPath = fi.canonicalPath();
-        QStringList episodeFiles = episode->files();
-        QString nfo = Manager::instance()->mediaCenterInterface()->nfoFilePath(episode);
-        QString newNfoFileName = nfo;
-        QString thumbnail = Manager::instance()->mediaCenterInterface()->imageFileName(episode, ImageType::TvShowEpisodeThumb);
-        QString newThumbnailFileName = thumbnail;
-        QStringList newEpisodeFiles;
-        foreach (const QString &file, episode->files()) {
-            QFileInfo fi(file);
-            newEpisodeFiles << fi.fileName();
-        }
-
-
-        if (!isBluRay && !isDvd && !isDvdWithoutSub && renameFiles) {
-            qApp->processEvents();
-            QString newFileName;
-            episodeFiles.clear();
-
-            newEpisodeFiles.clear();
-            int partNo = 0;
-            foreach (const QString &file, episode->files()) {
-                newFileName = (episode->files().count() == 1) ? filePattern : filePatternMulti;
-                QFileInfo fi(file);
-                QString baseName = fi.completeBaseName();
-                QDir currentDir = fi.dir();
-                Renamer::replace(newFileName, "title", episode->name());
-                Renamer::replace(newFileName, "showTitle", episode->showTitle());
-                Renamer::replace(newFileName, "year", episode->firstAired().toString("yyyy"));
-                Renamer::replace(newFileName, "extension", fi.suffix());
-                Renamer::replace(newFileName, "season", episode->seasonString());
-                Renamer::replace(newFileName, "partNo", QString::number(++partNo));
-                Renamer::replace(newFileName, "videoCodec", episode->streamDetails()->videoCodec());
-                Renamer::replace(newFileName, "audioCodec", episode->streamDetails()->audioCodec());
-                Renamer::replace(newFileName, "channels", QString::number(episode->streamDetails()->audioChannels()));
-                Renamer::replace(newFileName, "resolution", Helper::instance()->matchResolution(episode->streamDetails()->videoDetails().value("width").toInt(),
-                                                                                                episode->streamDetails()->videoDetails().value("height").toInt(),
-                                                                                                episode->streamDetails()->videoDetails().value("scantype")));
-                Renamer::replaceCondition(newFileName, "3D", episode->streamDetails()->videoDetails().value("stereomode") != "");
-
-                if (multiEpisodes.count() > 1) {
-                    QStringList episodeStrings;
-                    foreach (TvShowEpisode *subEpisode, multiEpisodes)
-                        episodeStrings.append(subEpisode->episodeString());
-                    qSort(episodeStrings);
-                    Renamer::replace(newFileName, "episode", episodeStrings.join("-"));
-                } else {
-                    Renamer::replace(newFileName, "episode", episode->episodeString());
-                }
-
-                Helper::instance()->sanitizeFileName(newFileName);
-                if (fi.fileName() != newFileName) {
-                    int row = addResult(fi.fileName(), newFileName, OperationRename);
-                    if (!dryRun) {
-                        if (!rename(file, fi.canonicalPath() + "/" + newFileName)) {
-                            setResultStatus(row, RenameFailed);
-                            m_renameErrorOccured = true;
-                        } else {
-                            newEpisodeFiles << newFileName;
-                        }
-                    }
-
-                    QStringList filters;
-                    foreach (const QString &extra, m_extraFiles)
-                        filters << baseName + extra;
-                    foreach (const QString &subFileName, currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
-                        QString subSuffix = subFileName.mid(baseName.length());
-                        QString newBaseName = newFileName.left(newFileName.lastIndexOf("."));
-                        QString newSubName = newBaseName + subSuffix;
-                        int row = addResult(subFileName, newSubName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(currentDir.canonicalPath() + "/" + subFileName, currentDir.canonicalPath() + "/" + newSubName)) {
-                                setResultStatus(row, RenameFailed);
-                                m_renameErrorOccured = true;
-                            }
-                        }
-                    }
-                } else {
-                    newEpisodeFiles << fi.fileName();
-                }
-                episodeFiles << fi.canonicalPath() + "/" + newFileName;
-            }
-
-            // Rename nfo
-            if (!nfo.isEmpty()) {
-                QString nfoFileName = QFileInfo(nfo).fileName();
-                QList<DataFile> nfoFiles = Settings::instance()->dataFiles(DataFileType::TvShowEpisodeNfo);
-                if (!nfoFiles.isEmpty()) {
-                    newNfoFileName = nfoFiles.first().saveFileName(newFileName);
-                    Helper::instance()->sanitizeFileName(newNfoFileName);
-                    if (newNfoFileName != nfoFileName) {
-                        int row = addResult(nfoFileName, newNfoFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(nfo, fiCanonicalPath + "/" + newNfoFileName))
-                                setResultStatus(row, RenameFailed);
-                        }
-                    }
-                }
-            }
-
-            // Rename Thumbnail
-            if (!thumbnail.isEmpty()) {
-                QString thumbnailFileName = QFileInfo(thumbnail).fileName();
-                QList<DataFile> thumbnailFiles = Settings::instance()->dataFiles(DataFileType::TvShowEpisodeThumb);
-                if (!thumbnailFiles.isEmpty()) {
-                    newThumbnailFileName = thumbnailFiles.first().saveFileName(newFileName, -1, episode->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newThumbnailFileName);
-                    if (newThumbnailFileName != thumbnailFileName) {
-                        int row = addResult(thumbnailFileName, newThumbnailFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(thumbnail, fiCanonicalPath + "/" + newThumbnailFileName))
-                                setResultStatus(row, RenameFailed);
-                        }
-                    }
-                }
-            }
-        }
+    item.placeholders.insert("videoCodec", streamDetails->videoCodec());
+    item.placeholders.insert("audioCodec", streamDetails->audioCodec());
+    item.placeholders.insert("channels", QString::number(streamDetails->audioChannels()));
+    item.placeholders.insert("resolution", Helper::instance()->matchResolution(streamDetails->videoDetails().value("width").toInt(),
+                                                                               streamDetails->videoDetails().value("height").toInt(),
+                                                                               streamDetails->videoDetails().value("scantype")));
+    item.flagConditions.insert("3D", streamDetails->videoDetails().value("stereomode") != "");
+}
 
-        if (!dryRun) {
-            QStringList files;
-            foreach (const QString &file, newEpisodeFiles)
-                files << fi.path() + "/" + file;
-            episode->setFiles(files);
-            Manager::instance()->database()->update(episode);
-        }
+/**
+ * @brief Creates the snapshot of an nfo or image file
+ * @param path Current path of the file, empty if the item doesn't have it
+ * @param dataFileType Data file type which names the file
+ * @param stacked The item consists of several files
+ * @return Snapshot of the file
+ */
+RenamePlanner::SideFile Renamer::sideFile(const QString &path, int dataFileType, bool stacked)
+{
+    RenamePlanner::SideFile sideFile;
+    sideFile.path = path;
+    sideFile.dataFiles = Settings::instance()->dataFiles(dataFileType);
+    sideFile.stacked = stacked;
+    return sideFile;
+}
 
-        if (useSeasonDirectories) {
-            QDir showDir(episode->tvShow()->dir());
-            QString seasonDirName = seasonPattern;
-            Renamer::replace(seasonDirName, "season", episode->seasonString());
-            Helper::instance()->sanitizeFileName(seasonDirName);
-            QDir seasonDir(showDir.path() + "/" + seasonDirName);
-            if (!seasonDir.exists()) {
-                int row = addResult(seasonDirName, "", OperationCreateDir);
-                if (!dryRun) {
-                    if (!showDir.mkdir(seasonDirName))
-                        setResultStatus(row, RenameFailed);
-                }
-            }
+/**
+ * @brief Computes the plan from the snapshot, runs in the planner thread
+ */
+void Renamer::runPlanner()
+{
+    RenamePlanner planner(m_patterns);
+    RenamePlanner::Plan plan = planner.plan(m_snapshot);
 
-            if (isBluRay || isDvd || isDvdWithoutSub) {
-                QDir dir = fi.dir();
-                if (isDvd || isBluRay)
-                    dir.cdUp();
-
-                QDir parentDir = dir;
-                parentDir.cdUp();
-                if (parentDir != seasonDir) {
-                    int row = addResult(dir.dirName(), seasonDirName, OperationMove);
-                    if (!dryRun) {
-                        if (!rename(dir, seasonDir.absolutePath() + "/" + dir.dirName())) {
-                            setResultStatus(row, RenameFailed);
-                            m_renameErrorOccured = true;
-                        } else {
-                            newEpisodeFiles.clear();
-                            QString oldDir = dir.path();
-                            QString newDir = seasonDir.absolutePath() + "/" + dir.dirName();
-                            foreach (const QString &file, episode->files())
-                                newEpisodeFiles << newDir + file.mid(oldDir.length());
-                            episode->setFiles(newEpisodeFiles);
-                            Manager::instance()->database()->update(episode);
-                        }
-                    }
-                }
-            } else if (fi.dir() != seasonDir) {
-                newEpisodeFiles.clear();
-                foreach (const QString &fileName, episode->files()) {
-                    QFileInfo fi(fileName);
-                    int row = addResult(fi.fileName(), seasonDirName, OperationMove);
-                    if (!dryRun) {
-                        if (!rename(fileName, seasonDir.path() + "/" + fi.fileName())) {
-                            setResultStatus(row, RenameFailed);
-                            m_renameErrorOccured = true;
-                        } else {
-                            newEpisodeFiles << seasonDir.path() + "/" + fi.fileName();
-                        }
-                    }
-                }
-                if (!dryRun) {
-                    episode->setFiles(newEpisodeFiles);
-                    Manager::instance()->database()->update(episode);
-                }
-
-                if (!newNfoFileName.isEmpty() && !nfo.isEmpty()) {
-                    int row = addResult(newNfoFileName, seasonDirName, OperationMove);
-                    if (!dryRun) {
-                        if (!rename(fiCanonicalPath + "/" + newNfoFileName, seasonDir.path() + "/" + newNfoFileName))
-                            setResultStatus(row, RenameFailed);
-                    }
-                }
-                if (!thumbnail.isEmpty() && !newThumbnailFileName.isEmpty()) {
-                    int row = addResult(newThumbnailFileName, seasonDirName, OperationMove);
-                    if (!dryRun) {
-                        if (!rename(fiCanonicalPath + "/" + newThumbnailFileName, seasonDir.path() + "/" + newThumbnailFileName))
-                            setResultStatus(row, RenameFailed);
-                    }
-                }
-            }
-        }
-    }
+    QMutexLocker locker(&m_mutex);
+    m_plan = plan;
+    QMetaObject::invokeMethod(this, "onPlanned", Qt::QueuedConnection);
 }
 
-void Renamer::renameShows(QList<TvShow *> shows, const QString &directoryPattern, const bool &renameDirectories, const bool &dryRun)
+/**
+ * @brief Lists the planned operations, items which are already named correctly and conflicts.
+ *        Starts renaming if it was requested and there are no conflicts.
+ */
+void Renamer::onPlanned()
 {
-    if ((renameDirectories && directoryPattern.isEmpty()) || !renameDirectories)
+    m_snapshot.clear();
+    if (m_cancelRequested) {
+        ui->results->append("<span style=\"color:#ff0000;\"><b>" + tr("Cancelled") + "</b></span>");
+        finish();
+        ui->btnRename->setEnabled(true);
+        ui->btnDryRun->setEnabled(true);
         return;
+    }
 
-    foreach (TvShow *show, shows) {
-        if (show->hasChanged()) {
-            ui->results->append(tr("<b>TV Show</b> \"%1\" has been edited but is not saved").arg(show->name()));
-            continue;
-        }
-
-        QDir dir(show->dir());
-        QString newFolderName = directoryPattern;
-        Renamer::replace(newFolderName, "title", show->name());
-        Renamer::replace(newFolderName, "showTitle", show->name());
-        Renamer::replace(newFolderName, "year", show->firstAired().toString("yyyy"));
-        Helper::instance()->sanitizeFileName(newFolderName);
-        if (newFolderName != dir.dirName()) {
-            int row = addResult(dir.dirName(), newFolderName, OperationRename);
-            QDir parentDir(dir.path());
-            parentDir.cdUp();
-            if (!dryRun) {
-                if (!rename(dir, parentDir.path() + "/" + newFolderName)) {
-                    setResultStatus(row, RenameFailed);
-                    m_renameErrorOccured = true;
-                } else {
-                    QString newShowDir = parentDir.path() + "/" + newFolderName;
-                    QString oldShowDir = show->dir();
-                    show->setDir(newShowDir);
-                    Manager::instance()->database()->update(show);
-                    foreach (TvShowEpisode *episode, show->episodes()) {
-                        QStringList files;
-                        foreach (const QString &file, episode->files())
-                            files << newShowDir + file.mid(oldShowDir.length());
-                        episode->setFiles(files);
-                        Manager::instance()->database()->update(episode);
-                    }
-                }
-            }
+    int unchanged = 0;
+    for (int i=0, n=m_plan.items.count() ; i<n ; ++i) {
+        RenamePlanner::ItemPlan &plan = m_plan.items[i];
+        if (plan.steps.isEmpty() && !plan.objects.isEmpty())
+            unchanged++;
+        for (int j=0, m=plan.steps.count() ; j<m ; ++j) {
+            RenamePlanner::Step &step = plan.steps[j];
+            step.row = addResult(step.oldName, step.newName, step.operation);
         }
     }
-}
 
-void Renamer::renameConcerts(QList<Concert*> concerts, const QString &filePattern, const QString &filePatternMulti,
-                           const QString &directoryPattern, const bool &renameFiles, const bool &renameDirectories, const bool &dryRun)
-{
-    if ((renameFiles && filePattern.isEmpty()) || (renameDirectories && directoryPattern.isEmpty()))
+    if (unchanged > 0)
+        ui->results->append(tr("%n item(s) already named correctly, nothing to do", "", unchanged));
+    foreach (const QString &conflict, m_plan.conflicts)
+        ui->results->append(tr("<b>Conflict</b> \"%1\" already exists or is the target of another file").arg(conflict));
+
+    if (!m_renameAfterPlanning || !m_plan.conflicts.isEmpty()) {
+        if (m_renameAfterPlanning)
+            ui->results->append("<span style=\"color:#ff0000;\"><b>" + tr("Nothing has been renamed") + "</b></span>");
+        else
+            ui->results->append("<span style=\"color:#01a800;\"><b>" + tr("Finished") + "</b></span>");
+        finish();
+        ui->btnRename->setEnabled(true);
+        ui->btnDryRun->setEnabled(true);
         return;
+    }
 
-    foreach (Concert *concert, concerts) {
-        if (concert->files().isEmpty() || (concert->files().count() > 1 && filePatternMulti.isEmpty()))
-            continue;
-
-        if (concert->hasChanged()) {
-            ui->results->append(tr("<b>Concert</b> \"%1\" has been edited but is not saved").arg(concert->name()));
-            continue;
-        }
+    m_phase = 0;
+    startPhase();
+}
 
-        qApp->processEvents();
-        QFileInfo fi(concert->files().first());
-        QString fiCanonicalPath = fi.canonicalPath();
-        QDir dir(fi.canonicalPath());
-        QString newFolderName = directoryPattern;
-        QString newFileName;
-        QString nfo = Manager::instance()->mediaCenterInterface()->nfoFilePath(concert);
-        QString poster = Manager::instance()->mediaCenterInterface()->imageFileName(concert, ImageType::ConcertPoster);
-        QString fanart = Manager::instance()->mediaCenterInterface()->imageFileName(concert, ImageType::ConcertBackdrop);
-        QStringList newConcertFiles;
-        QString parentDirName;
-
-        bool errorOccured = false;
-
-        foreach (const QString &file, concert->files()) {
-            QFileInfo fi(file);
-            newConcertFiles.append(fi.fileName());
+/**
+ * @brief Queues the items of the current phase, each mount renames a few items at a time.
+ *        Phases without operations are skipped, after the last one the renamer is finished.
+ */
+void Renamer::startPhase()
+{
+    while (m_phase < RenamePlanner::PhaseCount) {
+        QMutexLocker locker(&m_mutex);
+        for (int i=0, n=m_plan.items.count() ; i<n ; ++i) {
+            const RenamePlanner::ItemPlan &plan = m_plan.items.at(i);
+            if (plan.phase != m_phase || plan.steps.isEmpty())
+                continue;
+            m_jobsPending++;
+            m_jobs.enqueue(plan.mount, new RenamerJob(this, i));
         }
+        if (m_jobsPending > 0)
+            return;
+        m_phase++;
+    }
 
-        QDir chkDir(fi.canonicalPath());
-        chkDir.cdUp();
-
-        bool isBluRay = Helper::instance()->isBluRay(chkDir.path());
-        bool isDvd = Helper::instance()->isDvd(chkDir.path());
+    ui->results->append("<span style=\"color:#01a800;\"><b>" + tr("Finished") + "</b></span>");
+    finish();
+}
 
-        if (isBluRay || isDvd) {
-            parentDirName = dir.dirName();
-            dir.cdUp();
+/**
+ * @brief Replays the planned operations of an item, runs in the job queue.
+ *        Every item has its own journal, if an operation fails the ones done so far are reverted.
+ * @param index Index of the item in the plan
+ */
+void Renamer::run(int index)
+{
+    const RenamePlanner::ItemPlan &plan = m_plan.items.at(index);
+    Result result;
+    result.index = index;
+    result.success = true;
+    result.reverted = true;
+
+    RenameJournal journal;
+    foreach (const RenamePlanner::Step &step, plan.steps) {
+        bool done = (step.operation == RenamePlanner::OperationCreateDir) ? createDir(step.target, journal)
+                                                                          : rename(step.source, step.target, journal);
+        if (!done) {
+            result.success = false;
+            result.failedRows << step.row;
+            break;
         }
+    }
+    if (!result.success)
+        result.reverted = journal.rollback();
 
-        if (!isBluRay && !isDvd && renameFiles) {
-            newConcertFiles.clear();
-            int partNo = 0;
-            foreach (const QString &file, concert->files()) {
-                newFileName = (concert->files().count() == 1) ? filePattern : filePatternMulti;
-                QFileInfo fi(file);
-                QString baseName = fi.completeBaseName();
-                QDir currentDir = fi.dir();
-
-                Renamer::replace(newFileName, "title", concert->name());
-                Renamer::replace(newFileName, "artist", concert->artist());
-                Renamer::replace(newFileName, "album", concert->album());
-                Renamer::replace(newFileName, "year", concert->released().toString("yyyy"));
-                Renamer::replace(newFileName, "extension", fi.suffix());
-                Renamer::replace(newFileName, "partNo", QString::number(++partNo));
-                Renamer::replace(newFileName, "videoCodec", concert->streamDetails()->videoCodec());
-                Renamer::replace(newFileName, "audioCodec", concert->streamDetails()->audioCodec());
-                Renamer::replace(newFileName, "channels", QString::number(concert->streamDetails()->audioChannels()));
-                Renamer::replace(newFileName, "resolution", Helper::instance()->matchResolution(concert->streamDetails()->videoDetails().value("width").toInt(),
-                                                                                                concert->streamDetails()->videoDetails().value("height").toInt(),
-                                                                                                concert->streamDetails()->videoDetails().value("scantype")));
-                Renamer::replaceCondition(newFileName, "3D", concert->streamDetails()->videoDetails().value("stereomode") != "");
-                Helper::instance()->sanitizeFileName(newFileName);
-                if (fi.fileName() != newFileName) {
-                    int row = addResult(fi.fileName(), newFileName, OperationRename);
-                    if (!dryRun) {
-                        if (!rename(file, fi.canonicalPath() + "/" + newFileName)) {
-                            setResultStatus(row, RenameFailed);
-                            errorOccured = true;
-                            continue;
-                        } else {
-                            newConcertFiles.append(newFileName);
-                        }
-                    }
-
-                    QStringList filters;
-                    foreach (const QString &extra, m_extraFiles)
-                        filters << baseName + extra;
-                    foreach (const QString &subFileName, currentDir.entryList(filters, QDir::Files | QDir::NoDotAndDotDot)) {
-                        QString subSuffix = subFileName.mid(baseName.length());
-                        QString newBaseName = newFileName.left(newFileName.lastIndexOf("."));
-                        QString newSubName = newBaseName + subSuffix;
-                        int row = addResult(subFileName, newSubName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(currentDir.canonicalPath() + "/" + subFileName, currentDir.canonicalPath() + "/" + newSubName))
-                                setResultStatus(row, RenameFailed);
-                        }
-                    }
-                } else {
-                    newConcertFiles.append(fi.fileName());
-                }
-            }
-
-            // Rename nfo
-            if (!nfo.isEmpty()) {
-                QString nfoFileName = QFileInfo(nfo).fileName();
-                QList<DataFile> nfoFiles = Settings::instance()->dataFiles(DataFileType::ConcertNfo);
-                if (!nfoFiles.isEmpty()) {
-                    QString newNfoFileName = nfoFiles.first().saveFileName(newFileName, -1, concert->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newNfoFileName);
-                    if (newNfoFileName != nfoFileName) {
-                        int row = addResult(nfoFileName, newNfoFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(nfo, fiCanonicalPath + "/" + newNfoFileName))
-                                setResultStatus(row, RenameFailed);
-                        }
-                    }
-                }
-            }
-
-            // Rename Poster
-            if (!poster.isEmpty()) {
-                QString posterFileName = QFileInfo(poster).fileName();
-                QList<DataFile> posterFiles = Settings::instance()->dataFiles(DataFileType::ConcertPoster);
-                if (!posterFiles.isEmpty()) {
-                    QString newPosterFileName = posterFiles.first().saveFileName(newFileName, -1, concert->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newPosterFileName);
-                    if (newPosterFileName != posterFileName) {
-                        int row = addResult(posterFileName, newPosterFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(poster, fiCanonicalPath + "/" + newPosterFileName))
-                                setResultStatus(row, RenameFailed);
-                        }
-                    }
-                }
-            }
+    QMutexLocker locker(&m_mutex);
+    m_jobs.finish(plan.mount);
+    m_results.enqueue(result);
+    QMetaObject::invokeMethod(this, "onItemsRenamed", Qt::QueuedConnection);
+}
 
-            // Rename Fanart
-            if (!fanart.isEmpty()) {
-                QString fanartFileName = QFileInfo(fanart).fileName();
-                QList<DataFile> fanartFiles = Settings::instance()->dataFiles(DataFileType::ConcertBackdrop);
-                if (!fanartFiles.isEmpty()) {
-                    QString newFanartFileName = fanartFiles.first().saveFileName(newFileName, -1, concert->files().count() > 1);
-                    Helper::instance()->sanitizeFileName(newFanartFileName);
-                    if (newFanartFileName != fanartFileName) {
-                        int row = addResult(fanartFileName, newFanartFileName, OperationRename);
-                        if (!dryRun) {
-                            if (!rename(fanart, fiCanonicalPath + "/" + newFanartFileName))
-                                setResultStatus(row, RenameFailed);
-                        }
-                    }
-                }
+/**
+ * @brief Applies renamed items, reports failed ones and starts the next phase when the current one is done
+ */
+void Renamer::onItemsRenamed()
+{
+    m_mutex.lock();
+    QQueue<Result> results = m_results;
+    m_results.clear();
+    m_mutex.unlock();
+
+    if (!results.isEmpty()) {
+        Manager::instance()->database()->transaction();
+        foreach (const Result &result, results) {
+            m_jobsPending--;
+            const RenamePlanner::ItemPlan &plan = m_plan.items.at(result.index);
+            if (result.success) {
+                apply(plan);
+                m_filesRenamed = true;
+                continue;
             }
+            m_renameErrorOccured = true;
+            foreach (int row, result.failedRows)
+                setResultStatus(row, RenameFailed);
+            if (result.reverted)
+                ui->results->append(tr("%1 could not be renamed, all changes have been reverted").arg(plan.label));
+            else
+                ui->results->append("<span style=\"color:#ff0000;\"><b>" + tr("%1 could not be renamed and not all changes could be reverted").arg(plan.label) + "</b></span>");
         }
+        Manager::instance()->database()->commit();
+    }
 
-        int renameRow = -1;
-        if (renameDirectories && concert->inSeparateFolder()) {
-            Renamer::replace(newFolderName, "title", concert->name());
-            Renamer::replace(newFolderName, "artist", concert->artist());
-            Renamer::replace(newFolderName, "album", concert->album());
-            Renamer::replace(newFolderName, "year", concert->released().toString("yyyy"));
-            Renamer::replaceCondition(newFolderName, "bluray", isBluRay);
-            Renamer::replaceCondition(newFolderName, "dvd", isDvd);
-            Renamer::replaceCondition(newFolderName, "3D", concert->streamDetails()->videoDetails().value("stereomode") != "");
-            Renamer::replace(newFolderName, "videoCodec", concert->streamDetails()->videoCodec());
-            Renamer::replace(newFolderName, "audioCodec", concert->streamDetails()->audioCodec());
-            Renamer::replace(newFolderName, "channels", QString::number(concert->streamDetails()->audioChannels()));
-            Renamer::replace(newFolderName, "resolution", Helper::instance()->matchResolution(concert->streamDetails()->videoDetails().value("width").toInt(),
-                                                                                              concert->streamDetails()->videoDetails().value("height").toInt(),
-                                                                                              concert->streamDetails()->videoDetails().value("scantype")));
-            Helper::instance()->sanitizeFileName(newFolderName);
-            if (dir.dirName() != newFolderName)
-                renameRow = addResult(dir.dirName(), newFolderName, OperationRename);
-        }
+    if (m_jobsPending > 0 || m_phase < 0)
+        return;
 
-        QString newConcertFolder = dir.path();
-        if (!dryRun && dir.dirName() != newFolderName && renameDirectories && concert->inSeparateFolder()) {
-            QDir parentDir(dir.path());
-            parentDir.cdUp();
-            if (!rename(dir, parentDir.path() + "/" + newFolderName)) {
-                setResultStatus(renameRow, RenameFailed);
-                errorOccured = true;
-            } else {
-                newConcertFolder = parentDir.path() + "/" + newFolderName;
-            }
-        }
+    if (m_cancelRequested) {
+        ui->results->append("<span style=\"color:#ff0000;\"><b>" + tr("Cancelled, the remaining items have not been renamed") + "</b></span>");
+        finish();
+        return;
+    }
 
-        if (errorOccured)
-            m_renameErrorOccured = true;
+    m_phase++;
+    startPhase();
+}
 
-        if (!errorOccured && !dryRun) {
-            QStringList files;
-            foreach (const QString &file, newConcertFiles) {
-                QString f = newConcertFolder;
-                if (isBluRay || isDvd)
-                    f += "/" + parentDirName;
-                f += "/" + file;
-                files << f;
+/**
+ * @brief Sets the new files of a renamed item and stores them in the database
+ * @param plan Plan of the item
+ */
+void Renamer::apply(const RenamePlanner::ItemPlan &plan)
+{
+    foreach (QObject *item, plan.objects) {
+        Movie *movie = qobject_cast<Movie*>(item);
+        Concert *concert = qobject_cast<Concert*>(item);
+        TvShowEpisode *episode = qobject_cast<TvShowEpisode*>(item);
+        TvShow *show = qobject_cast<TvShow*>(item);
+
+        if (movie) {
+            movie->setFiles(plan.newFiles);
+            QList<Subtitle*> subtitles = movie->subtitles();
+            QMapIterator<int, QStringList> it(plan.newSubtitleFiles);
+            while (it.hasNext()) {
+                it.next();
+                if (it.key() < subtitles.count())
+                    subtitles.at(it.key())->setFiles(it.value(), false);
             }
-            concert->setFiles(files);
+            Manager::instance()->database()->update(movie);
+        } else if (concert) {
+            concert->setFiles(plan.newFiles);
             Manager::instance()->database()->update(concert);
+        } else if (episode) {
+            episode->setFiles(plan.newFiles);
+            Manager::instance()->database()->update(episode);
+        } else if (show && !plan.newDir.isEmpty()) {
+            QString oldShowDir = show->dir();
+            show->setDir(plan.newDir);
+            Manager::instance()->database()->update(show);
+            foreach (TvShowEpisode *episode, show->episodes()) {
+                QStringList files;
+                foreach (const QString &file, episode->files())
+                    files << plan.newDir + file.mid(oldShowDir.length());
+                episode->setFiles(files);
+                Manager::instance()->database()->update(episode);
+            }
         }
     }
 }
 
-bool Renamer::rename(const QString &file, const QString &newName)
+/**
+ * @brief Ends planning or renaming
+ */
+void Renamer::finish()
 {
-    QFile f(file);
-    if (!f.exists())
-        return false;
+    m_phase = -1;
+    setRenaming(false);
+}
+
+/**
+ * @brief While planning or renaming, closing the dialog cancels the renamer.
+ *        Items which are renamed at that moment are finished, the others are left untouched.
+ * @param renaming Renaming is in progress
+ */
+void Renamer::setRenaming(bool renaming)
+{
+    m_renaming = renaming;
+    if (renaming)
+        m_cancelRequested = false;
+    ui->btnClose->setText(renaming ? tr("Cancel") : tr("Close"));
+}
 
-    QFile newFile(newName);
-    if (newFile.exists() && QString::compare(file, newName, Qt::CaseInsensitive) != 0)
+/**
+ * @brief Renames or moves a file or directory and records it in the journal of the item.
+ *        Names which only differ in case are renamed in two steps, other existing targets are never overwritten.
+ * @param file Current path
+ * @param newName New path
+ * @param journal Journal of the item
+ * @return True on success
+ */
+bool Renamer::rename(const QString &file, const QString &newName, RenameJournal &journal)
+{
+    if (!QFileInfo(file).exists())
         return false;
 
-    if (newFile.exists()) {
-        if (!f.rename(newName + ".tmp"))
+    QDir dir;
+    if (QString::compare(file, newName, Qt::CaseInsensitive) == 0) {
+        if (!dir.rename(file, file + ".tmp"))
             return false;
-        return f.rename(newName);
-    } else {
-        return f.rename(newName);
+        if (!dir.rename(file + ".tmp", newName)) {
+            dir.rename(file + ".tmp", file);
+            return false;
+        }
+    } else if (QFileInfo(newName).exists() || !dir.rename(file, newName)) {
+        return false;
     }
+    journal.addRename(file, newName);
+    return true;
 }
 
-bool Renamer::rename(QDir &dir, QString newName)
+/**
+ * @brief Creates a directory and records it in the journal of the item
+ * @param dir Path of the new directory
+ * @param journal Journal of the item
+ * @return True on success
+ */
+bool Renamer::createDir(const QString &dir, RenameJournal &journal)
 {
-    if (QString::compare(dir.path(), newName, Qt::CaseInsensitive) == 0) {
-        QDir tmpDir;
-        if (!tmpDir.rename(dir.path(), dir.path() + "tmp"))
-            return false;
-        return tmpDir.rename(dir.path() + "tmp", newName);
-    } else {
-        QDir tmpDir;
-        return tmpDir.rename(dir.path(), newName);
-    }
+    if (!QDir().mkdir(dir))
+        return false;
+    journal.addCreateDir(dir);
+    return true;
 }
 
 QString Renamer::replace(QString &text, const QString &search, const QString &replace)
@@ -1190,13 +737,13 @@ QString Renamer::replaceCondition(QString &text, const QString &condition, bool
     return text;
 }
 
-int Renamer::addResult(const QString &oldFileName, const QString &newFileName, RenameOperation operation)
+int Renamer::addResult(const QString &oldFileName, const QString &newFileName, RenamePlanner::Operation operation)
 {
     QString opString;
     switch (operation) {
-    case OperationCreateDir: opString = tr("Create dir"); break;
-    case OperationMove: opString = tr("Move"); break;
-    case OperationRename: opString = tr("Rename"); break;
+    case RenamePlanner::OperationCreateDir: opString = tr("Create dir"); break;
+    case RenamePlanner::OperationMove: opString = tr("Move"); break;
+    case RenamePlanner::OperationRename: opString = tr("Rename"); break;
     }
 
     QFont font = ui->resultsTable->font();
@@ -4,10 +4,18 @@
 #include <QDialog>
 #include <QDir>
 #include <QFile>
+#include <QMutex>
+#include <QQueue>
+#include <QSet>
+#include <QThreadPool>
 #include "data/Concert.h"
+#include "data/MountJobQueue.h"
 #include "data/TvShow.h"
 #include "data/TvShowEpisode.h"
 #include "movies/Movie.h"
+#include "renamer/RenamePlanner.h"
+
+class RenameJournal;
 
 namespace Ui {
 class Renamer;
@@ -24,9 +32,6 @@ public:
     enum RenameResult {
         RenameFailed, RenameSuccess
     };
-    enum RenameOperation {
-        OperationCreateDir, OperationMove, OperationRename
-    };
 
     explicit Renamer(QWidget *parent = 0);
     ~Renamer();
@@ -56,10 +61,21 @@ private slots:
     void onChkRenameFiles();
     void onChkUseSeasonDirectories();
     void onRenamed();
+    void onPlanned();
+    void onItemsRenamed();
 
 private:
     Ui::Renamer *ui;
 
+    struct Result {
+        int index;
+        bool success;
+        bool reverted;
+        QList<int> failedRows;
+    };
+    friend class RenamerPlanJob;
+    friend class RenamerJob;
+
     QList<Movie*> m_movies;
     QList<Concert*> m_concerts;
     QList<TvShow*> m_shows;
@@ -68,18 +84,32 @@ private:
     bool m_filesRenamed;
     QStringList m_extraFiles;
     bool m_renameErrorOccured;
+    bool m_renaming;
+    bool m_renameAfterPlanning;
+    bool m_cancelRequested;
+    QList<RenamePlanner::Item> m_snapshot;
+    RenamePlanner::Patterns m_patterns;
+    RenamePlanner::Plan m_plan;
+    QThreadPool m_planPool;
+    MountJobQueue m_jobs;
+    QMutex m_mutex;
+    QQueue<Result> m_results;
+    int m_phase;
+    int m_jobsPending;
 
-    void renameMovies(QList<Movie*> movies, const QString &filePattern, const QString &filePatternMulti,
-                      const QString &directoryPattern, const bool &renameFiles, const bool &renameDirectories, const bool &dryRun = false);
-    void renameConcerts(QList<Concert*> concerts, const QString &filePattern, const QString &filePatternMulti,
-                        const QString &directoryPattern, const bool &renameFiles, const bool &renameDirectories, const bool &dryRun = false);
-    void renameEpisodes(QList<TvShowEpisode*> episodes, const QString &filePattern, const QString &filePatternMulti, const QString &seasonPattern, const bool &renameFiles,
-                        const bool &useSeasonDirectories, const bool &dryRun = false);
-    void renameShows(QList<TvShow*> shows, const QString &directoryPattern, const bool &renameDirectories, const bool &dryRun = false);
-
-    bool rename(const QString &file, const QString &newName);
-    bool rename(QDir &dir, QString newName);
-    int addResult(const QString &oldFileName, const QString &newFileName, RenameOperation operation);
+    void startPlanning(bool rename);
+    void takeSnapshot();
+    void addStreamDetails(RenamePlanner::Item &item, StreamDetails *streamDetails);
+    RenamePlanner::SideFile sideFile(const QString &path, int dataFileType, bool stacked);
+    void runPlanner();
+    void startPhase();
+    void run(int index);
+    void apply(const RenamePlanner::ItemPlan &plan);
+    void finish();
+    static bool rename(const QString &file, const QString &newName, RenameJournal &journal);
+    static bool createDir(const QString &dir, RenameJournal &journal);
+    void setRenaming(bool renaming);
+    int addResult(const QString &oldFileName, const QString &newFileName, RenamePlanner::Operation operation);
     void setResultStatus(int row, RenameResult result);
 };
 
@@ -4,6 +4,7 @@
 #include <QGridLayout>
 #include <QRegExp>
 #include "data/Storage.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "main/MainWindow.h"
 
@@ -85,7 +86,7 @@ QList<int> AEBN::scraperNativelySupports()
 
 QNetworkAccessManager *AEBN::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 void AEBN::search(QString searchStr)
@@ -33,7 +33,6 @@ private slots:
     void onActorLoadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QList<int> m_scraperSupports;
     QString m_language;
     QWidget *m_widget;
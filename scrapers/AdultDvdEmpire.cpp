@@ -4,6 +4,7 @@
 #include <QRegExp>
 #include <QTextDocument>
 #include "data/Storage.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "settings/Settings.h"
 
@@ -52,7 +53,7 @@ QList<int> AdultDvdEmpire::scraperNativelySupports()
 
 QNetworkAccessManager *AdultDvdEmpire::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 void AdultDvdEmpire::search(QString searchStr)
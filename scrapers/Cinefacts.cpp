@@ -4,6 +4,7 @@
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "settings/Settings.h"
 
@@ -84,7 +85,7 @@ void Cinefacts::saveSettings(QSettings &settings)
  */
 QNetworkAccessManager *Cinefacts::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
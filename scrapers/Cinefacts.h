@@ -40,7 +40,6 @@ private slots:
     void backdropFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QList<int> m_scraperSupports;
 
     QNetworkAccessManager *qnam();
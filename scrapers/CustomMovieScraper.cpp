@@ -17,7 +17,7 @@ CustomMovieScraper::CustomMovieScraper(QObject *parent)
 
 QNetworkAccessManager *CustomMovieScraper::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 CustomMovieScraper *CustomMovieScraper::instance(QObject *parent)
@@ -37,7 +37,6 @@ signals:
 
 private:
     QList<ScraperInterface*> m_scrapers;
-    QNetworkAccessManager m_qnam;
 
     QList<ScraperInterface*> scrapersForInfos(QList<int> infos);
     ImageProviderInterface *imageProviderForInfo(int info);
@@ -5,6 +5,7 @@
 #include <QRegExp>
 #include "data/Storage.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "main/MainWindow.h"
 
@@ -51,7 +52,7 @@ QList<int> HotMovies::scraperNativelySupports()
 
 QNetworkAccessManager *HotMovies::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 void HotMovies::search(QString searchStr)
@@ -32,7 +32,6 @@ private slots:
     void onLoadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QList<int> m_scraperSupports;
 
     QNetworkAccessManager *qnam();
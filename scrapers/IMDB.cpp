@@ -5,6 +5,7 @@
 #include <QWidget>
 #include "data/Storage.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "settings/Settings.h"
 
@@ -30,7 +31,7 @@ IMDB::IMDB(QObject *parent)
 
 QNetworkAccessManager *IMDB::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 QString IMDB::name()
@@ -38,7 +38,6 @@ private:
     void parseAndAssignPoster(QString html, Movie *movie, QList<int> infos);
     QString parsePosters(QString html);
 
-    QNetworkAccessManager m_qnam;
     QList<int> m_scraperSupports;
 };
 
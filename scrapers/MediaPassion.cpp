@@ -150,7 +150,7 @@ bool MediaPassion::isAdult()
 
 QNetworkAccessManager *MediaPassion::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 void MediaPassion::search(QString searchStr)
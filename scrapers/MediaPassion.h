@@ -37,7 +37,6 @@ private slots:
     void onLoadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QString m_baseUrl;
     QWidget *m_widget;
     QString m_username;
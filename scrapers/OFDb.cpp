@@ -6,6 +6,7 @@
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "settings/Settings.h"
 
@@ -76,7 +77,7 @@ void OFDb::saveSettings(QSettings &settings)
  */
 QNetworkAccessManager *OFDb::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
@@ -35,7 +35,6 @@ private slots:
     void loadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QList<int> m_scraperSupports;
 
     QNetworkAccessManager *qnam();
@@ -11,6 +11,7 @@
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "main/MainWindow.h"
 #include "settings/Settings.h"
@@ -192,7 +193,7 @@ void TMDb::saveSettings(QSettings &settings)
  */
 QNetworkAccessManager *TMDb::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
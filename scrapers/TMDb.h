@@ -45,7 +45,6 @@ private slots:
     void setupFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QString m_language;
     QString m_language2;
     QString m_baseUrl;
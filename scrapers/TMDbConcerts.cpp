@@ -11,6 +11,7 @@
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "main/MainWindow.h"
 
@@ -148,7 +149,7 @@ void TMDbConcerts::saveSettings(QSettings &settings)
  */
 QNetworkAccessManager *TMDbConcerts::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
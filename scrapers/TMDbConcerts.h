@@ -40,7 +40,6 @@ private slots:
 
 private:
     QString m_apiKey;
-    QNetworkAccessManager m_qnam;
     QString m_language;
     QString m_language2;
     QString m_baseUrl;
@@ -87,7 +87,7 @@ QWidget *TheTvDb::settingsWidget()
  */
 QNetworkAccessManager *TheTvDb::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
@@ -57,7 +57,6 @@ private:
 
     QString m_apiKey;
     QString m_language;
-    QNetworkAccessManager m_qnam;
     QStringList m_xmlMirrors;
     QStringList m_bannerMirrors;
     QStringList m_zipMirrors;
@@ -13,6 +13,7 @@
 #include "../data/Storage.h"
 #include "../globals/NetworkReplyWatcher.h"
 #include "../main/MainWindow.h"
+#include "globals/Manager.h"
 
 UniversalMusicScraper::UniversalMusicScraper(QObject *parent)
 {
@@ -54,7 +55,7 @@ UniversalMusicScraper::UniversalMusicScraper(QObject *parent)
 
 QNetworkAccessManager *UniversalMusicScraper::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 QString UniversalMusicScraper::name()
@@ -47,7 +47,6 @@ private:
     };
 
     QString m_tadbApiKey;
-    QNetworkAccessManager m_qnam;
     QString m_language;
     QString m_prefer;
     QWidget *m_widget;
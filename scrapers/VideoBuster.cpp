@@ -3,6 +3,7 @@
 #include "data/Storage.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "globals/NetworkReplyWatcher.h"
 #include "settings/Settings.h"
 
@@ -36,7 +37,7 @@ VideoBuster::VideoBuster(QObject *parent)
  */
 QNetworkAccessManager *VideoBuster::qnam()
 {
-    return &m_qnam;
+    return Manager::networkAccessManager();
 }
 
 /**
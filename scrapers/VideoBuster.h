@@ -36,7 +36,6 @@ private slots:
     void loadFinished();
 
 private:
-    QNetworkAccessManager m_qnam;
     QList<int> m_scraperSupports;
 
     QNetworkAccessManager *qnam();
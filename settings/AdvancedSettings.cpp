@@ -22,6 +22,7 @@ void AdvancedSettings::reset()
 {
     m_debugLog = false;
     m_forceCache = false;
+    m_imageCacheSize = 500;
     m_bookletCut = 2;
     m_logFile = "";
     m_sortTokens = QStringList() << "Der" << "Die" << "Das" << "The" << "Le" << "La" << "Les" << "Un" << "Une" << "Des";
@@ -33,6 +34,29 @@ void AdvancedSettings::reset()
     m_countryMappings.clear();
     m_writeThumbUrlsToNfo = true;
     m_useFirstStudioOnly = false;
+    m_scanThreadsPerMount = 4;
+    m_movieDetailsCacheSize = 50;
+    m_mediaInfoThreadsPerMount = 4;
+    m_downloadConnections = 6;
+    m_downloadConnectionsPerHost = 2;
+    m_networkCacheSize = 200;
+    m_networkCacheTtls.clear();
+    m_networkCacheTtls.insert("api.themoviedb.org", 86400);
+    m_networkCacheTtls.insert("image.tmdb.org", 30*86400);
+    m_networkCacheTtls.insert("imdb.com", 86400);
+    m_networkCacheTtls.insert("media-imdb.com", 30*86400);
+    m_networkCacheTtls.insert("thetvdb.com", 86400);
+    m_networkCacheTtls.insert("webservice.fanart.tv", 86400);
+    m_networkCacheTtls.insert("assets.fanart.tv", 30*86400);
+    m_networkCacheTtls.insert("musicbrainz.org", 7*86400);
+    m_networkCacheTtls.insert("theaudiodb.com", 7*86400);
+    m_networkCacheTtls.insert("allmusic.com", 7*86400);
+    m_multiScrapeConcurrency = 4;
+    m_scraperRequestIntervals.clear();
+    m_scraperRequestIntervals.insert("tmdb", 1000);
+    m_scraperRequestIntervals.insert("imdb", 500);
+    m_scraperRequestIntervals.insert("tvdb", 250);
+    m_scraperRequestIntervals.insert("universalmusicscraper", 1000);
 
     m_movieFilters << "*.mkv" << "*.avi" << "*.mpg" << "*.mpeg" << "*.mp4" << "*.m2ts" << "*.disc" << "*.m4v" << "*.strm"
                    << "*.dat" << "*.flv" << "*.vob" << "*.ts" << "*.iso" << "*.ogg" << "*.ogm" << "*.rmvb" << "*.img" << "*.wmv"
@@ -99,6 +123,20 @@ void AdvancedSettings::loadSettings()
             m_writeThumbUrlsToNfo = (xml.readElementText() == "true");
         else if (xml.name() == "bookletCut")
             m_bookletCut = xml.readElementText().toInt();
+        else if (xml.name() == "scanThreadsPerMount")
+            m_scanThreadsPerMount = xml.readElementText().toInt();
+        else if (xml.name() == "movieDetailsCacheSize")
+            m_movieDetailsCacheSize = xml.readElementText().toInt();
+        else if (xml.name() == "mediaInfoThreadsPerMount")
+            m_mediaInfoThreadsPerMount = xml.readElementText().toInt();
+        else if (xml.name() == "downloadConnections")
+            m_downloadConnections = xml.readElementText().toInt();
+        else if (xml.name() == "downloadConnectionsPerHost")
+            m_downloadConnectionsPerHost = xml.readElementText().toInt();
+        else if (xml.name() == "networkCache")
+            loadNetworkCache(xml);
+        else if (xml.name() == "multiScrape")
+            loadMultiScrape(xml);
         else
             xml.skipCurrentElement();
     }
@@ -107,6 +145,7 @@ void AdvancedSettings::loadSettings()
     qDebug() << "    debugLog              " << m_debugLog;
     qDebug() << "    logFile               " << m_logFile;
     qDebug() << "    forceCache            " << m_forceCache;
+    qDebug() << "    imageCacheSize        " << m_imageCacheSize;
     qDebug() << "    sortTokens            " << m_sortTokens;
     qDebug() << "    genreMappings         " << m_genreMappings;
     qDebug() << "    movieFilters          " << m_movieFilters;
@@ -121,6 +160,15 @@ void AdvancedSettings::loadSettings()
     qDebug() << "    writeThumbUrlsToNfo   " << m_writeThumbUrlsToNfo;
     qDebug() << "    bookletCut            " << m_bookletCut;
     qDebug() << "    useFirstStudioOnly    " << m_useFirstStudioOnly;
+    qDebug() << "    scanThreadsPerMount   " << m_scanThreadsPerMount;
+    qDebug() << "    movieDetailsCacheSize " << m_movieDetailsCacheSize;
+    qDebug() << "    mediaInfoThreadsPerMount" << m_mediaInfoThreadsPerMount;
+    qDebug() << "    downloadConnections   " << m_downloadConnections;
+    qDebug() << "    downloadConnectionsPerHost" << m_downloadConnectionsPerHost;
+    qDebug() << "    networkCacheSize      " << m_networkCacheSize;
+    qDebug() << "    networkCacheTtls      " << m_networkCacheTtls;
+    qDebug() << "    multiScrapeConcurrency" << m_multiScrapeConcurrency;
+    qDebug() << "    scraperRequestIntervals" << m_scraperRequestIntervals;
 }
 
 void AdvancedSettings::loadLog(QXmlStreamReader &xml)
@@ -140,11 +188,45 @@ void AdvancedSettings::loadGui(QXmlStreamReader &xml)
     while (xml.readNextStartElement()) {
         if (xml.name() == "forceCache")
             m_forceCache = (xml.readElementText() == "true");
+        else if (xml.name() == "imageCacheSize")
+            m_imageCacheSize = xml.readElementText().toInt();
         else
             xml.skipCurrentElement();
     }
 }
 
+void AdvancedSettings::loadNetworkCache(QXmlStreamReader &xml)
+{
+    while (xml.readNextStartElement()) {
+        if (xml.name() == "size") {
+            m_networkCacheSize = xml.readElementText().toInt();
+        } else if (xml.name() == "ttl") {
+            QString host = xml.attributes().value("host").toString();
+            int ttl = xml.readElementText().toInt();
+            if (!host.isEmpty())
+                m_networkCacheTtls.insert(host, ttl);
+        } else {
+            xml.skipCurrentElement();
+        }
+    }
+}
+
+void AdvancedSettings::loadMultiScrape(QXmlStreamReader &xml)
+{
+    while (xml.readNextStartElement()) {
+        if (xml.name() == "concurrency") {
+            m_multiScrapeConcurrency = xml.readElementText().toInt();
+        } else if (xml.name() == "requestInterval") {
+            QString scraper = xml.attributes().value("scraper").toString();
+            int interval = xml.readElementText().toInt();
+            if (!scraper.isEmpty())
+                m_scraperRequestIntervals.insert(scraper, interval);
+        } else {
+            xml.skipCurrentElement();
+        }
+    }
+}
+
 void AdvancedSettings::loadSortTokens(QXmlStreamReader &xml)
 {
     m_sortTokens.clear();
@@ -332,6 +414,15 @@ bool AdvancedSettings::forceCache() const
     return m_forceCache;
 }
 
+/**
+ * @brief Size budget of the image cache in MB, least recently used images are removed when it's exceeded
+ * @return Size in MB
+ */
+int AdvancedSettings::imageCacheSize() const
+{
+    return m_imageCacheSize;
+}
+
 bool AdvancedSettings::portableMode() const
 {
 #ifdef Q_OS_WIN
@@ -355,3 +446,73 @@ bool AdvancedSettings::useFirstStudioOnly() const
 {
     return m_useFirstStudioOnly;
 }
+
+int AdvancedSettings::scanThreadsPerMount() const
+{
+    return m_scanThreadsPerMount;
+}
+
+int AdvancedSettings::movieDetailsCacheSize() const
+{
+    return m_movieDetailsCacheSize;
+}
+
+int AdvancedSettings::mediaInfoThreadsPerMount() const
+{
+    return m_mediaInfoThreadsPerMount;
+}
+
+/**
+ * @brief Number of images a download manager loads at the same time
+ * @return Number of concurrent downloads, 1 downloads one after another
+ */
+int AdvancedSettings::downloadConnections() const
+{
+    return m_downloadConnections;
+}
+
+/**
+ * @brief Number of images a download manager loads from the same host at the same time
+ * @return Number of concurrent downloads per host
+ */
+int AdvancedSettings::downloadConnectionsPerHost() const
+{
+    return m_downloadConnectionsPerHost;
+}
+
+/**
+ * @brief Size of the disk cache of the scrapers and image providers
+ * @return Size in megabytes
+ */
+int AdvancedSettings::networkCacheSize() const
+{
+    return m_networkCacheSize;
+}
+
+/**
+ * @brief Time responses of a host are taken from the network cache without asking the server
+ * Hosts match their subdomains too. Hosts without a ttl are cached as their responses allow it.
+ * @return Ttl in seconds by host
+ */
+QHash<QString, int> AdvancedSettings::networkCacheTtls() const
+{
+    return m_networkCacheTtls;
+}
+
+/**
+ * @brief Number of items a multi scrape loads at the same time
+ * @return Number of items, 1 scrapes one after another
+ */
+int AdvancedSettings::multiScrapeConcurrency() const
+{
+    return m_multiScrapeConcurrency;
+}
+
+/**
+ * @brief Minimum time between two searches or loads a multi scrape starts at a scraper
+ * @return Interval in milliseconds by scraper identifier
+ */
+QHash<QString, int> AdvancedSettings::scraperRequestIntervals() const
+{
+    return m_scraperRequestIntervals;
+}
@@ -29,9 +29,19 @@ public:
     QHash<QString, QString> countryMappings() const;
     bool useFirstStudioOnly() const;
     bool forceCache() const;
+    int imageCacheSize() const;
     bool portableMode() const;
     int bookletCut() const;
     bool writeThumbUrlsToNfo() const;
+    int scanThreadsPerMount() const;
+    int movieDetailsCacheSize() const;
+    int mediaInfoThreadsPerMount() const;
+    int downloadConnections() const;
+    int downloadConnectionsPerHost() const;
+    int networkCacheSize() const;
+    QHash<QString, int> networkCacheTtls() const;
+    int multiScrapeConcurrency() const;
+    QHash<QString, int> scraperRequestIntervals() const;
 
 private:
     bool m_debugLog;
@@ -48,15 +58,27 @@ private:
     QHash<QString, QString> m_studioMappings;
     QHash<QString, QString> m_countryMappings;
     bool m_forceCache;
+    int m_imageCacheSize;
     bool m_portableMode;
     int m_bookletCut;
     bool m_writeThumbUrlsToNfo;
     bool m_useFirstStudioOnly;
+    int m_scanThreadsPerMount;
+    int m_movieDetailsCacheSize;
+    int m_mediaInfoThreadsPerMount;
+    int m_downloadConnections;
+    int m_downloadConnectionsPerHost;
+    int m_networkCacheSize;
+    QHash<QString, int> m_networkCacheTtls;
+    int m_multiScrapeConcurrency;
+    QHash<QString, int> m_scraperRequestIntervals;
 
     void loadSettings();
     void reset();
     void loadLog(QXmlStreamReader &xml);
     void loadGui(QXmlStreamReader &xml);
+    void loadNetworkCache(QXmlStreamReader &xml);
+    void loadMultiScrape(QXmlStreamReader &xml);
     void loadSortTokens(QXmlStreamReader &xml);
     void loadGenreMappings(QXmlStreamReader &xml);
     void loadFilters(QXmlStreamReader &xml);
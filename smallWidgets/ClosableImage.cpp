@@ -21,6 +21,9 @@ ClosableImage::ClosableImage(QWidget *parent) :
     QLabel(parent)
 {
     setMouseTracking(true);
+    m_imageType = -1;
+    m_requestedWidth = 0;
+    m_loadFailed = false;
     m_showZoomAndResolution = true;
     m_showCapture = false;
     m_scaleTo = Qt::Horizontal;
@@ -57,6 +60,8 @@ ClosableImage::ClosableImage(QWidget *parent) :
     m_capture = m_capture.scaledToWidth(16 * Helper::instance()->devicePixelRatio(this), Qt::SmoothTransformation);
 
     setAcceptDrops(true);
+
+    connect(ImageCache::instance(), SIGNAL(sigImageLoaded(QString,int,int,QImage,QSize)), this, SLOT(onImageLoaded(QString,int,int,QImage,QSize)));
 }
 
 void ClosableImage::mousePressEvent(QMouseEvent *ev)
@@ -144,12 +149,22 @@ void ClosableImage::paintEvent(QPaintEvent *event)
     int origWidth;
     int origHeight;
     if (!m_image.isNull()) {
-        img = QImage::fromData(m_image);
-        origWidth = img.width();
-        origHeight = img.height();
-        img = img.scaledToWidth((width()-9)*Helper::instance()->devicePixelRatio(this), Qt::SmoothTransformation);
-    } else if (!m_imagePath.isEmpty()) {
-        img = ImageCache::instance()->image(m_imagePath, (width()-9)*Helper::instance()->devicePixelRatio(this), 0, origWidth, origHeight);
+        QSize origSize;
+        img = Helper::instance()->getImage(m_image, (width()-9)*Helper::instance()->devicePixelRatio(this), 0, &origSize);
+        origWidth = origSize.width();
+        origHeight = origSize.height();
+    } else if (!m_imagePath.isEmpty() && !m_loadFailed) {
+        // The image is scaled in the background, until it's there the previous one (if any) is shown
+        int scaledWidth = (width()-9)*Helper::instance()->devicePixelRatio(this);
+        if (m_requestedWidth != scaledWidth) {
+            m_requestedWidth = scaledWidth;
+            ImageCache::instance()->requestImage(m_imagePath, scaledWidth, 0, m_imageType);
+        }
+        if (m_scaledImage.isNull())
+            return;
+        img = m_scaledImage;
+        origWidth = m_origSize.width();
+        origHeight = m_origSize.height();
     } else {
         int x = (width() - (m_defaultPixmap.width() / Helper::instance()->devicePixelRatio(m_defaultPixmap))) / 2;
         int y = (height() - (m_defaultPixmap.height() / Helper::instance()->devicePixelRatio(m_defaultPixmap))) / 2;
@@ -215,9 +230,9 @@ void ClosableImage::setMyData(const QVariant &data)
 void ClosableImage::setImage(const QByteArray &image)
 {
     clear();
-    QImage img = QImage::fromData(image);
+    QSize size = Helper::instance()->imageSize(image);
     m_image = image;
-    updateSize(img.width(), img.height());
+    updateSize(size.width(), size.height());
 }
 
 void ClosableImage::setImage(const QString &image)
@@ -229,8 +244,29 @@ void ClosableImage::setImageByPath(const QString &image)
 {
     clear();
     m_imagePath = image;
-    QSize size = ImageCache::instance()->imageSize(image);
-    updateSize(size.width(), size.height());
+    m_origSize = ImageCache::instance()->cachedImageSize(image);
+    if (m_origSize.isValid())
+        updateSize(m_origSize.width(), m_origSize.height());
+    else
+        updateSize(0, 0);
+}
+
+void ClosableImage::onImageLoaded(QString path, int width, int height, QImage image, QSize origSize)
+{
+    if (path != m_imagePath || width != m_requestedWidth || height != 0)
+        return;
+    if (image.isNull()) {
+        // Show the default pixmap instead of an empty widget
+        m_loadFailed = true;
+        update();
+        return;
+    }
+    bool sizeKnown = m_origSize.isValid();
+    m_scaledImage = image;
+    m_origSize = origSize;
+    if (!sizeKnown)
+        updateSize(origSize.width(), origSize.height());
+    update();
 }
 
 void ClosableImage::updateSize(int imageWidth, int imageHeight)
@@ -337,6 +373,10 @@ void ClosableImage::clear()
     if (m_anim)
         m_anim->stop();
     m_imagePath.clear();
+    m_scaledImage = QImage();
+    m_origSize = QSize();
+    m_requestedWidth = 0;
+    m_loadFailed = false;
     m_image = QByteArray();
     m_pixmap = m_emptyPixmap;
     m_loading = false;
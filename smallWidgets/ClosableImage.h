@@ -1,6 +1,7 @@
 #ifndef CLOSABLEIMAGE_H
 #define CLOSABLEIMAGE_H
 
+#include <QImage>
 #include <QLabel>
 #include <QPaintEvent>
 #include <QMouseEvent>
@@ -59,11 +60,16 @@ protected:
 
 private slots:
     void closed();
+    void onImageLoaded(QString path, int width, int height, QImage image, QSize origSize);
 
 private:
     QVariant m_myData;
     QByteArray m_image;
     QString m_imagePath;
+    QImage m_scaledImage;
+    QSize m_origSize;
+    int m_requestedWidth;
+    bool m_loadFailed;
     QPixmap m_pixmap;
     QPixmap m_defaultPixmap;
     int m_mySize;
@@ -28,6 +28,8 @@ FilterWidget::FilterWidget(QWidget *parent) :
     m_list->setAttribute(Qt::WA_MacShowFocusRect, false);
 
     m_activeWidget = WidgetMovies;
+    m_movieFacetsRevision = -1;
+    m_concertFacetsRevision = -1;
 
     QPalette palette = m_list->palette();
     palette.setColor(QPalette::Highlight, palette.color(QPalette::Highlight));
@@ -138,6 +140,12 @@ void FilterWidget::onFilterTextChanged(QString text)
             filter->setShortText(text);
         }
 
+        if ((filter->info() == MovieFilters::FullText || filter->info() == ConcertFilters::FullText)
+            && !m_activeFilters.contains(filter)) {
+            filter->setText(tr("Any field contains \"%1\"").arg(text));
+            filter->setShortText(text);
+        }
+
         if ((filter->info() == MovieFilters::ImdbId && filter->hasInfo())
             && !m_activeFilters.contains(filter)) {
             filter->setText(tr("IMDB ID \"%1\"").arg(text));
@@ -257,52 +265,11 @@ void FilterWidget::setupFilters()
 
 /**
  * @brief Sets up movie filters
+ *        The values of the facets are taken from the counts kept by the movie model,
+ *        the filters are only rebuilt if the counts have changed since the last call.
  */
 void FilterWidget::setupMovieFilters()
 {
-    QStringList years;
-    QStringList genres;
-    QStringList certifications;
-    QStringList studios;
-    QStringList countries;
-    QStringList tags;
-    QStringList directors;
-    QStringList sets;
-    foreach (Movie *movie, Manager::instance()->movieModel()->movies()) {
-        foreach (const QString &genre, movie->genres()) {
-            if (!genre.isEmpty() && !genres.contains(genre))
-                genres.append(genre);
-        }
-        foreach (const QString &studio, movie->studios()) {
-            if (!studio.isEmpty() && !studios.contains(studio))
-                studios.append(studio);
-        }
-        foreach (const QString &country, movie->countries()) {
-            if (!country.isEmpty() && !countries.contains(country))
-                countries.append(country);
-        }
-        foreach (const QString &tag, movie->tags()) {
-            if (!tag.isEmpty() && !tags.contains(tag))
-                tags.append(tag);
-        }
-        if (!directors.contains(movie->director()))
-            directors.append(movie->director());
-        if (movie->released().isValid() && !years.contains(QString("%1").arg(movie->released().year())))
-            years.append(QString("%1").arg(movie->released().year()));
-        if (!movie->certification().isEmpty() && !certifications.contains(movie->certification()))
-            certifications.append(movie->certification());
-        if (!movie->set().isEmpty() && !sets.contains(movie->set()))
-            sets.append(movie->set());
-    }
-    qSort(certifications.begin(), certifications.end(), LocaleStringCompare());
-    qSort(genres.begin(), genres.end(), LocaleStringCompare());
-    qSort(years.begin(), years.end(), LocaleStringCompare());
-    qSort(studios.begin(), studios.end(), LocaleStringCompare());
-    qSort(countries.begin(), countries.end(), LocaleStringCompare());
-    qSort(tags.begin(), tags.end(), LocaleStringCompare());
-    qSort(directors.begin(), directors.end(), LocaleStringCompare());
-    qSort(sets.begin(), sets.end(), LocaleStringCompare());
-
     if (m_movieLabelFilters.isEmpty()) {
         QMapIterator<int, QString> it(Helper::instance()->labels());
         while (it.hasNext()) {
@@ -312,196 +279,19 @@ void FilterWidget::setupMovieFilters()
         }
     }
 
-    // Clear out all filters which doesn't exist
-    foreach (Filter *filter, m_movieGenreFilters) {
-        if (!genres.contains(filter->shortText())) {
-            m_movieGenreFilters.removeOne(filter);
-            delete filter;
-        }
-    }
-    foreach (Filter *filter, m_movieCertificationFilters) {
-        if (!certifications.contains(filter->shortText())) {
-            m_movieCertificationFilters.removeOne(filter);
-            delete filter;
-        }
-    }
-    foreach (Filter *filter, m_movieYearFilters) {
-        if (!years.contains(filter->shortText())) {
-            m_movieYearFilters.removeOne(filter);
-            delete filter;
-        }
-    }
-    foreach (Filter *filter, m_movieStudioFilters) {
-        if (!studios.contains(filter->shortText())) {
-            m_movieStudioFilters.removeOne(filter);
-            delete filter;
-        }
-    }
-    foreach (Filter *filter, m_movieCountryFilters) {
-        if (!countries.contains(filter->shortText())) {
-            m_movieCountryFilters.removeOne(filter);
-            delete filter;
-        }
-    }
-    foreach (Filter *filter, m_movieDirectorFilters) {
-        if (!directors.contains(filter->shortText())) {
-            m_movieDirectorFilters.removeOne(filter);
-            delete filter;
-        }
-    }
-    foreach (Filter *filter, m_movieTagsFilters) {
-        if (!tags.contains(filter->shortText())) {
-            m_movieTagsFilters.removeOne(filter);
-            delete filter;
-        }
-    }
-    foreach (Filter *filter, m_movieSetsFilters) {
-        if (!tags.contains(filter->shortText())) {
-            m_movieSetsFilters.removeOne(filter);
-            delete filter;
-        }
+    const FacetCounts *facets = Manager::instance()->movieModel()->facets();
+    if (m_movieFacetsRevision != facets->revision()) {
+        m_movieFacetsRevision = facets->revision();
+        updateFacetFilters(m_movieGenreFilters, facets->counts(MovieFilters::Genres), MovieFilters::Genres, tr("Genre \"%1\""), tr("Genre"));
+        updateFacetFilters(m_movieStudioFilters, facets->counts(MovieFilters::Studio), MovieFilters::Studio, tr("Studio \"%1\""), tr("Studio"));
+        updateFacetFilters(m_movieCountryFilters, facets->counts(MovieFilters::Country), MovieFilters::Country, tr("Country \"%1\""), tr("Country"));
+        updateFacetFilters(m_movieYearFilters, facets->counts(MovieFilters::Released), MovieFilters::Released, tr("Released %1"), tr("Year"));
+        updateFacetFilters(m_movieCertificationFilters, facets->counts(MovieFilters::Certification), MovieFilters::Certification, tr("Certification \"%1\""), tr("Certification"));
+        updateFacetFilters(m_movieSetsFilters, facets->counts(MovieFilters::Set), MovieFilters::Set, tr("Set \"%1\""), tr("Set"));
+        updateFacetFilters(m_movieTagsFilters, facets->counts(MovieFilters::Tags), MovieFilters::Tags, tr("Tag \"%1\""), tr("Tag"));
+        updateFacetFilters(m_movieDirectorFilters, facets->counts(MovieFilters::Director), MovieFilters::Director, tr("Director \"%1\""), tr("Director"));
     }
 
-    QList<Filter*> genreFilters;
-    // Add new filters
-    foreach (const QString &genre, genres) {
-        Filter *f = 0;
-        foreach (Filter *filter, m_movieGenreFilters) {
-            if (filter->shortText() == genre) {
-                f = filter;
-                break;
-            }
-        }
-        if (f)
-            genreFilters << f;
-        else
-            genreFilters << new Filter(tr("Genre \"%1\"").arg(genre), genre,
-                                       QStringList() << tr("Genre") << genre, MovieFilters::Genres, true);
-    }
-    m_movieGenreFilters = genreFilters;
-
-    QList<Filter*> studioFilters;
-    // Add new filters
-    foreach (const QString &studio, studios) {
-        Filter *f = 0;
-        foreach (Filter *filter, m_movieStudioFilters) {
-            if (filter->shortText() == studio) {
-                f = filter;
-                break;
-            }
-        }
-        if (f)
-            studioFilters << f;
-        else
-            studioFilters << new Filter(tr("Studio \"%1\"").arg(studio), studio,
-                                       QStringList() << tr("Studio") << studio, MovieFilters::Studio, true);
-    }
-    m_movieStudioFilters = studioFilters;
-
-    QList<Filter*> countryFilters;
-    // Add new filters
-    foreach (const QString &country, countries) {
-        Filter *f = 0;
-        foreach (Filter *filter, m_movieCountryFilters) {
-            if (filter->shortText() == country) {
-                f = filter;
-                break;
-            }
-        }
-        if (f)
-            countryFilters << f;
-        else
-            countryFilters << new Filter(tr("Country \"%1\"").arg(country), country,
-                                       QStringList() << tr("Country") << country, MovieFilters::Country, true);
-    }
-    m_movieCountryFilters = countryFilters;
-
-    QList<Filter*> yearFilters;
-    foreach (const QString &year, years) {
-        Filter *f = 0;
-        foreach (Filter *filter, m_movieYearFilters) {
-            if (filter->shortText() == year) {
-                f = filter;
-                break;
-            }
-        }
-        if (f)
-            yearFilters << f;
-        else
-            yearFilters << new Filter(tr("Released %1").arg(year), year,
-                                      QStringList() << tr("Year") << year, MovieFilters::Released, true);
-    }
-    m_movieYearFilters = yearFilters;
-
-    QList<Filter*> certificationFilters;
-    foreach (const QString &certification, certifications) {
-        Filter *f = 0;
-        foreach (Filter *filter, m_movieCertificationFilters) {
-            if (filter->shortText() == certification) {
-                f = filter;
-                break;
-            }
-        }
-        if (f)
-            certificationFilters << f;
-        else
-            certificationFilters << new Filter(tr("Certification \"%1\"").arg(certification), certification,
-                                               QStringList() << tr("Certification") << certification, MovieFilters::Certification, true);
-    }
-    m_movieCertificationFilters = certificationFilters;
-
-    QList<Filter*> setsFilters;
-    foreach (const QString &set, sets) {
-        Filter *f = 0;
-        foreach (Filter *filter, m_movieSetsFilters) {
-            if (filter->shortText() == set) {
-                f = filter;
-                break;
-            }
-        }
-        if (f)
-            setsFilters << f;
-        else
-            setsFilters << new Filter(tr("Set \"%1\"").arg(set), set,
-                                               QStringList() << tr("Set") << set, MovieFilters::Set, true);
-    }
-    m_movieSetsFilters = setsFilters;
-
-    QList<Filter*> tagsFilters;
-    foreach (const QString &tag, tags) {
-        Filter *f = 0;
-        foreach (Filter *filter, m_movieTagsFilters) {
-            if (filter->shortText() == tag) {
-                f = filter;
-                break;
-            }
-        }
-        if (f)
-            tagsFilters << f;
-        else
-            tagsFilters << new Filter(tr("Tag \"%1\"").arg(tag), tag,
-                                      QStringList() << tr("Tag") << tag, MovieFilters::Tags, true);
-    }
-    m_movieTagsFilters = tagsFilters;
-
-    QList<Filter*> directorFilters;
-    foreach (const QString &director, directors) {
-        Filter *f = 0;
-        foreach (Filter *filter, m_movieDirectorFilters) {
-            if (filter->shortText() == director) {
-                f = filter;
-                break;
-            }
-        }
-        if (f)
-            directorFilters << f;
-        else
-            directorFilters << new Filter(tr("Director \"%1\"").arg(director), director,
-                                      QStringList() << tr("Director") << director, MovieFilters::Director, true);
-    }
-    m_movieDirectorFilters = directorFilters;
-
-
     QList<Filter*> filters;
     filters << m_movieFilters
             << m_movieGenreFilters
@@ -516,6 +306,35 @@ void FilterWidget::setupMovieFilters()
     m_filters = filters;
 }
 
+/**
+ * @brief Updates the filters of a facet, the number of items is shown next to each value
+ * @param filters Filters of the facet, filters of values no item has anymore are deleted
+ * @param counts Number of items per value
+ * @param info Filter type
+ * @param text Text of a filter, %1 is replaced by the value
+ * @param name Name of the facet the filters respond to
+ */
+void FilterWidget::updateFacetFilters(QList<Filter*> &filters, const QHash<QString, int> &counts, int info, const QString &text, const QString &name)
+{
+    QHash<QString, Filter*> oldFilters;
+    foreach (Filter *filter, filters)
+        oldFilters.insert(filter->shortText(), filter);
+
+    QStringList values = counts.keys();
+    qSort(values.begin(), values.end(), LocaleStringCompare());
+
+    QList<Filter*> facetFilters;
+    foreach (const QString &value, values) {
+        Filter *filter = oldFilters.take(value);
+        if (!filter)
+            filter = new Filter("", value, QStringList() << name << value, info, true);
+        filter->setText(QString("%1 (%2)").arg(text.arg(value), QString::number(counts.value(value))));
+        facetFilters << filter;
+    }
+    qDeleteAll(oldFilters);
+    filters = facetFilters;
+}
+
 /**
  * @brief Sets up tv show filters
  */
@@ -529,7 +348,18 @@ void FilterWidget::setupTvShowFilters()
  */
 void FilterWidget::setupConcertFilters()
 {
-    m_filters = m_concertFilters;
+    const FacetCounts *facets = Manager::instance()->concertModel()->facets();
+    if (m_concertFacetsRevision != facets->revision()) {
+        m_concertFacetsRevision = facets->revision();
+        updateFacetFilters(m_concertGenreFilters, facets->counts(ConcertFilters::Genres), ConcertFilters::Genres, tr("Genre \"%1\""), tr("Genre"));
+        updateFacetFilters(m_concertTagsFilters, facets->counts(ConcertFilters::Tags), ConcertFilters::Tags, tr("Tag \"%1\""), tr("Tag"));
+    }
+
+    QList<Filter*> filters;
+    filters << m_concertFilters
+            << m_concertGenreFilters
+            << m_concertTagsFilters;
+    m_filters = filters;
 }
 
 void FilterWidget::setupMusicFilters()
@@ -544,6 +374,7 @@ void FilterWidget::initFilters()
 {
     m_movieFilters << new Filter(tr("Title"), "", QStringList(), MovieFilters::Title, true);
     m_movieFilters << new Filter(tr("Filename"), "", QStringList(), MovieFilters::Path, true);
+    m_movieFilters << new Filter(tr("Any field"), "", QStringList(), MovieFilters::FullText, true);
     m_movieFilters << new Filter(tr("IMDB ID"), "", QStringList(), MovieFilters::ImdbId, true);
 
     m_movieFilters << new Filter(tr("Movie has Poster"), tr("Poster"),
@@ -689,6 +520,7 @@ void FilterWidget::initFilters()
     m_tvShowFilters << new Filter(tr("Title"), "", QStringList(), TvShowFilters::Title, true);
 
     m_concertFilters << new Filter(tr("Title"), "", QStringList(), ConcertFilters::Title, true);
+    m_concertFilters << new Filter(tr("Any field"), "", QStringList(), ConcertFilters::FullText, true);
 
     m_musicFilters << new Filter(tr("Title"), "", QStringList(), MusicFilters::Title, true);
 }
@@ -740,6 +572,10 @@ void FilterWidget::loadFilters(MainWidgets widget)
             continue;
         if (m_concertFilters.contains(filter))
             continue;
+        if (m_concertGenreFilters.contains(filter))
+            continue;
+        if (m_concertTagsFilters.contains(filter))
+            continue;
         if (m_musicFilters.contains(filter))
             continue;
         m_activeFilters.removeOne(filter);
@@ -48,17 +48,22 @@ private:
     QList<Filter*> m_movieSetsFilters;
     QList<Filter*> m_tvShowFilters;
     QList<Filter*> m_concertFilters;
+    QList<Filter*> m_concertGenreFilters;
+    QList<Filter*> m_concertTagsFilters;
     QList<Filter*> m_musicFilters;
     QList<Filter*> m_movieLabelFilters;
     QListWidget *m_list;
     QList<Filter*> m_activeFilters;
     MainWidgets m_activeWidget;
     QMap<MainWidgets, QList<Filter*> > m_storedFilters;
+    int m_movieFacetsRevision;
+    int m_concertFacetsRevision;
     void initFilters();
     void setupMovieFilters();
     void setupTvShowFilters();
     void setupConcertFilters();
     void setupMusicFilters();
+    void updateFacetFilters(QList<Filter*> &filters, const QHash<QString, int> &counts, int info, const QString &text, const QString &name);
     void storeFilters(MainWidgets widget);
     void loadFilters(MainWidgets widget);
 };
@@ -6,8 +6,8 @@
 #include <QDesktopServices>
 #include <QMessageBox>
 #include "globals/Manager.h"
+#include "data/ImageCache.h"
 #include "data/TvShowModelItem.h"
-#include "smallWidgets/LoadingStreamDetails.h"
 #include "tvShows/TvShowMultiScrapeDialog.h"
 #include "tvShows/TvShowUpdater.h"
 
@@ -52,6 +52,7 @@ TvShowFilesWidget::TvShowFilesWidget(QWidget *parent) :
     QAction *actionMarkAsWatched = new QAction(tr("Mark as watched"), this);
     QAction *actionMarkAsUnwatched = new QAction(tr("Mark as unwatched"), this);
     QAction *actionLoadStreamDetails = new QAction(tr("Load Stream Details"), this);
+    m_actionStopStreamDetails = new QAction(tr("Stop Loading Stream Details"), this);
     QAction *actionMarkForSync = new QAction(tr("Add to Synchronization Queue"), this);
     QAction *actionUnmarkForSync = new QAction(tr("Remove from Synchronization Queue"), this);
     QAction *actionOpenFolder = new QAction(tr("Open TV Show Folder"), this);
@@ -69,6 +70,7 @@ TvShowFilesWidget::TvShowFilesWidget(QWidget *parent) :
     m_contextMenu->addAction(actionMarkAsUnwatched);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionLoadStreamDetails);
+    m_contextMenu->addAction(m_actionStopStreamDetails);
     m_contextMenu->addSeparator();
     m_contextMenu->addAction(actionMarkForSync);
     m_contextMenu->addAction(actionUnmarkForSync);
@@ -84,6 +86,8 @@ TvShowFilesWidget::TvShowFilesWidget(QWidget *parent) :
     connect(actionMarkAsWatched, SIGNAL(triggered()), this, SLOT(markAsWatched()));
     connect(actionMarkAsUnwatched, SIGNAL(triggered()), this, SLOT(markAsUnwatched()));
     connect(actionLoadStreamDetails, SIGNAL(triggered()), this, SLOT(loadStreamDetails()));
+    connect(m_actionStopStreamDetails, SIGNAL(triggered()), Manager::instance()->streamDetailsLoader(), SLOT(abort()));
+    connect(Manager::instance()->streamDetailsLoader(), SIGNAL(sigLoaded(TvShowEpisode*)), this, SLOT(onStreamDetailsLoaded(TvShowEpisode*)));
     connect(actionMarkForSync, SIGNAL(triggered()), this, SLOT(markForSync()));
     connect(actionUnmarkForSync, SIGNAL(triggered()), this, SLOT(unmarkForSync()));
     connect(actionOpenFolder, SIGNAL(triggered()), this, SLOT(openFolder()));
@@ -123,6 +127,7 @@ TvShowFilesWidget *TvShowFilesWidget::instance()
  */
 void TvShowFilesWidget::showContextMenu(QPoint point)
 {
+    m_actionStopStreamDetails->setEnabled(Manager::instance()->streamDetailsLoader()->isRunning());
     if (ui->files->selectionModel()->selectedRows(0).count() != 1) {
         m_actionShowMissingEpisodes->setEnabled(false);
     } else {
@@ -266,9 +271,7 @@ void TvShowFilesWidget::loadStreamDetails()
         episodes.at(0)->loadStreamDetailsFromFile();
         episodes.at(0)->setChanged(true);
     } else {
-        LoadingStreamDetails *loader = new LoadingStreamDetails(this);
-        loader->loadTvShowEpisodes(episodes);
-        delete loader;
+        Manager::instance()->streamDetailsLoader()->load(episodes);
     }
     QModelIndex sourceIndex = m_tvShowProxyModel->mapToSource(ui->files->currentIndex());
     if (Manager::instance()->tvShowModel()->getItem(sourceIndex)->type() == TypeEpisode) {
@@ -500,6 +503,41 @@ void TvShowFilesWidget::onItemSelected(QModelIndex index)
         m_lastSeason = Manager::instance()->tvShowModel()->getItem(sourceIndex)->season().toInt();
         emit sigSeasonSelected(m_lastTvShow, m_lastSeason);
     }
+    prefetchImages(index);
+}
+
+/**
+ * @brief Prefetches the poster and backdrop of the shows or the thumbnails of the episodes next to the selected item
+ * @param index Proxy index of the selected item
+ */
+void TvShowFilesWidget::prefetchImages(const QModelIndex &index)
+{
+    QMap<int, QStringList> images;
+    for (int i=-2 ; i<=2 ; ++i) {
+        QModelIndex sibling = index.sibling(index.row()+i, 0);
+        if (i == 0 || !sibling.isValid())
+            continue;
+        TvShowModelItem *item = Manager::instance()->tvShowModel()->getItem(m_tvShowProxyModel->mapToSource(sibling));
+        if (item->type() == TypeTvShow) {
+            foreach (const int &imageType, QList<int>() << ImageType::TvShowPoster << ImageType::TvShowBackdrop) {
+                if (item->tvShow()->hasImage(imageType))
+                    images[imageType] << Manager::instance()->mediaCenterInterface()->imageFileName(item->tvShow(), imageType);
+            }
+        } else if (item->type() == TypeEpisode && !item->tvShowEpisode()->isDummy()) {
+            images[ImageType::TvShowEpisodeThumb] << Manager::instance()->mediaCenterInterface()->imageFileName(item->tvShowEpisode(), ImageType::TvShowEpisodeThumb);
+        }
+    }
+    ImageCache::instance()->prefetchImages(images);
+}
+
+/**
+ * @brief Updates the episode widget when the stream details of the current episode were loaded in the background
+ * @param episode Episode whose stream details were loaded
+ */
+void TvShowFilesWidget::onStreamDetailsLoaded(TvShowEpisode *episode)
+{
+    if (episode == m_lastEpisode)
+        emit sigEpisodeSelected(m_lastEpisode);
 }
 
 void TvShowFilesWidget::emitLastSelection()
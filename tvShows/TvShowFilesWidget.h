@@ -46,6 +46,7 @@ signals:
 
 private slots:
     void onItemSelected(QModelIndex index);
+    void onStreamDetailsLoaded(TvShowEpisode *episode);
     void showContextMenu(QPoint point);
     void scanForEpisodes();
     void markAsWatched();
@@ -70,6 +71,8 @@ private:
     int m_lastSeason;
     QAction *m_actionShowMissingEpisodes;
     QAction *m_actionHideSpecialsInMissingEpisodes;
+    QAction *m_actionStopStreamDetails;
+    void prefetchImages(const QModelIndex &index);
 };
 
 #endif // TVSHOWFILESWIDGET_H
@@ -28,8 +28,6 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QWidget *parent) :
     ui->itemCounter->setFont(font);
 
     m_executed = false;
-    m_currentShow = 0;
-    m_currentEpisode = 0;
 
     ui->chkActors->setMyData(TvShowScraperInfos::Actors);
     ui->chkBanner->setMyData(TvShowScraperInfos::Banner);
@@ -65,8 +63,14 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QWidget *parent) :
     m_scraperInterface = Manager::instance()->tvScrapers().at(0);
 
     m_downloadManager = new DownloadManager(this);
-    connect(m_downloadManager, SIGNAL(sigElemDownloaded(DownloadManagerElement)), this, SLOT(onDownloadFinished(DownloadManagerElement)));
-    connect(m_downloadManager, SIGNAL(allDownloadsFinished()), this, SLOT(onDownloadsFinished()));
+    connect(m_downloadManager, SIGNAL(downloadFinished(DownloadManagerElement)), this, SLOT(onDownloadFinished(DownloadManagerElement)));
+    connect(m_downloadManager, SIGNAL(allDownloadsFinished(TvShow*)), this, SLOT(onDownloadsFinished(TvShow*)));
+
+    m_runner = new MultiScrapeRunner(this);
+    connect(m_runner, SIGNAL(sigStartItem(QObject*)), this, SLOT(onStartItem(QObject*)));
+    connect(m_runner, SIGNAL(sigStartSearch(QObject*)), this, SLOT(onStartSearch(QObject*)));
+    connect(m_runner, SIGNAL(sigStartLoad(QObject*)), this, SLOT(onStartLoad(QObject*)));
+    connect(m_runner, SIGNAL(sigFinished()), this, SLOT(onScrapingFinished()));
 }
 
 TvShowMultiScrapeDialog::~TvShowMultiScrapeDialog()
@@ -104,8 +108,6 @@ void TvShowMultiScrapeDialog::setEpisodes(const QList<TvShowEpisode *> &episodes
 
 int TvShowMultiScrapeDialog::exec()
 {
-    m_showQueue.clear();
-    m_episodeQueue.clear();
     ui->itemCounter->setVisible(false);
     ui->btnCancel->setVisible(true);
     ui->btnClose->setVisible(false);
@@ -118,8 +120,6 @@ int TvShowMultiScrapeDialog::exec()
     ui->progressItem->setValue(0);
     ui->groupBox->setEnabled(true);
     ui->title->clear();
-    m_currentEpisode = 0;
-    m_currentShow = 0;
     m_showIds.clear();
     m_executed = true;
     setChkBoxesEnabled();
@@ -144,14 +144,14 @@ void TvShowMultiScrapeDialog::accept()
 
 void TvShowMultiScrapeDialog::reject()
 {
+    foreach (QObject *item, m_runner->activeItems())
+        disconnect(item, 0, this, 0);
+    m_runner->abort();
     m_downloadManager->abortDownloads();
 
     disconnect(m_scraperInterface, SIGNAL(sigSearchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchFinished(QList<ScraperSearchResult>)));
     m_executed = false;
 
-    m_showQueue.clear();
-    m_episodeQueue.clear();
-
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyId->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
     Settings::instance()->saveSettings();
@@ -208,67 +208,66 @@ void TvShowMultiScrapeDialog::onStartScraping()
 
     connect(m_scraperInterface, SIGNAL(sigSearchDone(QList<ScraperSearchResult>)), this, SLOT(onSearchFinished(QList<ScraperSearchResult>)), Qt::UniqueConnection);
 
-    m_showQueue.append(m_shows);
-    m_episodeQueue.append(m_episodes);
+    QList<QObject*> items;
+    foreach (TvShow *show, m_shows)
+        items << show;
+    foreach (TvShowEpisode *episode, m_episodes)
+        items << episode;
 
-    ui->itemCounter->setText(QString("0/%1").arg(m_showQueue.count() + m_episodeQueue.count()));
+    ui->itemCounter->setText(QString("0/%1").arg(items.count()));
     ui->itemCounter->setVisible(true);
-    ui->progressAll->setMaximum(m_showQueue.count() + m_episodeQueue.count());
-    scrapeNext();
+    ui->progressAll->setMaximum(items.count());
+    m_runner->start(items);
 }
 
-void TvShowMultiScrapeDialog::scrapeNext()
+/**
+ * @brief Called when an item gets a slot in the runner, requests its search or load
+ * @param item Show or episode
+ */
+void TvShowMultiScrapeDialog::onStartItem(QObject *item)
 {
     if (!m_executed)
         return;
 
-    if (m_currentShow && ui->chkAutoSave->isChecked())
-        m_currentShow->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
-
-    if (m_currentEpisode && ui->chkAutoSave->isChecked())
-        m_currentEpisode->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
+    TvShow *show = qobject_cast<TvShow*>(item);
+    TvShowEpisode *episode = qobject_cast<TvShowEpisode*>(item);
 
-    if (m_showQueue.isEmpty() && m_episodeQueue.isEmpty()) {
-        onScrapingFinished();
+    if (ui->chkOnlyId->isChecked() && ((show && show->tvdbId() == "") || (episode && episode->tvShow()->tvdbId() == ""))) {
+        m_runner->itemDone(item, false);
         return;
     }
 
-    m_currentShow = 0;
-    m_currentEpisode = 0;
-
-    if (!m_showQueue.isEmpty()) {
-        m_currentShow = m_showQueue.dequeue();
-        ui->title->setText(m_currentShow->name());
-    } else if (!m_episodeQueue.isEmpty()) {
-        m_currentEpisode = m_episodeQueue.dequeue();
-        ui->title->setText(m_currentEpisode->name());
+    if (show) {
+        connect(show, SIGNAL(sigLoaded(TvShow*)), this, SLOT(onInfoLoadDone(TvShow*)), Qt::UniqueConnection);
+        if (show->tvdbId().isEmpty())
+            m_runner->requestSearch(show, m_scraperInterface->identifier());
+        else
+            m_runner->requestLoad(show, m_scraperInterface->identifier());
+    } else if (episode) {
+        connect(episode, SIGNAL(sigLoaded()), this, SLOT(onEpisodeLoadDone()), Qt::UniqueConnection);
+        if (!episode->tvShow()->tvdbId().isEmpty() || m_showIds.contains(episode->tvShow()->name()))
+            m_runner->requestLoad(episode, m_scraperInterface->identifier());
+        else
+            m_runner->requestSearch(episode, m_scraperInterface->identifier());
     }
+    updateStatus();
+}
 
-    int sum = m_shows.count() + m_episodes.count();
-    ui->itemCounter->setText(QString("%1/%2").arg(sum-m_showQueue.count()-m_episodeQueue.count()).arg(sum));
-
-    ui->progressAll->setValue(ui->progressAll->maximum()-m_showQueue.size()-m_episodeQueue.count()-1);
-    ui->progressItem->setValue(0);
-
-    if (ui->chkOnlyId->isChecked() && ((m_currentShow && m_currentShow->tvdbId() == "") || (m_currentEpisode && m_currentEpisode->tvShow()->tvdbId() == ""))) {
-        scrapeNext();
+void TvShowMultiScrapeDialog::onStartSearch(QObject *item)
+{
+    if (!m_executed)
         return;
-    }
 
-    if (m_currentShow) {
-        connect(m_currentShow, SIGNAL(sigLoaded(TvShow*)), this, SLOT(onInfoLoadDone(TvShow*)), Qt::UniqueConnection);
-        if (m_currentShow->tvdbId().isEmpty())
-            m_scraperInterface->search(m_currentShow->name());
-        else
-            m_currentShow->loadData(m_currentShow->tvdbId(), m_scraperInterface, UpdateShow, m_infosToLoad);
-    } else if (m_currentEpisode) {
-        connect(m_currentEpisode, SIGNAL(sigLoaded()), this, SLOT(onEpisodeLoadDone()), Qt::UniqueConnection);
-        if (!m_currentEpisode->tvShow()->tvdbId().isEmpty())
-            m_currentEpisode->loadData(m_currentEpisode->tvShow()->tvdbId(), m_scraperInterface, m_infosToLoad);
-        else if (m_showIds.contains(m_currentEpisode->tvShow()->name()))
-            m_currentEpisode->loadData(m_showIds.value(m_currentEpisode->tvShow()->name()), m_scraperInterface, m_infosToLoad);
-        else
-            m_scraperInterface->search(m_currentEpisode->tvShow()->name());
+    TvShow *show = qobject_cast<TvShow*>(item);
+    TvShowEpisode *episode = qobject_cast<TvShowEpisode*>(item);
+    if (show) {
+        m_scraperInterface->search(show->name());
+    } else if (episode && m_showIds.contains(episode->tvShow()->name())) {
+        // An earlier episode of the same show has found it in the meantime
+        m_runner->searchDone();
+        m_runner->requestLoad(episode, m_scraperInterface->identifier());
+    } else if (episode) {
+        m_scraperInterface->search(episode->tvShow()->name());
     }
 }
 
@@ -276,18 +275,93 @@ void TvShowMultiScrapeDialog::onSearchFinished(QList<ScraperSearchResult> result
 {
     if (!m_executed)
         return;
+
+    QObject *item = m_runner->searchingItem();
+    if (!item)
+        return;
+    m_runner->searchDone();
+
     if (results.isEmpty()) {
-        scrapeNext();
+        finishItem(item, false);
+        return;
+    }
+
+    TvShow *show = qobject_cast<TvShow*>(item);
+    TvShowEpisode *episode = qobject_cast<TvShowEpisode*>(item);
+    if (show)
+        m_showIds.insert(show->name(), results.first().id);
+    else if (episode)
+        m_showIds.insert(episode->tvShow()->name(), results.first().id);
+    m_runner->requestLoad(item, m_scraperInterface->identifier());
+}
+
+void TvShowMultiScrapeDialog::onStartLoad(QObject *item)
+{
+    if (!m_executed)
         return;
+
+    TvShow *show = qobject_cast<TvShow*>(item);
+    TvShowEpisode *episode = qobject_cast<TvShowEpisode*>(item);
+    if (show) {
+        QString id = show->tvdbId().isEmpty() ? m_showIds.value(show->name()) : show->tvdbId();
+        show->loadData(id, m_scraperInterface, UpdateShow, m_infosToLoad);
+    } else if (episode) {
+        QString id = episode->tvShow()->tvdbId().isEmpty() ? m_showIds.value(episode->tvShow()->name()) : episode->tvShow()->tvdbId();
+        episode->loadData(id, m_scraperInterface, m_infosToLoad);
     }
+}
+
+/**
+ * @brief Saves an item if requested and frees its slot in the runner
+ * @param item Show or episode
+ * @param scraped False if the item was not found
+ */
+void TvShowMultiScrapeDialog::finishItem(QObject *item, bool scraped)
+{
+    if (!m_runner->activeItems().contains(item))
+        return;
+
+    disconnect(item, 0, this, 0);
+
+    TvShow *show = qobject_cast<TvShow*>(item);
+    TvShowEpisode *episode = qobject_cast<TvShowEpisode*>(item);
+    if (scraped && show && ui->chkAutoSave->isChecked())
+        show->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
+    if (scraped && episode && ui->chkAutoSave->isChecked())
+        episode->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
 
-    if (m_currentShow) {
-        m_showIds.insert(m_currentShow->name(), results.first().id);
-        m_currentShow->loadData(results.first().id, m_scraperInterface, UpdateShow, m_infosToLoad);
-    } else if (m_currentEpisode) {
-        m_showIds.insert(m_currentEpisode->tvShow()->name(), results.first().id);
-        m_currentEpisode->loadData(results.first().id, m_scraperInterface, m_infosToLoad);
+    m_runner->itemDone(item, scraped);
+    updateStatus();
+}
+
+/**
+ * @brief Shows the items in progress, their downloads and the throughput
+ */
+void TvShowMultiScrapeDialog::updateStatus()
+{
+    if (!m_executed)
+        return;
+
+    QStringList names;
+    int downloads = 0;
+    int downloadsLeft = 0;
+    foreach (QObject *item, m_runner->activeItems()) {
+        if (TvShow *show = qobject_cast<TvShow*>(item)) {
+            names << show->name();
+            downloads += m_downloadManager->totalDownloads(show);
+            downloadsLeft += m_downloadManager->pendingDownloads(show);
+        } else if (TvShowEpisode *episode = qobject_cast<TvShowEpisode*>(item)) {
+            names << episode->name();
+        }
     }
+    ui->title->setText(names.join(", "));
+
+    int sum = m_shows.count() + m_episodes.count();
+    int done = m_runner->itemsDone();
+    ui->itemCounter->setText(tr("%1/%2 - %3 titles per minute").arg(done).arg(sum).arg(m_runner->titlesPerMinute(), 0, 'f', 1));
+    ui->progressAll->setValue(done);
+    ui->progressItem->setMaximum(qMax(1, downloads));
+    ui->progressItem->setValue(downloads-downloadsLeft);
 }
 
 void TvShowMultiScrapeDialog::onScrapingFinished()
@@ -328,7 +402,7 @@ void TvShowMultiScrapeDialog::onInfoLoadDone(TvShow *show)
     if (!m_executed)
         return;
 
-    if (show != m_currentShow)
+    if (!m_runner->activeItems().contains(show))
         return;
 
     if (show->showMissingEpisodes()) {
@@ -352,7 +426,7 @@ void TvShowMultiScrapeDialog::onLoadDone(TvShow *show, QMap<int, QList<Poster> >
     if (!m_executed)
         return;
 
-    if (show != m_currentShow)
+    if (!m_runner->activeItems().contains(show))
         return;
 
     int downloadsSize = 0;
@@ -427,9 +501,9 @@ void TvShowMultiScrapeDialog::onLoadDone(TvShow *show, QMap<int, QList<Poster> >
     }
 
     if (downloadsSize > 0)
-        ui->progressItem->setMaximum(downloadsSize);
+        updateStatus();
     else
-        scrapeNext();
+        finishItem(show);
 }
 
 void TvShowMultiScrapeDialog::addDownload(int imageType, QUrl url, TvShow *show, int season)
@@ -468,10 +542,7 @@ void TvShowMultiScrapeDialog::onDownloadFinished(DownloadManagerElement elem)
         return;
 
     if (elem.show) {
-        int left = m_downloadManager->downloadsLeftForShow(m_currentShow);
-        ui->progressItem->setValue(ui->progressItem->maximum()-left);
-        qDebug() << "Download finished" << left << ui->progressItem->maximum();
-
+        updateStatus();
         if (TvShow::seasonImageTypes().contains(elem.imageType)) {
             if (elem.imageType == ImageType::TvShowSeasonBackdrop)
                 Helper::instance()->resizeBackdrop(elem.data);
@@ -485,16 +556,16 @@ void TvShowMultiScrapeDialog::onDownloadFinished(DownloadManagerElement elem)
         }
     } else if (elem.episode && elem.imageType == ImageType::TvShowEpisodeThumb) {
         elem.episode->setThumbnailImage(elem.data);
-        scrapeNext();
+        finishItem(elem.episode);
     }
 }
 
-void TvShowMultiScrapeDialog::onDownloadsFinished()
+void TvShowMultiScrapeDialog::onDownloadsFinished(TvShow *show)
 {
     if (!m_executed)
         return;
 
-    scrapeNext();
+    finishItem(show);
 }
 
 
@@ -509,11 +580,11 @@ void TvShowMultiScrapeDialog::onEpisodeLoadDone()
         return;
 
     TvShowEpisode *episode = static_cast<TvShowEpisode*>(QObject::sender());
-    if (!episode)
+    if (!episode || !m_runner->activeItems().contains(episode))
         return;
 
     if (m_infosToLoad.contains(TvShowScraperInfos::Thumbnail) && !episode->thumbnail().isEmpty())
         addDownload(ImageType::TvShowEpisodeThumb, episode->thumbnail(), episode);
     else
-        scrapeNext();
+        finishItem(episode);
 }
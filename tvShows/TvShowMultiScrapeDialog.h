@@ -2,12 +2,11 @@
 #define TVSHOWMULTISCRAPEDIALOG_H
 
 #include <QDialog>
-#include <QPointer>
-#include <QQueue>
 #include "data/TvShow.h"
 #include "data/TvShowEpisode.h"
 #include "data/TvScraperInterface.h"
 #include "globals/DownloadManager.h"
+#include "globals/MultiScrapeRunner.h"
 
 namespace Ui {
 class TvShowMultiScrapeDialog;
@@ -40,12 +39,14 @@ private slots:
     void onStartScraping();
     void onScrapingFinished();
     void onSearchFinished(QList<ScraperSearchResult> results);
-    void scrapeNext();
+    void onStartItem(QObject *item);
+    void onStartSearch(QObject *item);
+    void onStartLoad(QObject *item);
     void onInfoLoadDone(TvShow *show);
     void onEpisodeLoadDone();
     void onLoadDone(TvShow *show, QMap<int, QList<Poster> > posters);
     void onDownloadFinished(DownloadManagerElement elem);
-    void onDownloadsFinished();
+    void onDownloadsFinished(TvShow *show);
     void onChkDvdOrderToggled();
 
 private:
@@ -54,15 +55,14 @@ private:
     QList<TvShowEpisode *> m_episodes;
     bool m_executed;
     QList<int> m_infosToLoad;
-    QQueue<TvShow*> m_showQueue;
-    QQueue<TvShowEpisode*> m_episodeQueue;
-    QPointer<TvShow> m_currentShow;
-    QPointer<TvShowEpisode> m_currentEpisode;
+    MultiScrapeRunner *m_runner;
     TvScraperInterface *m_scraperInterface;
     DownloadManager *m_downloadManager;
     QMap<QString, QString> m_showIds;
 
     void setChkBoxesEnabled();
+    void finishItem(QObject *item, bool scraped = true);
+    void updateStatus();
     void addDownload(int imageType, QUrl url, TvShow *show, int season = -1);
     void addDownload(int imageType, QUrl url, TvShow *show, Actor *actor);
     void addDownload(int imageType, QUrl url, TvShowEpisode *episode);
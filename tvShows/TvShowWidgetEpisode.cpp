@@ -61,6 +61,7 @@ TvShowWidgetEpisode::TvShowWidgetEpisode(QWidget *parent) :
     ui->writers->setItemDelegate(new ComboDelegate(ui->writers, WidgetTvShows, ComboDelegateWriters));
     ui->thumbnail->setDefaultPixmap(QPixmap(":/img/placeholders/thumb.png"));
     ui->thumbnail->setShowCapture(true);
+    ui->thumbnail->setImageType(ImageType::TvShowEpisodeThumb);
 
     m_posterDownloadManager = new DownloadManager(this);
 
@@ -614,6 +615,7 @@ void TvShowWidgetEpisode::onLoadDone()
         d.url = m_episode->thumbnail();
         d.episode = m_episode;
         d.directDownload = true;
+        d.priority = true;
         m_posterDownloadManager->addDownload(d);
         ui->thumbnail->setLoading(true);
     } else {
@@ -655,6 +657,7 @@ void TvShowWidgetEpisode::onChooseThumbnail()
         d.url = ImageDialog::instance()->imageUrl();
         d.episode = m_episode;
         d.directDownload = true;
+        d.priority = true;
         m_posterDownloadManager->addDownload(d);
         ui->thumbnail->setLoading(true);
         ui->buttonRevert->setVisible(true);
@@ -673,6 +676,7 @@ void TvShowWidgetEpisode::onImageDropped(int imageType, QUrl imageUrl)
     d.url = imageUrl;
     d.episode = m_episode;
     d.directDownload = true;
+    d.priority = true;
     m_posterDownloadManager->addDownload(d);
     ui->thumbnail->setLoading(true);
     ui->buttonRevert->setVisible(true);
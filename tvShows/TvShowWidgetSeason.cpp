@@ -229,6 +229,7 @@ void TvShowWidgetSeason::onChooseImage()
         d.url = ImageDialog::instance()->imageUrl();
         d.season = m_season;
         d.show = m_show;
+        d.priority = true;
         m_downloadManager->addDownload(d);
         image->setLoading(true);
     }
@@ -261,6 +262,7 @@ void TvShowWidgetSeason::onImageDropped(int imageType, QUrl imageUrl)
     d.url = imageUrl;
     d.season = m_season;
     d.show = m_show;
+    d.priority = true;
     m_downloadManager->addDownload(d);
     image->setLoading(true);
 }
@@ -1085,6 +1085,7 @@ void TvShowWidgetTvShow::onChooseImage()
         d.imageType = image->imageType();
         d.url = ImageDialog::instance()->imageUrl();
         d.show = m_show;
+        d.priority = true;
         m_posterDownloadManager->addDownload(d);
         image->setLoading(true);
         ui->buttonRevert->setVisible(true);
@@ -1118,6 +1119,7 @@ void TvShowWidgetTvShow::onImageDropped(int imageType, QUrl imageUrl)
     d.imageType = imageType;
     d.url = imageUrl;
     d.show = m_show;
+    d.priority = true;
     m_posterDownloadManager->addDownload(d);
     image->setLoading(true);
     ui->buttonRevert->setVisible(true);